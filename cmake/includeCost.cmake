@@ -0,0 +1,93 @@
+# Measure the compile time cost of including each SugarPP header
+#
+# Usage, from the root of the repository:
+#   cmake [-D CXX=clang++] [-D RUNS=5] [-D FLAGS="-O2"] -P cmake/includeCost.cmake
+#
+# Every header is included alone in an otherwise empty translation unit, which is compiled with -fsyntax-only
+# RUNS times. The median time minus the median time of an empty translation unit is reported.
+# Headers noted as requiring C++20 are compiled with -std=c++20, the others with -std=c++17.
+# Each header is measured twice: by default, and with SugarPPLeanHeaders defined, where io.hpp and range.hpp
+# no longer include file.hpp and parallel.hpp, which they only include for compatibility.
+
+cmake_minimum_required(VERSION 3.23)
+
+if(NOT DEFINED CXX)
+  set(CXX c++)
+endif()
+if(NOT DEFINED RUNS)
+  set(RUNS 5)
+endif()
+separate_arguments(extra_flags NATIVE_COMMAND "${FLAGS}")
+
+set(root "${CMAKE_CURRENT_LIST_DIR}/..")
+set(work "${CMAKE_BINARY_DIR}/_include_cost")
+file(MAKE_DIRECTORY "${work}")
+
+# Compile `source` RUNS times and store the median time in milliseconds in `out`, with SugarPPLeanHeaders defined if `lean` is true
+function(measure source standard lean out)
+  set(lean_flag "")
+  if(lean)
+    set(lean_flag -DSugarPPLeanHeaders)
+  endif()
+  set(times "")
+  foreach(run RANGE 1 ${RUNS})
+    string(TIMESTAMP begin "%s%f")
+    execute_process(
+      COMMAND ${CXX} -std=${standard} -fsyntax-only -DSugarPPNamespace ${lean_flag} -I "${root}/include" ${extra_flags} "${source}"
+      RESULT_VARIABLE result
+      ERROR_VARIABLE error)
+    string(TIMESTAMP end "%s%f")
+    if(NOT result EQUAL 0)
+      message(FATAL_ERROR "Failed to compile ${source}:\n${error}")
+    endif()
+    math(EXPR elapsed "(${end} - ${begin}) / 1000")
+    # pad so that the lexical sort below is a numeric sort
+    string(LENGTH "${elapsed}" length)
+    math(EXPR padding "10 - ${length}")
+    string(REPEAT "0" ${padding} zeros)
+    list(APPEND times "${zeros}${elapsed}")
+  endforeach()
+  list(SORT times)
+  math(EXPR middle "${RUNS} / 2")
+  list(GET times ${middle} median)
+  math(EXPR median "${median} + 0")
+  set(${out} ${median} PARENT_SCOPE)
+endfunction()
+
+file(WRITE "${work}/empty.cpp" "int main() {}\n")
+measure("${work}/empty.cpp" c++17 OFF empty17)
+measure("${work}/empty.cpp" c++20 OFF empty20)
+
+file(GLOB_RECURSE headers RELATIVE "${root}/include" "${root}/include/sugarpp/*.hpp")
+list(SORT headers)
+
+message("${CXX}, median of ${RUNS} runs, empty translation unit: ${empty17} ms")
+message("")
+message("default ms   lean ms  header")
+foreach(header IN LISTS headers)
+  file(READ "${root}/include/${header}" content)
+  string(FIND "${content}" "Requires C++20" cxx20)
+  if(cxx20 EQUAL -1)
+    set(standard c++17)
+    set(empty ${empty17})
+  else()
+    set(standard c++20)
+    set(empty ${empty20})
+  endif()
+
+  string(MAKE_C_IDENTIFIER "${header}" name)
+  file(WRITE "${work}/${name}.cpp" "#include \"${header}\"\nint main() {}\n")
+  set(row "")
+  foreach(lean OFF ON)
+    measure("${work}/${name}.cpp" ${standard} ${lean} time)
+    math(EXPR cost "${time} - ${empty}")
+    string(LENGTH "${cost}" length)
+    math(EXPR padding "10 - ${length}")
+    if(padding LESS 0)
+      set(padding 0)
+    endif()
+    string(REPEAT " " ${padding} spaces)
+    string(APPEND row "${spaces}${cost}")
+  endforeach()
+  message("${row}  ${header}")
+endforeach()
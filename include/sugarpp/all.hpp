@@ -8,11 +8,41 @@
 
 #pragma once
 
+#include "channel/channel.hpp"
+
+#include "collection/collection.hpp"
+#include "collection/hashMap.hpp"
+
+#include "io/binaryLog.hpp"
+#include "io/externalSort.hpp"
+#include "io/file.hpp"
+#include "io/fileCache.hpp"
 #include "io/io.hpp"
+#include "io/log.hpp"
+#include "io/mappedWriter.hpp"
+#include "io/scan.hpp"
+#include "io/search.hpp"
+#include "io/walk.hpp"
+
+#include "memory/allocator.hpp"
+
+#include "pipeline/pipeline.hpp"
 
 #include "range/enumerate.hpp"
 #include "range/in.hpp"
+#include "range/parallel.hpp"
 #include "range/range.hpp"
+#include "range/reduce.hpp"
+#include "range/slice.hpp"
+#include "range/sort.hpp"
+#include "range/zip.hpp"
+
+#include "string/split.hpp"
+
+#include "thread/pool.hpp"
+#include "thread/synchronized.hpp"
+#include "thread/threadPool.hpp"
+#include "thread/topology.hpp"
 
 #include "types/types.hpp"
 #include "when/when.hpp"
\ No newline at end of file
@@ -0,0 +1,920 @@
+/*****************************************************************//**
+ * \file   channel.hpp
+ * \brief  Kotlin's Channel port, a bounded queue for producer/consumer pipelines
+ *
+ * \author Peter
+ * \date   October 2026
+ *********************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <future>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include "../thread/threadPool.hpp"
+
+#ifdef SugarPPNamespace
+namespace SugarPP
+{
+#endif
+
+    /**
+     * @brief Thrown when sending to a closed @ref Channel
+     */
+    struct ChannelClosedError :std::runtime_error
+    {
+        ChannelClosedError() :std::runtime_error("Sending to a closed channel") {}
+    };
+
+    /**
+     * @brief The queue implementation behind a @ref Channel
+     */
+    enum class ChannelType
+    {
+        SPSC,   //!< Exactly one thread sends and exactly one thread receives
+        MPMC    //!< Any number of threads send and receive
+    };
+
+    /**
+     * @brief A caller suspended on a @ref Channel without blocking a thread (eg. a coroutine), which the channel wakes up instead of a condition variable
+     * @see Channel::addWaiter
+     */
+    struct ChannelWaiter
+    {
+        enum class Side
+        {
+            Send,       //!< Waiting for room in the channel
+            Receive     //!< Waiting for a value
+        };
+
+        virtual ~ChannelWaiter() = default;
+
+        /**
+         * @brief Called once when the channel may have changed for this side, or is closed
+         * @return false if the waiter has already been woken up by something else (eg. it was cancelled), so the channel wakes up another one instead
+         */
+        virtual bool wake() = 0;
+    };
+
+    namespace Channel_detail
+    {
+        constexpr size_t CacheLine = 64;
+
+        constexpr size_t roundUpToPowerOf2(size_t value)
+        {
+            size_t result = 1;
+            while (result < value)
+                result <<= 1;
+            return result;
+        }
+
+        /**
+         * @brief Uninitialized storage for one element
+         */
+        template<typename T>
+        struct Slot
+        {
+            alignas(T) unsigned char storage[sizeof(T)];
+
+            T& get() { return *std::launder(reinterpret_cast<T*>(storage)); }
+
+            template<typename U>
+            void construct(U&& value) { new (storage) T(std::forward<U>(value)); }
+
+            T take()
+            {
+                T value = std::move(get());
+                get().~T();
+                return value;
+            }
+        };
+
+        template<typename T, ChannelType Type>
+        class Queue;
+
+        /**
+         * @brief A lock-free single-producer single-consumer ring buffer
+         * @details Each side keeps a cached copy of the other side's index, so the shared index is only read when the cached one says the queue is full/empty.
+         */
+        template<typename T>
+        class Queue<T, ChannelType::SPSC>
+        {
+            size_t const mask;
+            std::unique_ptr<Slot<T>[]> slots;
+
+            alignas(CacheLine) std::atomic<size_t> head{ 0 };   //next position to read
+            size_t cachedTail = 0;
+            alignas(CacheLine) std::atomic<size_t> tail{ 0 };   //next position to write
+            size_t cachedHead = 0;
+        public:
+            explicit Queue(size_t capacity) :mask(roundUpToPowerOf2(capacity) - 1), slots(std::make_unique<Slot<T>[]>(mask + 1)) {}
+
+            ~Queue()
+            {
+                for (auto position = head.load(); position != tail.load(); ++position)
+                    slots[position & mask].get().~T();
+            }
+
+            template<typename U>
+            bool tryPush(U&& value)
+            {
+                auto const position = tail.load(std::memory_order_relaxed);
+                if (position - cachedHead > mask)
+                {
+                    cachedHead = head.load(std::memory_order_acquire);
+                    if (position - cachedHead > mask)
+                        return false;
+                }
+                slots[position & mask].construct(std::forward<U>(value));
+                tail.store(position + 1, std::memory_order_release);
+                return true;
+            }
+
+            /**
+             * @brief Push as many elements from [first, last) as there is room for, and publish them at once
+             */
+            template<typename InputIt>
+            InputIt tryPushBatch(InputIt first, InputIt last)
+            {
+                auto const start = tail.load(std::memory_order_relaxed);
+                auto position = start;
+                cachedHead = head.load(std::memory_order_acquire);
+                for (; first != last && position - cachedHead <= mask; ++first, ++position)
+                    slots[position & mask].construct(std::move(*first));
+                if (position != start)
+                    tail.store(position, std::memory_order_release);
+                return first;
+            }
+
+            bool tryPop(std::optional<T>& value)
+            {
+                auto const position = head.load(std::memory_order_relaxed);
+                if (position == cachedTail)
+                {
+                    cachedTail = tail.load(std::memory_order_acquire);
+                    if (position == cachedTail)
+                        return false;
+                }
+                value.emplace(slots[position & mask].take());
+                head.store(position + 1, std::memory_order_release);
+                return true;
+            }
+
+            /**
+             * @brief Pop up to `maxCount` elements into `out`, and release their slots at once
+             */
+            template<typename OutputIt>
+            size_t tryPopBatch(OutputIt& out, size_t maxCount)
+            {
+                auto const start = head.load(std::memory_order_relaxed);
+                cachedTail = tail.load(std::memory_order_acquire);
+                auto position = start;
+                for (; position != cachedTail && position - start < maxCount; ++position)
+                    *out++ = slots[position & mask].take();
+                if (position != start)
+                    head.store(position, std::memory_order_release);
+                return position - start;
+            }
+
+            [[nodiscard]] bool empty() const
+            {
+                return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+            }
+
+            [[nodiscard]] bool full() const
+            {
+                return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire) > mask;
+            }
+
+            [[nodiscard]] size_t capacity() const { return mask + 1; }
+        };
+
+        /**
+         * @brief A lock-free bounded multi-producer multi-consumer queue
+         * @details Dmitry Vyukov's algorithm: every cell carries a sequence number that tells whether it is ready to be written or read at a given position,
+         * so producers and consumers only contend on one atomic index each.
+         */
+        template<typename T>
+        class Queue<T, ChannelType::MPMC>
+        {
+            struct alignas(CacheLine) Cell
+            {
+                std::atomic<size_t> sequence;
+                Slot<T> slot;
+            };
+
+            size_t const mask;
+            std::unique_ptr<Cell[]> cells;
+            alignas(CacheLine) std::atomic<size_t> enqueuePosition{ 0 };
+            alignas(CacheLine) std::atomic<size_t> dequeuePosition{ 0 };
+        public:
+            explicit Queue(size_t capacity) :mask(roundUpToPowerOf2(capacity < 2 ? 2 : capacity) - 1), cells(std::make_unique<Cell[]>(mask + 1))
+            {
+                for (size_t i = 0; i <= mask; ++i)
+                    cells[i].sequence.store(i, std::memory_order_relaxed);
+            }
+
+            ~Queue()
+            {
+                std::optional<T> value;
+                while (tryPop(value))
+                    ;
+            }
+
+            template<typename U>
+            bool tryPush(U&& value)
+            {
+                auto position = enqueuePosition.load(std::memory_order_relaxed);
+                while (true)
+                {
+                    auto& cell = cells[position & mask];
+                    auto const sequence = cell.sequence.load(std::memory_order_acquire);
+                    auto const difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+                    if (difference == 0)
+                    {
+                        if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                        {
+                            cell.slot.construct(std::forward<U>(value));
+                            cell.sequence.store(position + 1, std::memory_order_release);
+                            return true;
+                        }
+                    }
+                    else if (difference < 0)
+                        return false;
+                    else
+                        position = enqueuePosition.load(std::memory_order_relaxed);
+                }
+            }
+
+            template<typename InputIt>
+            InputIt tryPushBatch(InputIt first, InputIt last)
+            {
+                for (; first != last && tryPush(std::move(*first)); ++first)
+                    ;
+                return first;
+            }
+
+            bool tryPop(std::optional<T>& value)
+            {
+                auto position = dequeuePosition.load(std::memory_order_relaxed);
+                while (true)
+                {
+                    auto& cell = cells[position & mask];
+                    auto const sequence = cell.sequence.load(std::memory_order_acquire);
+                    auto const difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position + 1);
+                    if (difference == 0)
+                    {
+                        if (dequeuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                        {
+                            value.emplace(cell.slot.take());
+                            cell.sequence.store(position + mask + 1, std::memory_order_release);
+                            return true;
+                        }
+                    }
+                    else if (difference < 0)
+                        return false;
+                    else
+                        position = dequeuePosition.load(std::memory_order_relaxed);
+                }
+            }
+
+            template<typename OutputIt>
+            size_t tryPopBatch(OutputIt& out, size_t maxCount)
+            {
+                std::optional<T> value;
+                size_t count = 0;
+                for (; count < maxCount && tryPop(value); ++count)
+                    *out++ = std::move(*value);
+                return count;
+            }
+
+            [[nodiscard]] bool empty() const
+            {
+                auto const position = dequeuePosition.load(std::memory_order_acquire);
+                return cells[position & mask].sequence.load(std::memory_order_acquire) != position + 1;
+            }
+
+            [[nodiscard]] bool full() const
+            {
+                auto const position = enqueuePosition.load(std::memory_order_acquire);
+                return cells[position & mask].sequence.load(std::memory_order_acquire) != position;
+            }
+
+            [[nodiscard]] size_t capacity() const { return mask + 1; }
+        };
+    }
+
+    /**
+     * @brief A Kotlin-like bounded channel, which transfers values from producer threads to consumer threads
+     * @details
+     * ~~~~{.cpp}
+     *     Channel<std::string> lines{ 1024 };
+     *     std::thread producer{ [&] {
+     *         for (auto const& line : FileIterator{ "log.txt" })
+     *             lines.send(line);
+     *         lines.close();
+     *     } };
+     *     for (auto line : lines)  //ends when the channel is closed and empty
+     *         print(line);
+     * ~~~~
+     * Values go through a lock-free queue. A mutex is only used to put a thread to sleep when the channel is full (for senders)
+     * or empty (for receivers), and only touched by the other side if somebody is sleeping.
+     *
+     * Blocking operations block the calling thread. To consume a channel on a @ref ThreadPool without tying up its workers,
+     * use @ref forEach, which runs drain tasks only while there are values to receive.
+     *
+     * @tparam T Type of the values
+     * @tparam Type @ref ChannelType::MPMC by default, @ref ChannelType::SPSC is faster if there is only one sender and one receiver thread
+     */
+    template<typename T, ChannelType Type = ChannelType::MPMC>
+    class Channel
+    {
+        Channel_detail::Queue<T, Type> queue;
+        std::atomic<bool> closed{ false };
+
+        std::mutex m;
+        std::condition_variable notFull;
+        std::condition_variable notEmpty;
+        std::atomic<unsigned> waitingSenders{ 0 };      //threads sleeping on `notFull` and entries of `sendWaiters`
+        std::atomic<unsigned> waitingReceivers{ 0 };    //threads sleeping on `notEmpty` and entries of `receiveWaiters`
+        std::deque<std::shared_ptr<ChannelWaiter>> sendWaiters;
+        std::deque<std::shared_ptr<ChannelWaiter>> receiveWaiters;
+
+        static constexpr unsigned SpinCount = 64;
+
+        /**
+         * @brief Wake up one or all of the threads and @ref ChannelWaiter of one side, only locking if somebody is waiting
+         */
+        void wake(std::condition_variable& cv, std::atomic<unsigned>& waiting, std::deque<std::shared_ptr<ChannelWaiter>>& waiters, bool all)
+        {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (waiting.load() == 0)
+                return;
+            std::deque<std::shared_ptr<ChannelWaiter>> ready;
+            {
+                std::lock_guard lock{ m };
+                all ? cv.notify_all() : cv.notify_one();
+                if (all)
+                    ready.swap(waiters);
+                waiting.fetch_sub(static_cast<unsigned>(ready.size()));
+            }
+            for (auto const& waiter : ready)
+                waiter->wake();
+            if (all)
+                return;
+            //skip the waiters which have been woken up by something else
+            while (true)
+            {
+                std::shared_ptr<ChannelWaiter> waiter;
+                {
+                    std::lock_guard lock{ m };
+                    if (waiters.empty())
+                        return;
+                    waiter = std::move(waiters.front());
+                    waiters.pop_front();
+                    waiting.fetch_sub(1);
+                }
+                if (waiter->wake())
+                    return;
+            }
+        }
+
+        void wakeReceivers(bool all) { wake(notEmpty, waitingReceivers, receiveWaiters, all); }
+
+        void wakeSenders(bool all) { wake(notFull, waitingSenders, sendWaiters, all); }
+
+        /**
+         * @brief Wait until `attempt()` returns true, or the deadline is reached
+         * @details Spins first, then sleeps on `cv`.
+         * `attempt()` is also expected to return true when waiting has become pointless, eg. the channel is closed.
+         * @return false if timed out
+         */
+        template<typename Attempt, typename Clock, typename Duration>
+        bool waitUntil(Attempt&& attempt, std::condition_variable& cv, std::atomic<unsigned>& waiting, std::chrono::time_point<Clock, Duration> const& deadline)
+        {
+            for (unsigned i = 0; i < SpinCount; ++i)
+            {
+                if (attempt())
+                    return true;
+                std::this_thread::yield();
+            }
+
+            auto const forever = deadline == std::chrono::time_point<Clock, Duration>::max();
+            std::unique_lock lock{ m };
+            while (true)
+            {
+                //register as waiting before the attempt, so the other side either sees us waiting or we see its change
+                waiting.fetch_add(1);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                auto const done = attempt();
+                if (!done)
+                {
+                    if (forever)
+                        cv.wait(lock);
+                    else
+                        cv.wait_until(lock, deadline);
+                }
+                waiting.fetch_sub(1);
+                if (done)
+                    return true;
+                if (!forever && Clock::now() >= deadline)
+                    return attempt();
+            }
+        }
+
+        /*Consuming on a thread pool*/
+
+        struct Consumer
+        {
+            ThreadPool& pool;
+            unsigned const concurrency;
+            std::atomic<unsigned> active{ 0 };          //running drain tasks
+            std::atomic<unsigned> references{ 1 };      //the open channel, senders between pushing and scheduling, and drain tasks
+            std::atomic<bool> openReleased{ false };
+            std::promise<void> done;
+            std::exception_ptr exception;
+            std::mutex exceptionMutex;
+
+            Consumer(ThreadPool& pool, unsigned concurrency) :pool(pool), concurrency(concurrency == 0 ? 1 : concurrency) {}
+            virtual ~Consumer() = default;
+            virtual void consume(T& value) = 0;
+
+            bool tryAcquire()
+            {
+                auto count = active.load();
+                while (count < concurrency)
+                {
+                    if (active.compare_exchange_weak(count, count + 1))
+                        return true;
+                }
+                return false;
+            }
+
+            /**
+             * @brief Take a reference, unless the last one is already gone and `done` is (being) fulfilled
+             */
+            bool retain()
+            {
+                auto count = references.load();
+                while (count != 0)
+                {
+                    if (references.compare_exchange_weak(count, count + 1))
+                        return true;
+                }
+                return false;
+            }
+
+            /**
+             * @brief Drop a reference, the last one fulfills `done`. The channel must not be touched afterwards, as it may be destroyed
+             */
+            void release()
+            {
+                if (references.fetch_sub(1) == 1)
+                    exception ? done.set_exception(exception) : done.set_value();
+            }
+
+            /**
+             * @brief Drop the reference held by the channel being open, once the channel is closed
+             */
+            void releaseOpen()
+            {
+                if (!openReleased.exchange(true))
+                    release();
+            }
+        };
+
+        template<typename Func>
+        struct ConsumerModel : Consumer
+        {
+            Func func;
+            ConsumerModel(Func&& func, ThreadPool& pool, unsigned concurrency) :Consumer(pool, concurrency), func(std::move(func)) {}
+            void consume(T& value) override { func(value); }
+        };
+
+        std::unique_ptr<Consumer> consumerStorage;
+        std::atomic<Consumer*> consumer{ nullptr };
+
+        /**
+         * @brief Post a drain task if `current` is running less than its `concurrency` drain tasks. The caller holds a reference on `current`
+         */
+        void scheduleDrain(Consumer& current)
+        {
+            if (!current.tryAcquire())
+                return;
+            current.references.fetch_add(1);
+            try
+            {
+                current.pool.post([this, &current] { drain(current); });
+            }
+            catch (...)
+            {
+                current.active.fetch_sub(1);
+                current.release();
+                throw;
+            }
+        }
+
+        /**
+         * @brief Receive and consume values without blocking until the channel is empty
+         * @details When leaving, the task re-checks the channel after giving up its slot, so a value sent meanwhile is never left behind.
+         * A value sent after the re-check is scheduled by its sender, who holds a reference until then, so `done` is only fulfilled
+         * once the channel is closed, every value is consumed and no drain task can be posted anymore.
+         */
+        void drain(Consumer& current)
+        {
+            std::optional<T> value;
+            while (true)
+            {
+                while (queue.tryPop(value))
+                {
+                    wakeSenders(false);
+                    try
+                    {
+                        current.consume(*value);
+                    }
+                    catch (...)
+                    {
+                        std::lock_guard lock{ current.exceptionMutex };
+                        if (!current.exception)
+                            current.exception = std::current_exception();
+                    }
+                }
+                current.active.fetch_sub(1);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if (queue.empty() || !current.tryAcquire())
+                    break;
+            }
+            current.release();
+        }
+
+        /**
+         * @brief Keeps a reference on the consumer (if any) from before a value is pushed until its drain task is scheduled
+         * @details Without it, a drain task could consume the value, see the channel closed and empty and fulfill `done`
+         * before the sender posts another drain task, which would then run on a destroyed channel.
+         */
+        class SendGuard
+        {
+            Channel& channel;
+            Consumer* held;
+
+            static Consumer* retain(Consumer* current) { return current && current->retain() ? current : nullptr; }
+        public:
+            explicit SendGuard(Channel& channel) :channel(channel), held(retain(channel.consumer.load(std::memory_order_acquire))) {}
+            SendGuard(SendGuard const&) = delete;
+            SendGuard& operator=(SendGuard const&) = delete;
+            ~SendGuard()
+            {
+                if (held)
+                    held->release();
+            }
+
+            /**
+             * @brief Wake up receivers and schedule a drain task for the values just pushed
+             */
+            void sent(bool many)
+            {
+                channel.wakeReceivers(many);
+                if (!held)  //a consumer may have been attached after the guard was created
+                    held = retain(channel.consumer.load(std::memory_order_acquire));
+                if (held)
+                    channel.scheduleDrain(*held);
+            }
+        };
+
+        using NoDeadline = std::chrono::time_point<std::chrono::steady_clock>;
+        static constexpr NoDeadline noDeadline() { return NoDeadline::max(); }
+
+        template<typename U, typename Clock, typename Duration>
+        bool sendUntilImpl(U&& value, std::chrono::time_point<Clock, Duration> const& deadline)
+        {
+            bool sent = false;
+            SendGuard guard{ *this };
+            waitUntil([&] { return isClosedForSend() || (sent = queue.tryPush(std::forward<U>(value))); }, notFull, waitingSenders, deadline);
+            if (sent)
+                guard.sent(false);
+            else if (isClosedForSend())
+                throw ChannelClosedError{};
+            return sent;
+        }
+
+        template<typename Clock, typename Duration>
+        std::optional<T> receiveUntilImpl(std::chrono::time_point<Clock, Duration> const& deadline)
+        {
+            std::optional<T> value;
+            //re-check after seeing `closed`, because a value may have been sent right before closing
+            waitUntil([&] { return queue.tryPop(value) || (isClosedForSend() && (queue.tryPop(value) || true)); }, notEmpty, waitingReceivers, deadline);
+            if (value)
+                wakeSenders(false);
+            return value;
+        }
+    public:
+        using value_type = T;
+
+        /**
+         * @brief Construct a channel that holds at most `capacity` values (rounded up to a power of 2) before `send` blocks
+         */
+        explicit Channel(size_t capacity) :queue(capacity) {}
+
+        Channel(Channel const&) = delete;
+        Channel& operator=(Channel const&) = delete;
+
+        /**
+         * @brief Return the number of values the channel can hold
+         */
+        [[nodiscard]] size_t capacity() const { return queue.capacity(); }
+
+        /**
+         * @brief Close the channel. Sending to a closed channel fails, receiving continues until the remaining values are drained
+         */
+        void close()
+        {
+            {
+                std::lock_guard lock{ m };
+                closed.store(true);
+            }
+            wakeSenders(true);
+            wakeReceivers(true);
+            if (auto const current = consumer.load())
+            {
+                if (current->retain())
+                {
+                    scheduleDrain(*current);
+                    current->release();
+                }
+                current->releaseOpen();
+            }
+        }
+
+        /**
+         * @brief Return whether @ref close has been called
+         */
+        [[nodiscard]] bool isClosedForSend() const { return closed.load(std::memory_order_acquire); }
+
+        /**
+         * @brief Return whether the channel is closed and there is nothing left to receive
+         */
+        [[nodiscard]] bool isClosedForReceive() const { return isClosedForSend() && queue.empty(); }
+
+        /*Suspending callers*/
+
+        /**
+         * @brief Register `waiter` to be woken up once, when there may be room (for @ref ChannelWaiter::Side::Send) or a value (for @ref ChannelWaiter::Side::Receive), or the channel is closed
+         * @details This is how the coroutine `send` and `receive` of coroutine.hpp suspend without polling. A woken up waiter retries,
+         * and registers again if somebody else was faster.
+         * @return false without registering if there is already room/a value, or the channel is closed, so the caller should retry right away
+         */
+        bool addWaiter(std::shared_ptr<ChannelWaiter> waiter, ChannelWaiter::Side side)
+        {
+            auto const sending = side == ChannelWaiter::Side::Send;
+            auto& waiting = sending ? waitingSenders : waitingReceivers;
+            std::lock_guard lock{ m };
+            //register as waiting before checking, so the other side either sees us waiting or we see its change
+            waiting.fetch_add(1);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (isClosedForSend() || (sending ? !queue.full() : !queue.empty()))
+            {
+                waiting.fetch_sub(1);
+                return false;
+            }
+            (sending ? sendWaiters : receiveWaiters).push_back(std::move(waiter));
+            return true;
+        }
+
+        /**
+         * @brief Pass a wake-up on to another waiter of `side`, for a woken up waiter which is not going to retry (eg. because it was cancelled)
+         */
+        void wakeWaiter(ChannelWaiter::Side side)
+        {
+            side == ChannelWaiter::Side::Send ? wakeSenders(false) : wakeReceivers(false);
+        }
+
+        /*Send*/
+
+        /**
+         * @brief Send a value, blocking while the channel is full
+         * @throw ChannelClosedError if the channel is closed
+         */
+        template<typename U = T>
+        void send(U&& value)
+        {
+            sendUntilImpl(std::forward<U>(value), noDeadline());
+        }
+
+        /**
+         * @brief Send a value if there is room right now
+         * @return false if the channel is full or closed, in which case `value` is not moved from
+         */
+        template<typename U = T>
+        bool trySend(U&& value)
+        {
+            SendGuard guard{ *this };
+            if (isClosedForSend() || !queue.tryPush(std::forward<U>(value)))
+                return false;
+            guard.sent(false);
+            return true;
+        }
+
+        /**
+         * @brief Send a value, blocking for at most `timeout` while the channel is full
+         * @return false if timed out, in which case `value` is not moved from
+         * @throw ChannelClosedError if the channel is closed
+         */
+        template<typename U, typename Rep, typename Period>
+        bool sendFor(U&& value, std::chrono::duration<Rep, Period> const& timeout)
+        {
+            return sendUntilImpl(std::forward<U>(value), std::chrono::steady_clock::now() + timeout);
+        }
+
+        /**
+         * @brief Send a value, blocking until `deadline` while the channel is full
+         * @see sendFor
+         */
+        template<typename U, typename Clock, typename Duration>
+        bool sendUntil(U&& value, std::chrono::time_point<Clock, Duration> const& deadline)
+        {
+            return sendUntilImpl(std::forward<U>(value), deadline);
+        }
+
+        /**
+         * @brief Move all the values in [first, last) into the channel, blocking while it is full
+         * @details Values are pushed as many as there is room for at a time, and receivers are woken up once per such batch instead of once per value.
+         * @return The iterator past the last value sent, which is only different from `last` if the channel was closed meanwhile
+         * @tparam InputIt At least a forward iterator
+         */
+        template<typename InputIt>
+        InputIt sendBatch(InputIt first, InputIt last)
+        {
+            SendGuard guard{ *this };
+            while (first != last)
+            {
+                auto next = first;
+                waitUntil([&] { return isClosedForSend() || (next = queue.tryPushBatch(first, last)) != first; }, notFull, waitingSenders, noDeadline());
+                if (next == first)  //closed
+                    break;
+                guard.sent(true);
+                first = next;
+            }
+            return first;
+        }
+
+        /*Receive*/
+
+        /**
+         * @brief Receive a value, blocking while the channel is empty
+         * @return std::nullopt if the channel is closed and empty
+         */
+        std::optional<T> receive()
+        {
+            return receiveUntilImpl(noDeadline());
+        }
+
+        /**
+         * @brief Receive a value if there is one right now
+         */
+        std::optional<T> tryReceive()
+        {
+            std::optional<T> value;
+            if (queue.tryPop(value))
+                wakeSenders(false);
+            return value;
+        }
+
+        /**
+         * @brief Receive a value, blocking for at most `timeout` while the channel is empty
+         * @return std::nullopt if timed out or the channel is closed and empty
+         */
+        template<typename Rep, typename Period>
+        std::optional<T> receiveFor(std::chrono::duration<Rep, Period> const& timeout)
+        {
+            return receiveUntilImpl(std::chrono::steady_clock::now() + timeout);
+        }
+
+        /**
+         * @brief Receive a value, blocking until `deadline` while the channel is empty
+         * @see receiveFor
+         */
+        template<typename Clock, typename Duration>
+        std::optional<T> receiveUntil(std::chrono::time_point<Clock, Duration> const& deadline)
+        {
+            return receiveUntilImpl(deadline);
+        }
+
+        /**
+         * @brief Block until at least one value is available, then receive up to `maxCount` values into `out` without blocking again
+         * @details Senders are woken up once per batch instead of once per value.
+         * @return The number of values received, 0 means the channel is closed and empty
+         */
+        template<typename OutputIt>
+        size_t receiveBatch(OutputIt out, size_t maxCount)
+        {
+            size_t count = 0;
+            if (maxCount == 0)
+                return 0;
+            waitUntil([&] { return (count = queue.tryPopBatch(out, maxCount)) != 0 || (isClosedForSend() && (count = queue.tryPopBatch(out, maxCount), true)); },
+                notEmpty, waitingReceivers, noDeadline());
+            if (count != 0)
+                wakeSenders(true);
+            return count;
+        }
+
+        /**
+         * @brief Consume every value with `func` on `pool`, without blocking any thread while the channel is empty
+         * @details
+         * Sending a value posts a drain task to `pool` if less than `concurrency` of them are running. A drain task calls `func`
+         * on every value it can receive without waiting, then returns to the pool. Only one `forEach` consumer can be attached to a channel.
+         * ~~~~{.cpp}
+         *     Channel<std::string> lines{ 1024 };
+         *     auto done = lines.forEach([](std::string& line) { ThreadSafe<>::print(line); }, 4);
+         *     for (auto const& line : FileIterator{ "log.txt" })
+         *         lines.send(line);
+         *     lines.close();
+         *     done.get();
+         * ~~~~
+         * @param func Called with a `T&`, from up to `concurrency` threads at once
+         * @param concurrency The most drain tasks running at once, always 1 for an SPSC channel, which has a single receiver
+         * @return A `std::future` which becomes ready when the channel is closed and every value has been consumed, holding the first exception thrown by `func` if any
+         * @throw std::logic_error if a consumer is already attached
+         */
+        template<typename Func>
+        std::future<void> forEach(Func func, unsigned concurrency = 1, ThreadPool& pool = ThreadPool::shared())
+        {
+            {
+                std::lock_guard lock{ m };
+                if (consumerStorage)
+                    throw std::logic_error{ "Channel already has a consumer" };
+                consumerStorage = std::make_unique<ConsumerModel<Func>>(std::move(func), pool, Type == ChannelType::SPSC ? 1u : concurrency);
+            }
+            auto& current = *consumerStorage;
+            auto result = current.done.get_future();
+            consumer.store(&current);
+            if (current.retain())
+            {
+                scheduleDrain(current);
+                current.release();
+            }
+            if (closed.load())  //close() may have run before the consumer was attached
+                current.releaseOpen();
+            return result;
+        }
+
+        /*Range-based for loop*/
+
+        /**
+         * @brief The iterator of a Channel, which receives a value every time it is incremented. A default constructed one is the end iterator
+         */
+        class iterator
+        {
+            Channel* channel = nullptr;
+            std::optional<T> current;
+        public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using pointer = T*;
+            using reference = T&;
+
+            iterator() = default;
+            explicit iterator(Channel* channel) :channel(channel) { ++*this; }
+
+            reference operator*() { return *current; }
+            pointer operator->() { return &*current; }
+
+            iterator& operator++()
+            {
+                current = channel->receive();
+                if (!current)
+                    channel = nullptr;
+                return *this;
+            }
+
+            bool operator==(iterator const& rhs) const { return channel == rhs.channel; }
+            bool operator!=(iterator const& rhs) const { return channel != rhs.channel; }
+        };
+
+        /**
+         * @brief Receive the first value, the loop ends when the channel is closed and empty
+         */
+        iterator begin() { return iterator{ this }; }
+
+        /**
+         * @brief Return the end iterator
+         */
+        iterator end() { return {}; }
+    };
+
+#ifdef SugarPPNamespace
+}
+#endif
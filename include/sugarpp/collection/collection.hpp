@@ -0,0 +1,343 @@
+/*****************************************************************//**
+ * \file   collection.hpp
+ * \brief  Python-style Counter and Kotlin-style groupBy, associateBy and associate, built on @ref HashMap
+ *
+ * \author Peter
+ * \date   October 2026
+ * \note The maps are unordered, unlike the LinkedHashMap returned by Kotlin. The elements inside a group keep their order.
+ *********************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "hashMap.hpp"
+#include "../range/range.hpp"
+#include "../range/parallel.hpp"
+#include "../traits/traits.hpp"
+
+#ifdef SugarPPNamespace
+namespace SugarPP
+{
+#endif
+
+    namespace Collection_detail
+    {
+        template<typename Iterable>
+        using ElementType = std::decay_t<decltype(*std::begin(std::declval<Iterable&>()))>;
+
+        template<typename Func, typename Iterable>
+        using ResultType = std::decay_t<std::invoke_result_t<Func&, decltype(*std::begin(std::declval<Iterable&>()))>>;
+
+        /**
+         * @brief Whether the iterator of `Iterable` is random access, so that it can be split into chunks for the threads
+         */
+        template<typename Iterable, typename = void>
+        struct random_access : std::false_type {};
+
+        template<typename Iterable>
+        struct random_access<Iterable, std::enable_if_t<std::is_base_of_v<std::random_access_iterator_tag,
+            typename std::iterator_traits<decltype(std::begin(std::declval<Iterable&>()))>::iterator_category>>> : std::true_type {};
+
+        /**
+         * @brief Below this many elements per thread, building and merging one map per thread is slower than a single map
+         */
+        constexpr size_t parallelGrain = 1 << 14;
+
+        /**
+         * @brief Build a `Map` by calling `add(map, element)` for every element
+         * @details
+         * With a pool and a random access iterable, every thread builds its own map from a contiguous chunk, and the maps are merged
+         * with `merge(result, std::move(map))` in the order of the chunks, so that the result is the same as building it sequentially.
+         */
+        template<typename Map, typename Iterable, typename Add, typename Merge>
+        Map build(ThreadPool* pool, Iterable& iterable, Add add, Merge merge)
+        {
+            if constexpr (random_access<Iterable>::value)
+            {
+                auto const count = static_cast<size_t>(std::distance(std::begin(iterable), std::end(iterable)));
+                auto const chunkCount = pool ? std::min<size_t>(pool->size(), count / parallelGrain) : 0;
+                if (chunkCount >= 2)
+                {
+                    auto const begin = std::begin(iterable);
+                    auto buildChunk = [begin, &add](auto chunk)
+                    {
+                        Map map;
+                        for (auto i = static_cast<size_t>(*chunk); i < static_cast<size_t>(chunk.end()); ++i)
+                            add(map, begin[static_cast<std::ptrdiff_t>(i)]);
+                        return map;
+                    };
+                    auto maps = Range_detail::parallelOn(*pool, Range(size_t{ 0 }, count), buildChunk, static_cast<unsigned>(chunkCount));
+                    auto result = std::move(maps.front());
+                    for (size_t i = 1; i < maps.size(); ++i)
+                        merge(result, std::move(maps[i]));
+                    return result;
+                }
+            }
+            Map map;
+            for (auto&& element : iterable)
+                add(map, element);
+            return map;
+        }
+
+        template<typename Iterable, typename KeySelector, typename ValueTransform>
+        auto groupBy(ThreadPool* pool, Iterable& iterable, KeySelector& keySelector, ValueTransform& valueTransform)
+        {
+            using Map = HashMap<ResultType<KeySelector, Iterable>, std::vector<ResultType<ValueTransform, Iterable>>>;
+            return build<Map>(pool, iterable,
+                [&](Map& map, auto&& element) { map[std::invoke(keySelector, element)].push_back(std::invoke(valueTransform, element)); },
+                [](Map& result, Map&& map)
+                {
+                    for (auto& [key, values] : map)
+                    {
+                        auto& group = result[key];
+                        if (group.empty())
+                            group = std::move(values);
+                        else
+                            group.insert(group.end(), std::make_move_iterator(values.begin()), std::make_move_iterator(values.end()));
+                    }
+                });
+        }
+
+        template<typename Map, typename Iterable, typename Transform>
+        Map associate(ThreadPool* pool, Iterable& iterable, Transform transform)
+        {
+            return build<Map>(pool, iterable,
+                [&transform](Map& map, auto&& element)
+                {
+                    auto [key, value] = transform(element);
+                    map.insert_or_assign(std::move(key), std::move(value));
+                },
+                [](Map& result, Map&& map)
+                {
+                    for (auto& [key, value] : map)
+                        result.insert_or_assign(key, std::move(value));
+                });
+        }
+    }
+
+    /**
+     * @brief Counts how many times each element occurs, like `collections.Counter` in Python
+     * ~~~~{.cpp}
+     *     Counter words{ std::vector<std::string>{ "a", "b", "a" } };
+     *     words.count("a");        //2
+     *     words.mostCommon(1);     //{ { "a", 2 } }
+     * ~~~~
+     */
+    template<typename T, typename Hash = std::hash<T>, typename Equal = std::equal_to<T>>
+    class Counter
+    {
+        using Map = HashMap<T, size_t, Hash, Equal>;
+        Map counts;
+
+        template<typename Iterable>
+        static Map countAll(ThreadPool* pool, Iterable& iterable)
+        {
+            return Collection_detail::build<Map>(pool, iterable,
+                [](Map& map, auto&& element) { ++map[element]; },
+                [](Map& result, Map&& map)
+                {
+                    if (map.size() > result.size())
+                        result.swap(map);
+                    for (auto const& [key, count] : map)
+                        result[key] += count;
+                });
+        }
+    public:
+        using iterator = typename Map::const_iterator;
+        using const_iterator = typename Map::const_iterator;
+
+        Counter() = default;
+
+        /**
+         * @brief Count the elements of `iterable`
+         * @note Not a candidate for another Counter, so that copying a non-const Counter calls the copy constructor
+         */
+        template<typename Iterable, typename = std::enable_if_t<Traits_detail::iterable_lvalue<Iterable>::value && !std::is_same_v<std::decay_t<Iterable>, Counter>>>
+        explicit Counter(Iterable&& iterable) :counts(countAll(nullptr, iterable))
+        {
+        }
+
+        /**
+         * @brief Count the elements of `iterable` on the threads of `policy`, each counting a chunk into its own map
+         * @note Only random access iterables are split, others are counted by the calling thread
+         */
+        template<typename Iterable, typename = std::enable_if_t<Traits_detail::iterable_lvalue<Iterable>::value>>
+        Counter(ParallelPolicy policy, Iterable&& iterable) :counts(countAll(&policy.getPool(), iterable))
+        {
+        }
+
+        /**
+         * @brief Add the elements of `iterable` to the counts
+         */
+        template<typename Iterable, typename = std::enable_if_t<Traits_detail::iterable_lvalue<Iterable>::value && !std::is_same_v<std::decay_t<Iterable>, Counter>>>
+        void update(Iterable&& iterable)
+        {
+            for (auto&& element : iterable)
+                ++counts[element];
+        }
+
+        /**
+         * @brief Add the counts of `other`
+         */
+        void update(Counter const& other)
+        {
+            for (auto const& [key, count] : other)
+                counts[key] += count;
+        }
+
+        /**
+         * @brief Return the count of `key`, which is inserted with 0 if it was not counted
+         */
+        size_t& operator[](T const& key) { return counts[key]; }
+
+        /**
+         * @brief Return the count of `key`, or 0 if it was not counted
+         */
+        [[nodiscard]] size_t count(T const& key) const
+        {
+            auto const iter = counts.find(key);
+            return iter == counts.end() ? 0 : iter->second;
+        }
+
+        /**
+         * @brief Return the sum of all the counts
+         */
+        [[nodiscard]] size_t total() const
+        {
+            size_t sum = 0;
+            for (auto const& element : counts)
+                sum += element.second;
+            return sum;
+        }
+
+        /**
+         * @brief Return the `n` most common elements and their counts, from the most common one
+         * @details All the elements are returned when `n` is not given. Elements with equal counts are in no particular order.
+         */
+        [[nodiscard]] std::vector<std::pair<T, size_t>> mostCommon(size_t n = std::numeric_limits<size_t>::max()) const
+        {
+            std::vector<std::pair<T, size_t>> result(counts.begin(), counts.end());
+            auto const byCount = [](auto const& lhs, auto const& rhs) { return lhs.second > rhs.second; };
+            if (n < result.size())
+            {
+                std::partial_sort(result.begin(), result.begin() + static_cast<std::ptrdiff_t>(n), result.end(), byCount);
+                result.resize(n);
+            }
+            else
+                std::sort(result.begin(), result.end(), byCount);
+            return result;
+        }
+
+        /**
+         * @brief Forget `key`, returning whether it was counted
+         */
+        bool erase(T const& key) { return counts.erase(key) != 0; }
+
+        void clear() { counts.clear(); }
+
+        /**
+         * @brief The number of distinct elements
+         */
+        [[nodiscard]] size_t size() const { return counts.size(); }
+        [[nodiscard]] bool empty() const { return counts.empty(); }
+
+        /**
+         * @brief Iterate over the `std::pair<T, size_t>` of every element and its count, in no particular order
+         */
+        const_iterator begin() const { return counts.begin(); }
+        const_iterator end() const { return counts.end(); }
+    };
+
+    template<typename Iterable, typename = std::enable_if_t<Traits_detail::iterable_lvalue<Iterable>::value>>
+    Counter(Iterable&&) -> Counter<Collection_detail::ElementType<Iterable>>;
+
+    template<typename Iterable, typename = std::enable_if_t<Traits_detail::iterable_lvalue<Iterable>::value>>
+    Counter(ParallelPolicy, Iterable&&) -> Counter<Collection_detail::ElementType<Iterable>>;
+
+    /**
+     * @brief Group the elements of `iterable` by the key returned by `keySelector`, like `groupBy` in Kotlin
+     * @param valueTransform Applied to each element before it is added to its group, by default the element itself
+     * @return A @ref HashMap from each key to a `std::vector` of the elements having it, in the order of `iterable`
+     * ~~~~{.cpp}
+     *     groupBy(words, [](auto const& word) { return word.size(); });
+     * ~~~~
+     */
+    template<typename Iterable, typename KeySelector, typename ValueTransform = Traits_detail::Identity,
+        typename = std::enable_if_t<Traits_detail::iterable_lvalue<Iterable>::value>>
+    [[nodiscard]] auto groupBy(Iterable&& iterable, KeySelector&& keySelector, ValueTransform&& valueTransform = {})
+    {
+        return Collection_detail::groupBy(nullptr, iterable, keySelector, valueTransform);
+    }
+
+    /**
+     * @brief Group the elements of `iterable` on the threads of `policy`, with the same result as the sequential @ref groupBy
+     */
+    template<typename Iterable, typename KeySelector, typename ValueTransform = Traits_detail::Identity,
+        typename = std::enable_if_t<Traits_detail::iterable_lvalue<Iterable>::value>>
+    [[nodiscard]] auto groupBy(ParallelPolicy policy, Iterable&& iterable, KeySelector&& keySelector, ValueTransform&& valueTransform = {})
+    {
+        return Collection_detail::groupBy(&policy.getPool(), iterable, keySelector, valueTransform);
+    }
+
+    /**
+     * @brief Map the key returned by `keySelector` for each element to the element, or to `valueTransform` of it, like `associateBy` in Kotlin
+     * @details When several elements have the same key, the last one is kept.
+     */
+    template<typename Iterable, typename KeySelector, typename ValueTransform = Traits_detail::Identity,
+        typename = std::enable_if_t<Traits_detail::iterable_lvalue<Iterable>::value>>
+    [[nodiscard]] auto associateBy(Iterable&& iterable, KeySelector&& keySelector, ValueTransform&& valueTransform = {})
+    {
+        using Map = HashMap<Collection_detail::ResultType<KeySelector, Iterable>, Collection_detail::ResultType<ValueTransform, Iterable>>;
+        return Collection_detail::associate<Map>(nullptr, iterable, [&](auto&& element)
+        {
+            return std::pair{ std::invoke(keySelector, element), std::invoke(valueTransform, element) };
+        });
+    }
+
+    /**
+     * @brief @ref associateBy on the threads of `policy`, where the last element of a key is still kept
+     */
+    template<typename Iterable, typename KeySelector, typename ValueTransform = Traits_detail::Identity,
+        typename = std::enable_if_t<Traits_detail::iterable_lvalue<Iterable>::value>>
+    [[nodiscard]] auto associateBy(ParallelPolicy policy, Iterable&& iterable, KeySelector&& keySelector, ValueTransform&& valueTransform = {})
+    {
+        using Map = HashMap<Collection_detail::ResultType<KeySelector, Iterable>, Collection_detail::ResultType<ValueTransform, Iterable>>;
+        return Collection_detail::associate<Map>(&policy.getPool(), iterable, [&](auto&& element)
+        {
+            return std::pair{ std::invoke(keySelector, element), std::invoke(valueTransform, element) };
+        });
+    }
+
+    /**
+     * @brief Map each element to the key and value of the `std::pair` returned by `transform`, like `associate` in Kotlin
+     * @details When several elements have the same key, the last one is kept.
+     */
+    template<typename Iterable, typename Transform, typename = std::enable_if_t<Traits_detail::iterable_lvalue<Iterable>::value>>
+    [[nodiscard]] auto associate(Iterable&& iterable, Transform&& transform)
+    {
+        using Pair = Collection_detail::ResultType<Transform, Iterable>;
+        using Map = HashMap<std::decay_t<typename Pair::first_type>, std::decay_t<typename Pair::second_type>>;
+        return Collection_detail::associate<Map>(nullptr, iterable, [&](auto&& element) { return std::invoke(transform, element); });
+    }
+
+    /**
+     * @brief @ref associate on the threads of `policy`, where the last element of a key is still kept
+     */
+    template<typename Iterable, typename Transform, typename = std::enable_if_t<Traits_detail::iterable_lvalue<Iterable>::value>>
+    [[nodiscard]] auto associate(ParallelPolicy policy, Iterable&& iterable, Transform&& transform)
+    {
+        using Pair = Collection_detail::ResultType<Transform, Iterable>;
+        using Map = HashMap<std::decay_t<typename Pair::first_type>, std::decay_t<typename Pair::second_type>>;
+        return Collection_detail::associate<Map>(&policy.getPool(), iterable, [&](auto&& element) { return std::invoke(transform, element); });
+    }
+
+#ifdef SugarPPNamespace
+}
+#endif
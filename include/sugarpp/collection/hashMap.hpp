@@ -0,0 +1,519 @@
+/*****************************************************************//**
+ * \file   hashMap.hpp
+ * \brief  An open-addressing hash map probing groups of control bytes with SIMD, in the style of Swiss tables
+ *
+ * \author Peter
+ * \date   October 2026
+ *********************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SugarPPHashMapSSE2
+#include <emmintrin.h>
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+#ifdef SugarPPNamespace
+namespace SugarPP
+{
+#endif
+
+    namespace HashMap_detail
+    {
+        /*A control byte is empty, deleted, or the 7 low bits of the hash of a full slot*/
+        constexpr std::int8_t Empty = -128;
+        constexpr std::int8_t Deleted = -2;
+
+        inline unsigned trailingZeros(std::uint64_t value)
+        {
+#ifdef _MSC_VER
+            unsigned long index;
+            _BitScanForward64(&index, value);
+            return static_cast<unsigned>(index);
+#else
+            return static_cast<unsigned>(__builtin_ctzll(value));
+#endif
+        }
+
+        /**
+         * @brief The slots of a group matching a condition, as a bit mask with `Shift` bits per slot
+         */
+        template<typename Bits, unsigned Shift>
+        class Mask
+        {
+            Bits bits;
+        public:
+            explicit Mask(Bits bits) :bits(bits) {}
+            explicit operator bool() const { return bits != 0; }
+            unsigned lowest() const { return trailingZeros(bits) >> Shift; }
+            void next() { bits &= bits - 1; }
+        };
+
+#ifdef SugarPPHashMapSSE2
+        /**
+         * @brief 16 control bytes compared at once with SSE2
+         */
+        class Group
+        {
+            __m128i ctrl;
+        public:
+            static constexpr size_t width = 16;
+            using MaskType = Mask<std::uint32_t, 0>;
+
+            explicit Group(std::int8_t const* position) :ctrl(_mm_loadu_si128(reinterpret_cast<__m128i const*>(position))) {}
+
+            MaskType match(std::int8_t h2) const
+            {
+                return MaskType{ static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl))) };
+            }
+
+            MaskType matchEmpty() const
+            {
+                return MaskType{ static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(Empty), ctrl))) };
+            }
+
+            /*empty and deleted are the only control bytes with the high bit set*/
+            MaskType matchEmptyOrDeleted() const
+            {
+                return MaskType{ static_cast<std::uint32_t>(_mm_movemask_epi8(ctrl)) };
+            }
+        };
+#else
+        /**
+         * @brief 8 control bytes compared at once in a 64-bit integer, for the platforms without SSE2
+         * @details `match` may report a false positive after a true one, which costs one more key comparison
+         */
+        class Group
+        {
+            static constexpr std::uint64_t lsbs = 0x0101010101010101ull;
+            static constexpr std::uint64_t msbs = 0x8080808080808080ull;
+            std::uint64_t ctrl = 0;
+        public:
+            static constexpr size_t width = 8;
+            using MaskType = Mask<std::uint64_t, 3>;
+
+            explicit Group(std::int8_t const* position)
+            {
+                for (size_t i = 0; i < width; ++i)
+                    ctrl |= static_cast<std::uint64_t>(static_cast<std::uint8_t>(position[i])) << (i * 8);
+            }
+
+            MaskType match(std::int8_t h2) const
+            {
+                auto const x = ctrl ^ (lsbs * static_cast<std::uint8_t>(h2));
+                return MaskType{ (x - lsbs) & ~x & msbs };
+            }
+
+            MaskType matchEmpty() const
+            {
+                return MaskType{ (ctrl & ~(ctrl << 6)) & msbs };
+            }
+
+            MaskType matchEmptyOrDeleted() const
+            {
+                return MaskType{ ctrl & msbs };
+            }
+        };
+#endif
+
+        /**
+         * @brief Spread the bits of `hash`, as `std::hash` of integers is the identity in most standard libraries
+         */
+        inline size_t mix(size_t hash)
+        {
+            if constexpr (sizeof(size_t) == 8)
+            {
+                auto const mixed = static_cast<std::uint64_t>(hash) * 0x9E3779B97F4A7C15ull;
+                return static_cast<size_t>(mixed ^ (mixed >> 32));
+            }
+            else
+            {
+                auto const mixed = static_cast<std::uint32_t>(hash) * 0x9E3779B9u;
+                return static_cast<size_t>(mixed ^ (mixed >> 16));
+            }
+        }
+    }
+
+    /**
+     * @brief An unordered map from `Key` to `Value`, with the interface of a subset of `std::unordered_map`
+     * @details
+     * The elements are stored in a single array, and a separate array of one control byte per element holds 7 bits of its hash.
+     * A lookup compares a group of 16 control bytes at once with SSE2 (8 in a 64-bit integer elsewhere), and only compares the keys
+     * whose control byte matches, so most lookups touch one cache line of control bytes and one element.
+     * Compared to `std::unordered_map` there is no node allocation, about 1 byte of overhead per element, and the table is at most 7/8 full.
+     *
+     * Unlike `std::unordered_map`, inserting may move the elements and invalidate every iterator and reference.
+     * The elements are `std::pair<Key, Value>`, whose key must not be modified.
+     */
+    template<typename Key, typename Value, typename Hash = std::hash<Key>, typename Equal = std::equal_to<Key>>
+    class HashMap : Hash, Equal
+    {
+        using Group = HashMap_detail::Group;
+    public:
+        using key_type = Key;
+        using mapped_type = Value;
+        using value_type = std::pair<Key, Value>;
+        using size_type = size_t;
+        using hasher = Hash;
+        using key_equal = Equal;
+
+    private:
+        std::unique_ptr<std::int8_t[]> ctrl;    //capacity control bytes, then a copy of the first Group::width of them
+        value_type* slots = nullptr;
+        size_t capacity = 0;                    //0 or a power of 2 which is at least 16
+        size_t elementCount = 0;
+        size_t growthLeft = 0;                  //how many empty slots can be used before growing
+
+        template<bool Const>
+        class Iterator
+        {
+            friend class HashMap;
+            template<bool> friend class Iterator;
+            using Map = std::conditional_t<Const, HashMap const, HashMap>;
+            Map* map = nullptr;
+            size_t index = 0;
+
+            Iterator(Map* map, size_t index) :map(map), index(index) { skipEmpty(); }
+
+            void skipEmpty()
+            {
+                while (index < map->capacity && map->ctrl[index] < 0)
+                    ++index;
+            }
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = typename HashMap::value_type;
+            using difference_type = std::ptrdiff_t;
+            using pointer = std::conditional_t<Const, value_type const*, value_type*>;
+            using reference = std::conditional_t<Const, value_type const&, value_type&>;
+
+            Iterator() = default;
+            operator Iterator<true>() const { return { map, index }; }
+
+            reference operator*() const { return map->slots[index]; }
+            pointer operator->() const { return map->slots + index; }
+            Iterator& operator++() { ++index; skipEmpty(); return *this; }
+            Iterator operator++(int) { auto copy = *this; ++*this; return copy; }
+            bool operator==(Iterator const& rhs) const { return index == rhs.index; }
+            bool operator!=(Iterator const& rhs) const { return index != rhs.index; }
+        };
+
+        size_t hashOf(Key const& key) const
+        {
+            return HashMap_detail::mix(static_cast<Hash const&>(*this)(key));
+        }
+
+        static std::int8_t h2(size_t hash) { return static_cast<std::int8_t>(hash & 0x7F); }
+
+        void setCtrl(size_t index, std::int8_t value)
+        {
+            ctrl[index] = value;
+            if (index < Group::width)
+                ctrl[capacity + index] = value;
+        }
+
+        /**
+         * @brief Call `func(position)` for the groups on the probe sequence of `hash` until it returns true, visiting every group once
+         */
+        template<typename Func>
+        void probe(size_t hash, Func&& func) const
+        {
+            auto const mask = capacity - 1;
+            auto position = (hash >> 7) & mask;
+            for (size_t step = Group::width; !func(position); step += Group::width)
+                position = (position + step) & mask;
+        }
+
+        size_t findIndex(Key const& key, size_t hash) const
+        {
+            if (capacity == 0)
+                return capacity;
+            auto result = capacity;
+            probe(hash, [&](size_t position)
+            {
+                Group const group{ ctrl.get() + position };
+                for (auto match = group.match(h2(hash)); match; match.next())
+                {
+                    auto const index = (position + match.lowest()) & (capacity - 1);
+                    if (static_cast<Equal const&>(*this)(slots[index].first, key))
+                    {
+                        result = index;
+                        return true;
+                    }
+                }
+                return static_cast<bool>(group.matchEmpty());
+            });
+            return result;
+        }
+
+        size_t findFirstNonFull(size_t hash) const
+        {
+            size_t result = 0;
+            probe(hash, [&](size_t position)
+            {
+                auto const match = Group{ ctrl.get() + position }.matchEmptyOrDeleted();
+                if (match)
+                    result = (position + match.lowest()) & (capacity - 1);
+                return static_cast<bool>(match);
+            });
+            return result;
+        }
+
+        static size_t growthOf(size_t capacity) { return capacity - capacity / 8; }
+
+        void rehash(size_t newCapacity)
+        {
+            auto oldCtrl = std::move(ctrl);
+            auto const oldSlots = slots;
+            auto const oldCapacity = capacity;
+
+            slots = std::allocator<value_type>{}.allocate(newCapacity);
+            ctrl.reset(new std::int8_t[newCapacity + Group::width]);
+            std::fill_n(ctrl.get(), newCapacity + Group::width, HashMap_detail::Empty);
+            capacity = newCapacity;
+            growthLeft = growthOf(newCapacity) - elementCount;
+
+            for (size_t i = 0; i < oldCapacity; ++i)
+            {
+                if (oldCtrl[i] < 0)
+                    continue;
+                auto const hash = hashOf(oldSlots[i].first);
+                auto const index = findFirstNonFull(hash);
+                setCtrl(index, h2(hash));
+                new (slots + index) value_type{ std::move(oldSlots[i]) };
+                oldSlots[i].~value_type();
+            }
+            if (oldSlots)
+                std::allocator<value_type>{}.deallocate(oldSlots, oldCapacity);
+        }
+
+        /**
+         * @brief Return the index of `key`, and whether it was inserted by constructing the value from `args`
+         */
+        template<typename K, typename... Args>
+        std::pair<size_t, bool> findOrInsert(K&& key, Args&&... args)
+        {
+            auto const hash = hashOf(key);
+            auto const found = findIndex(key, hash);
+            if (found != capacity)
+                return { found, false };
+
+            auto index = capacity == 0 ? 0 : findFirstNonFull(hash);
+            if (capacity == 0 || (growthLeft == 0 && ctrl[index] == HashMap_detail::Empty))
+            {
+                /*grow, unless most of the used slots are deleted ones which a rehash of the same capacity frees*/
+                rehash(capacity == 0 ? 16 : (elementCount + 1 > growthOf(capacity) / 2 ? capacity * 2 : capacity));
+                index = findFirstNonFull(hash);
+            }
+            new (slots + index) value_type{ std::piecewise_construct, std::forward_as_tuple(std::forward<K>(key)), std::forward_as_tuple(std::forward<Args>(args)...) };
+            growthLeft -= ctrl[index] == HashMap_detail::Empty;
+            setCtrl(index, h2(hash));
+            ++elementCount;
+            return { index, true };
+        }
+
+        void destroy()
+        {
+            if (!slots)
+                return;
+            for (size_t i = 0; i < capacity; ++i)
+            {
+                if (ctrl[i] >= 0)
+                    slots[i].~value_type();
+            }
+            std::allocator<value_type>{}.deallocate(slots, capacity);
+            slots = nullptr;
+            ctrl.reset();
+            capacity = elementCount = growthLeft = 0;
+        }
+
+    public:
+        using iterator = Iterator<false>;
+        using const_iterator = Iterator<true>;
+
+        HashMap() = default;
+
+        explicit HashMap(size_t bucketCount, Hash const& hash = Hash{}, Equal const& equal = Equal{}) :Hash(hash), Equal(equal)
+        {
+            reserve(bucketCount);
+        }
+
+        HashMap(std::initializer_list<value_type> values)
+        {
+            reserve(values.size());
+            for (auto const& value : values)
+                insert(value);
+        }
+
+        HashMap(HashMap const& other) :Hash(other), Equal(other)
+        {
+            reserve(other.size());
+            for (auto const& value : other)
+                insert(value);
+        }
+
+        HashMap(HashMap&& other) noexcept
+            :Hash(std::move(other)), Equal(std::move(other)), ctrl(std::move(other.ctrl)), slots(other.slots), capacity(other.capacity), elementCount(other.elementCount), growthLeft(other.growthLeft)
+        {
+            other.slots = nullptr;
+            other.capacity = other.elementCount = other.growthLeft = 0;
+        }
+
+        HashMap& operator=(HashMap other) noexcept
+        {
+            swap(other);
+            return *this;
+        }
+
+        ~HashMap() { destroy(); }
+
+        void swap(HashMap& other) noexcept
+        {
+            using std::swap;
+            swap(static_cast<Hash&>(*this), static_cast<Hash&>(other));
+            swap(static_cast<Equal&>(*this), static_cast<Equal&>(other));
+            swap(ctrl, other.ctrl);
+            swap(slots, other.slots);
+            swap(capacity, other.capacity);
+            swap(elementCount, other.elementCount);
+            swap(growthLeft, other.growthLeft);
+        }
+
+        iterator begin() { return { this, 0 }; }
+        iterator end() { return { this, capacity }; }
+        const_iterator begin() const { return { this, 0 }; }
+        const_iterator end() const { return { this, capacity }; }
+
+        [[nodiscard]] size_t size() const { return elementCount; }
+        [[nodiscard]] bool empty() const { return elementCount == 0; }
+
+        /**
+         * @brief Make room for `elements` elements without growing
+         */
+        void reserve(size_t elements)
+        {
+            size_t newCapacity = 16;
+            while (growthOf(newCapacity) < elements)
+                newCapacity *= 2;
+            if (newCapacity > capacity)
+                rehash(newCapacity);
+        }
+
+        void clear() { destroy(); }
+
+        iterator find(Key const& key)
+        {
+            return { this, capacity == 0 ? 0 : findIndex(key, hashOf(key)) };
+        }
+
+        const_iterator find(Key const& key) const
+        {
+            return { this, capacity == 0 ? 0 : findIndex(key, hashOf(key)) };
+        }
+
+        [[nodiscard]] bool contains(Key const& key) const { return find(key) != end(); }
+
+        /**
+         * @brief Return 1 if `key` is in the map, 0 otherwise
+         */
+        [[nodiscard]] size_t count(Key const& key) const { return contains(key) ? 1 : 0; }
+
+        Value& at(Key const& key)
+        {
+            auto const found = find(key);
+            if (found == end())
+                throw std::out_of_range{ "HashMap::at: key not found" };
+            return found->second;
+        }
+
+        Value const& at(Key const& key) const
+        {
+            auto const found = find(key);
+            if (found == end())
+                throw std::out_of_range{ "HashMap::at: key not found" };
+            return found->second;
+        }
+
+        Value& operator[](Key const& key)
+        {
+            auto const index = findOrInsert(key).first;     //before reading slots, which inserting may reallocate
+            return slots[index].second;
+        }
+
+        Value& operator[](Key&& key)
+        {
+            auto const index = findOrInsert(std::move(key)).first;
+            return slots[index].second;
+        }
+
+        template<typename... Args>
+        std::pair<iterator, bool> try_emplace(Key const& key, Args&&... args)
+        {
+            auto const [index, inserted] = findOrInsert(key, std::forward<Args>(args)...);
+            return { iterator{ this, index }, inserted };
+        }
+
+        template<typename... Args>
+        std::pair<iterator, bool> try_emplace(Key&& key, Args&&... args)
+        {
+            auto const [index, inserted] = findOrInsert(std::move(key), std::forward<Args>(args)...);
+            return { iterator{ this, index }, inserted };
+        }
+
+        std::pair<iterator, bool> insert(value_type const& value) { return try_emplace(value.first, value.second); }
+        std::pair<iterator, bool> insert(value_type&& value) { return try_emplace(std::move(value.first), std::move(value.second)); }
+
+        template<typename V>
+        std::pair<iterator, bool> insert_or_assign(Key const& key, V&& value)
+        {
+            auto result = try_emplace(key, std::forward<V>(value));
+            if (!result.second)
+                result.first->second = std::forward<V>(value);
+            return result;
+        }
+
+        template<typename V>
+        std::pair<iterator, bool> insert_or_assign(Key&& key, V&& value)
+        {
+            auto result = try_emplace(std::move(key), std::forward<V>(value));
+            if (!result.second)
+                result.first->second = std::forward<V>(value);
+            return result;
+        }
+
+        /**
+         * @brief Remove `key` from the map
+         * @return The number of elements removed, 0 or 1
+         */
+        size_t erase(Key const& key)
+        {
+            auto const found = find(key);
+            if (found == end())
+                return 0;
+            slots[found.index].~value_type();
+            setCtrl(found.index, HashMap_detail::Deleted);
+            --elementCount;
+            return 1;
+        }
+    };
+
+#ifdef SugarPPNamespace
+}
+#endif
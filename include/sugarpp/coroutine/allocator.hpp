@@ -0,0 +1,143 @@
+/*****************************************************************//**
+ * \file   allocator.hpp
+ * \brief  Recycling allocator for coroutine frames
+ *
+ * \author Peter
+ * \date   October 2026
+ * \note Requires C++20 coroutine support
+ *********************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <utility>
+
+#ifdef SugarPPNamespace
+namespace SugarPP
+{
+#endif
+
+    /**
+     * @brief A thread-local, size-class based free-list allocator for coroutine frames
+     * @details
+     * Coroutine frames of the same coroutine function always have the same size, so a frame released by a finished
+     * coroutine can be handed to the next one without going back to the global heap.
+     *
+     * Sizes are rounded up to `Granularity` bytes. Frames up to `Granularity * SizeClasses` bytes are cached,
+     * at most `MaxCachedPerClass` of them per size class per thread. Larger frames go straight to `::operator new`.
+     * A frame may be released on a different thread than the one it was allocated on.
+     */
+    class FrameAllocator
+    {
+        static constexpr std::size_t Granularity = 64;
+        static constexpr std::size_t SizeClasses = 64;
+        static constexpr unsigned MaxCachedPerClass = 64;
+
+        struct FreeBlock
+        {
+            FreeBlock* next;
+        };
+
+        struct Cache
+        {
+            FreeBlock* heads[SizeClasses]{};
+            unsigned counts[SizeClasses]{};
+
+            ~Cache()
+            {
+                destroyed() = true;
+                for (auto head : heads)
+                {
+                    while (head)
+                        ::operator delete(std::exchange(head, head->next));
+                }
+            }
+        };
+
+        /**
+         * @brief Frames may still be released while the thread is exiting, after its cache is destroyed
+         */
+        static bool& destroyed()
+        {
+            static thread_local bool value = false;
+            return value;
+        }
+
+        static Cache& cache()
+        {
+            static thread_local Cache value;
+            return value;
+        }
+
+        static constexpr std::size_t sizeClass(std::size_t size)
+        {
+            return (size + Granularity - 1) / Granularity - 1;
+        }
+    public:
+        /**
+         * @brief Return a block of at least `size` bytes, reusing a cached frame of the same size class when there is one
+         */
+        static void* allocate(std::size_t size)
+        {
+            auto const index = sizeClass(size);
+            if (index >= SizeClasses)
+                return ::operator new(size);
+
+            //always allocate the whole size class, because the block may be cached and reused by another thread
+            if (!destroyed())
+            {
+                auto& local = cache();
+                if (auto block = local.heads[index])
+                {
+                    local.heads[index] = block->next;
+                    --local.counts[index];
+                    return block;
+                }
+            }
+            return ::operator new((index + 1) * Granularity);
+        }
+
+        /**
+         * @brief Give a block back to the calling thread's cache, or to the global heap if the cache is full
+         * @param size Must be the same size passed to `allocate()`
+         */
+        static void deallocate(void* pointer, std::size_t size) noexcept
+        {
+            auto const index = sizeClass(size);
+            if (index >= SizeClasses || destroyed())
+            {
+                ::operator delete(pointer);
+                return;
+            }
+
+            auto& local = cache();
+            if (local.counts[index] == MaxCachedPerClass)
+            {
+                ::operator delete(pointer);
+                return;
+            }
+            local.heads[index] = new (pointer) FreeBlock{ local.heads[index] };
+            ++local.counts[index];
+        }
+    };
+
+    /**
+     * @brief Inherit a coroutine `promise_type` from this to allocate its frames through @ref FrameAllocator
+     */
+    struct RecyclingFrame
+    {
+        static void* operator new(std::size_t size)
+        {
+            return FrameAllocator::allocate(size);
+        }
+
+        static void operator delete(void* pointer, std::size_t size) noexcept
+        {
+            FrameAllocator::deallocate(pointer, size);
+        }
+    };
+
+#ifdef SugarPPNamespace
+}
+#endif
@@ -0,0 +1,1109 @@
+/*****************************************************************//**
+ * \file   coroutine.hpp
+ * \brief  Kotlin's structured concurrency (runBlocking, launch, async) port
+ *
+ * \author Peter
+ * \date   October 2026
+ * \note Requires C++20 coroutine support
+ *********************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "allocator.hpp"
+#include "../channel/channel.hpp"
+#include "../thread/threadPool.hpp"
+
+#ifdef SugarPPNamespace
+namespace SugarPP
+{
+#endif
+
+    /**
+     * @brief Thrown at a suspension point of a cancelled job
+     */
+    struct CancellationError : std::runtime_error
+    {
+        CancellationError() :std::runtime_error{ "Job was cancelled" } {}
+    protected:
+        explicit CancellationError(char const* message) : std::runtime_error{ message } {}
+    };
+
+    /**
+     * @brief Thrown by @ref withTimeout when the time is up
+     */
+    struct TimeoutCancellationError : CancellationError
+    {
+        TimeoutCancellationError() : CancellationError{ "Timed out" } {}
+    };
+
+    template<typename T = void>
+    class Task;
+
+    namespace Coroutine_detail
+    {
+        class JobBase;
+
+        /**
+         * @brief The job whose coroutine is running on the calling thread
+         */
+        inline JobBase*& currentJob()
+        {
+            static thread_local JobBase* job = nullptr;
+            return job;
+        }
+
+        inline JobBase* requireJob()
+        {
+            if (auto job = currentJob())
+                return job;
+            throw std::logic_error{ "Suspending outside of a coroutine started by runBlocking, launch or async" };
+        }
+
+        /**
+         * @brief Wakes up a job suspended somewhere other than in a join, when it is cancelled
+         */
+        struct CancelHook
+        {
+            virtual ~CancelHook() = default;
+            virtual void cancel() = 0;
+        };
+
+        /**
+         * @brief A single thread running callbacks at their deadlines, used by @ref delay and @ref withTimeout
+         */
+        class Timer
+        {
+        public:
+            struct Entry
+            {
+                std::mutex m;
+                std::function<void()> callback;
+            };
+
+        private:
+            struct Pending
+            {
+                std::chrono::steady_clock::time_point deadline;
+                std::shared_ptr<Entry> entry;
+
+                bool operator>(Pending const& rhs) const { return deadline > rhs.deadline; }
+            };
+
+            std::mutex m;
+            std::condition_variable wake;
+            std::priority_queue<Pending, std::vector<Pending>, std::greater<>> pending;
+            bool stopping = false;
+            std::thread thread;
+
+            static void fire(Entry& entry)
+            {
+                std::function<void()> callback;
+                {
+                    std::lock_guard lock{ entry.m };
+                    callback = std::move(entry.callback);
+                }
+                if (callback)
+                    callback();
+            }
+
+            void run()
+            {
+                std::unique_lock lock{ m };
+                while (!stopping)
+                {
+                    if (pending.empty())
+                    {
+                        wake.wait(lock);
+                        continue;
+                    }
+                    if (auto const deadline = pending.top().deadline; std::chrono::steady_clock::now() < deadline)
+                    {
+                        wake.wait_until(lock, deadline);
+                        continue;
+                    }
+                    auto entry = pending.top().entry;
+                    pending.pop();
+                    lock.unlock();
+                    fire(*entry);
+                    lock.lock();
+                }
+            }
+
+            Timer() : thread{ [this] { run(); } } {}
+        public:
+            ~Timer()
+            {
+                {
+                    std::lock_guard lock{ m };
+                    stopping = true;
+                }
+                wake.notify_one();
+                thread.join();
+            }
+
+            static Timer& instance()
+            {
+                static Timer timer;
+                return timer;
+            }
+
+            std::shared_ptr<Entry> schedule(std::chrono::steady_clock::time_point deadline, std::function<void()> callback)
+            {
+                auto entry = std::make_shared<Entry>();
+                entry->callback = std::move(callback);
+                bool earliest;
+                {
+                    std::lock_guard lock{ m };
+                    earliest = pending.empty() || deadline < pending.top().deadline;
+                    pending.push({ deadline, entry });
+                }
+                if (earliest)
+                    wake.notify_one();
+                return entry;
+            }
+
+            /**
+             * @brief Drop the callback of an entry which has not fired yet, releasing whatever it captured
+             */
+            static void cancel(Entry& entry)
+            {
+                std::function<void()> callback;
+                std::lock_guard lock{ entry.m };
+                callback.swap(entry.callback);
+            }
+        };
+
+        /**
+         * @brief The state of a job shared by its coroutine, its parent and the @ref Job handles, which lives in the coroutine frame
+         * @details
+         * A job completes when its body has finished and all of its children have completed.
+         * It is reference counted: one reference is held while it is running, one by its parent and one by every handle.
+         * The frame is destroyed when the last reference is released.
+         */
+        class JobBase
+        {
+            struct Waiter
+            {
+                JobBase* job;
+                std::coroutine_handle<> handle;
+                std::promise<void>* blocking;
+            };
+
+            std::atomic<unsigned> refs{ 1 };
+            std::atomic<bool> cancelRequested{ false };
+            std::atomic<bool> completed{ false };
+            std::mutex m;
+            bool bodyDone = false;
+            bool failed = false;
+            std::size_t activeChildren = 0;
+            JobBase* parent = nullptr;
+            JobBase* firstChild = nullptr;
+            JobBase* previousSibling = nullptr;
+            JobBase* nextSibling = nullptr;
+            std::vector<Waiter> waiters;
+            std::shared_ptr<CancelHook> cancelHook;
+            std::coroutine_handle<> suspended;
+            ThreadPool* pool = &ThreadPool::shared();
+
+            static bool isCancellation(std::exception_ptr const& error)
+            {
+                try
+                {
+                    std::rethrow_exception(error);
+                }
+                catch (CancellationError const&)
+                {
+                    return true;
+                }
+                catch (...)
+                {
+                    return false;
+                }
+            }
+
+            static void resume(void* context)
+            {
+                auto const job = static_cast<JobBase*>(context);
+                auto& current = currentJob();
+                auto const previous = std::exchange(current, job);
+                job->suspended.resume();
+                current = previous;
+            }
+
+            void unlink(JobBase* child) noexcept
+            {
+                if (child->previousSibling)
+                    child->previousSibling->nextSibling = child->nextSibling;
+                else
+                    firstChild = child->nextSibling;
+                if (child->nextSibling)
+                    child->nextSibling->previousSibling = child->previousSibling;
+            }
+
+            void complete() noexcept
+            {
+                std::vector<Waiter> ready;
+                {
+                    std::lock_guard lock{ m };
+                    completed.store(true, std::memory_order_release);
+                    ready.swap(waiters);
+                }
+                for (auto const& waiter : ready)
+                {
+                    if (waiter.blocking)
+                        waiter.blocking->set_value();
+                    else
+                        waiter.job->schedule(waiter.handle);
+                }
+                if (parent)
+                    parent->childCompleted(this);
+                release();
+            }
+
+            void childCompleted(JobBase* child) noexcept
+            {
+                bool failedNow = false;
+                bool completeNow;
+                {
+                    std::lock_guard lock{ m };
+                    unlink(child);
+                    --activeChildren;
+                    //a failed child fails its parent, but a cancelled child does not
+                    if (child->failed && !failed)
+                    {
+                        exception = child->exception;
+                        failed = failedNow = true;
+                    }
+                    completeNow = bodyDone && activeChildren == 0;
+                }
+                child->release();
+                if (failedNow)
+                    cancel();
+                if (completeNow)
+                    complete();
+            }
+
+        protected:
+            std::exception_ptr exception;
+
+            virtual void destroyFrame() noexcept = 0;
+
+            void bodyFinished(std::exception_ptr error) noexcept
+            {
+                bool failedNow = false;
+                bool completeNow;
+                {
+                    std::lock_guard lock{ m };
+                    bodyDone = true;
+                    cancelHook.reset();
+                    if (error)
+                    {
+                        if (!isCancellation(error))
+                        {
+                            if (!failed)
+                            {
+                                exception = std::move(error);
+                                failed = failedNow = true;
+                            }
+                        }
+                        else if (!exception)
+                            exception = std::move(error);
+                    }
+                    completeNow = activeChildren == 0;
+                }
+                if (failedNow)
+                    cancel();
+                if (completeNow)
+                    complete();
+            }
+
+        public:
+            JobBase() = default;
+            JobBase(JobBase const&) = delete;
+            JobBase& operator=(JobBase const&) = delete;
+
+            void addRef() noexcept { refs.fetch_add(1, std::memory_order_relaxed); }
+
+            void release() noexcept
+            {
+                if (refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                    destroyFrame();
+            }
+
+            [[nodiscard]] bool isCancelled() const { return cancelRequested.load(); }
+            [[nodiscard]] bool isCompleted() const { return completed.load(std::memory_order_acquire); }
+
+            void throwIfCancelled() const
+            {
+                if (isCancelled())
+                    throw CancellationError{};
+            }
+
+            /**
+             * @brief Resume `handle`, a coroutine suspended in this job, on the pool
+             */
+            void schedule(std::coroutine_handle<> handle)
+            {
+                suspended = handle;
+                pool->post(&JobBase::resume, this);
+            }
+
+            void setCancelHook(std::shared_ptr<CancelHook> hook)
+            {
+                std::lock_guard lock{ m };
+                cancelHook = std::move(hook);
+            }
+
+            /**
+             * @brief Make `child` a child of this job, so this job waits for it and cancellation propagates to it
+             */
+            void attach(JobBase* child)
+            {
+                child->parent = this;
+                child->addRef();
+                {
+                    std::lock_guard lock{ m };
+                    child->nextSibling = firstChild;
+                    if (firstChild)
+                        firstChild->previousSibling = child;
+                    firstChild = child;
+                    ++activeChildren;
+                }
+                if (isCancelled())
+                    child->cancel();
+            }
+
+            /**
+             * @brief Resume `handle` of `job` or fulfill `blocking` when this job completes
+             * @return false if the job has already completed
+             */
+            bool addWaiter(JobBase* job, std::coroutine_handle<> handle, std::promise<void>* blocking = nullptr)
+            {
+                std::lock_guard lock{ m };
+                if (isCompleted())
+                    return false;
+                waiters.push_back({ job, handle, blocking });
+                return true;
+            }
+
+            void cancel()
+            {
+                if (isCompleted() || cancelRequested.exchange(true))
+                    return;
+                std::vector<JobBase*> children;
+                std::shared_ptr<CancelHook> hook;
+                {
+                    std::lock_guard lock{ m };
+                    hook = cancelHook;
+                    for (auto child = firstChild; child; child = child->nextSibling)
+                    {
+                        child->addRef();
+                        children.push_back(child);
+                    }
+                }
+                for (auto child : children)
+                {
+                    child->cancel();
+                    child->release();
+                }
+                if (hook)
+                    hook->cancel();
+            }
+
+            virtual ~JobBase() = default;
+        };
+
+        template<typename T>
+        struct JobResult
+        {
+            std::optional<T> result;
+
+            template<typename U>
+            void return_value(U&& value)
+            {
+                result.emplace(std::forward<U>(value));
+            }
+        };
+
+        template<>
+        struct JobResult<void>
+        {
+            void return_void() noexcept {}
+        };
+
+        template<typename T>
+        struct JobPromise;
+
+        template<typename T>
+        struct JobCoroutine
+        {
+            using promise_type = JobPromise<T>;
+            std::coroutine_handle<promise_type> handle;
+        };
+
+        /**
+         * @brief The promise of the outer coroutine of a job, which owns the user's function and awaits it
+         */
+        template<typename T>
+        struct JobPromise : JobBase, JobResult<T>, RecyclingFrame
+        {
+            std::exception_ptr bodyError;
+
+            JobCoroutine<T> get_return_object() noexcept
+            {
+                return { std::coroutine_handle<JobPromise>::from_promise(*this) };
+            }
+
+            /**
+             * @brief A job cancelled before it starts does not run its body at all
+             */
+            auto initial_suspend() noexcept
+            {
+                struct Start
+                {
+                    JobPromise& promise;
+                    bool await_ready() const noexcept { return false; }
+                    void await_suspend(std::coroutine_handle<>) const noexcept {}
+                    void await_resume() const { promise.throwIfCancelled(); }
+                };
+                return Start{ *this };
+            }
+
+            auto final_suspend() noexcept
+            {
+                struct Finish
+                {
+                    bool await_ready() const noexcept { return false; }
+                    void await_suspend(std::coroutine_handle<JobPromise> handle) const noexcept
+                    {
+                        auto& promise = handle.promise();
+                        promise.bodyFinished(std::move(promise.bodyError));
+                    }
+                    void await_resume() const noexcept {}
+                };
+                return Finish{};
+            }
+
+            void unhandled_exception() noexcept { bodyError = std::current_exception(); }
+
+            void destroyFrame() noexcept override
+            {
+                std::coroutine_handle<JobPromise>::from_promise(*this).destroy();
+            }
+
+            /**
+             * @brief Return the result of a completed job, or rethrow its exception
+             */
+            T get()
+            {
+                if (exception)
+                    std::rethrow_exception(exception);
+                if constexpr (!std::is_void_v<T>)
+                    return *this->result;
+            }
+        };
+
+        template<typename R>
+        struct TaskValue
+        {
+            using type = R;
+            static constexpr bool isTask = false;
+        };
+
+        template<typename T>
+        struct TaskValue<Task<T>>
+        {
+            using type = T;
+            static constexpr bool isTask = true;
+        };
+
+        /**
+         * @brief The result type of a job running `Func`, which is either a plain function or a function returning a @ref Task
+         */
+        template<typename Func>
+        using JobValue = typename TaskValue<std::invoke_result_t<Func&>>::type;
+
+        template<typename T, typename Func>
+        JobCoroutine<T> jobBody(Func func)
+        {
+            if constexpr (TaskValue<std::invoke_result_t<Func&>>::isTask)
+            {
+                if constexpr (std::is_void_v<T>)
+                    co_await func();
+                else
+                    co_return co_await func();
+            }
+            else
+            {
+                if constexpr (std::is_void_v<T>)
+                {
+                    func();
+                    co_return;
+                }
+                else
+                    co_return func();
+            }
+        }
+
+        /**
+         * @brief Create a job as a child of the current job, and schedule it on the shared pool
+         * @return The job with a reference added for the returned handle
+         */
+        template<typename Func>
+        JobPromise<JobValue<std::decay_t<Func>>>* startJob(Func&& func)
+        {
+            using T = JobValue<std::decay_t<Func>>;
+            auto const handle = jobBody<T>(std::decay_t<Func>(std::forward<Func>(func))).handle;
+            auto& promise = handle.promise();
+            promise.addRef();
+            if (auto parent = currentJob())
+                parent->attach(&promise);
+            promise.schedule(handle);
+            return &promise;
+        }
+
+        class JoinAwaiter
+        {
+        protected:
+            JobBase* job;
+        public:
+            explicit JoinAwaiter(JobBase* job) : job(job) {}
+
+            bool await_ready() const noexcept { return job->isCompleted(); }
+
+            bool await_suspend(std::coroutine_handle<> handle) const
+            {
+                return job->addWaiter(requireJob(), handle);
+            }
+
+            void await_resume() const { requireJob()->throwIfCancelled(); }
+        };
+
+        template<typename T>
+        class AwaitAwaiter : JoinAwaiter
+        {
+        public:
+            using JoinAwaiter::JoinAwaiter;
+            using JoinAwaiter::await_ready;
+            using JoinAwaiter::await_suspend;
+
+            T await_resume() const
+            {
+                JoinAwaiter::await_resume();
+                return static_cast<JobPromise<T>*>(job)->get();
+            }
+        };
+
+        class DelayAwaiter
+        {
+            struct Sleep : CancelHook
+            {
+                JobBase* job;
+                std::coroutine_handle<> handle;
+                std::atomic<bool> fired{ false };
+
+                Sleep(JobBase* job, std::coroutine_handle<> handle) : job(job), handle(handle) {}
+
+                void cancel() override { fire(); }
+
+                /**
+                 * @brief Called by both the timer and the cancellation, whichever comes first resumes the coroutine
+                 */
+                void fire()
+                {
+                    if (!fired.exchange(true))
+                        job->schedule(handle);
+                }
+            };
+
+            std::chrono::steady_clock::duration duration;
+        public:
+            explicit DelayAwaiter(std::chrono::steady_clock::duration duration) : duration(duration) {}
+
+            bool await_ready() const noexcept { return duration <= std::chrono::steady_clock::duration::zero(); }
+
+            void await_suspend(std::coroutine_handle<> handle) const
+            {
+                auto const job = requireJob();
+                auto const deadline = std::chrono::steady_clock::now() + duration;
+                auto sleep = std::make_shared<Sleep>(job, handle);
+                job->setCancelHook(sleep);
+                //the coroutine may be resumed on another thread as soon as it is handed over, so nothing touches the frame afterwards
+                if (job->isCancelled())
+                    sleep->fire();
+                else
+                    Timer::instance().schedule(deadline, [sleep] { sleep->fire(); });
+            }
+
+            void await_resume() const
+            {
+                auto const job = requireJob();
+                job->setCancelHook(nullptr);
+                job->throwIfCancelled();
+            }
+        };
+
+        struct YieldAwaiter
+        {
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(std::coroutine_handle<> handle) const { requireJob()->schedule(handle); }
+            void await_resume() const { requireJob()->throwIfCancelled(); }
+        };
+
+        template<typename T>
+        struct TaskResult
+        {
+            std::optional<T> value;
+
+            template<typename U>
+            void return_value(U&& result)
+            {
+                value.emplace(std::forward<U>(result));
+            }
+
+            T take() { return std::move(*value); }
+        };
+
+        template<>
+        struct TaskResult<void>
+        {
+            void return_void() noexcept {}
+            void take() noexcept {}
+        };
+
+        /**
+         * @brief Cancels a timer entry when it goes out of scope
+         */
+        struct TimerGuard
+        {
+            std::shared_ptr<Timer::Entry> entry;
+            ~TimerGuard() { Timer::cancel(*entry); }
+        };
+    }
+
+    /**
+     * @brief A suspending function: a lazily started coroutine which runs in the job that awaits it
+     * @details
+     * It is the return type of the coroutines given to @ref launch, @ref async and @ref runBlocking, and of any function
+     * which needs to suspend, like Kotlin's `suspend fun`.
+     * ~~~~{.cpp}
+     *     Task<int> fetch(int id)
+     *     {
+     *         co_await delay(10ms);
+     *         co_return id * 2;
+     *     }
+     * ~~~~
+     * Awaiting a task resumes it directly on the awaiting thread, and it resumes the awaiting coroutine directly when it finishes.
+     * A task can only be awaited once.
+     * @tparam T The result type, which must not be a reference
+     */
+    template<typename T>
+    class Task
+    {
+    public:
+        struct promise_type : Coroutine_detail::TaskResult<T>, RecyclingFrame
+        {
+            std::coroutine_handle<> continuation;
+            std::exception_ptr exception;
+
+            Task get_return_object() noexcept
+            {
+                return Task{ std::coroutine_handle<promise_type>::from_promise(*this) };
+            }
+
+            std::suspend_always initial_suspend() const noexcept { return {}; }
+
+            auto final_suspend() const noexcept
+            {
+                struct Finish
+                {
+                    bool await_ready() const noexcept { return false; }
+                    std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> handle) const noexcept
+                    {
+                        return handle.promise().continuation;
+                    }
+                    void await_resume() const noexcept {}
+                };
+                return Finish{};
+            }
+
+            void unhandled_exception() noexcept { exception = std::current_exception(); }
+        };
+
+    private:
+        std::coroutine_handle<promise_type> handle;
+
+        explicit Task(std::coroutine_handle<promise_type> handle) : handle(handle) {}
+
+        struct Awaiter
+        {
+            std::coroutine_handle<promise_type> handle;
+
+            bool await_ready() const noexcept { return false; }
+
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> caller) const noexcept
+            {
+                handle.promise().continuation = caller;
+                return handle;
+            }
+
+            T await_resume() const
+            {
+                auto& promise = handle.promise();
+                if (promise.exception)
+                    std::rethrow_exception(promise.exception);
+                return promise.take();
+            }
+        };
+    public:
+        Task(Task&& other) noexcept : handle(std::exchange(other.handle, {})) {}
+
+        Task& operator=(Task&& other) noexcept
+        {
+            if (this != &other)
+            {
+                if (handle)
+                    handle.destroy();
+                handle = std::exchange(other.handle, {});
+            }
+            return *this;
+        }
+
+        ~Task()
+        {
+            if (handle)
+                handle.destroy();
+        }
+
+        Awaiter operator co_await() const& noexcept { return { handle }; }
+        Awaiter operator co_await() const&& noexcept { return { handle }; }
+    };
+
+    /**
+     * @brief A handle to a coroutine started by @ref launch
+     * @details The job keeps running when the handle is destroyed. Copies refer to the same job.
+     */
+    class Job
+    {
+    protected:
+        Coroutine_detail::JobBase* job;
+
+        template<typename Func>
+        friend auto runBlocking(Func&& func);
+    public:
+        /**
+         * @brief Take over a reference to `job`
+         */
+        explicit Job(Coroutine_detail::JobBase* job) : job(job) {}
+
+        Job(Job const& other) noexcept : job(other.job) { job->addRef(); }
+        Job(Job&& other) noexcept : job(std::exchange(other.job, nullptr)) {}
+
+        Job& operator=(Job other) noexcept
+        {
+            std::swap(job, other.job);
+            return *this;
+        }
+
+        ~Job()
+        {
+            if (job)
+                job->release();
+        }
+
+        /**
+         * @brief Request cancellation of the job and all its children
+         * @details Cancellation is cooperative: the job throws @ref CancellationError at its next suspension point,
+         * or it can check @ref isActive() by itself.
+         */
+        void cancel() { job->cancel(); }
+
+        /**
+         * @brief The job has neither completed nor been cancelled
+         */
+        [[nodiscard]] bool isActive() const { return !job->isCompleted() && !job->isCancelled(); }
+
+        /**
+         * @brief The job and all its children have finished, for whatever reason
+         */
+        [[nodiscard]] bool isCompleted() const { return job->isCompleted(); }
+
+        [[nodiscard]] bool isCancelled() const { return job->isCancelled(); }
+
+        /**
+         * @brief `co_await job.join()` suspends until the job completes
+         */
+        [[nodiscard]] Coroutine_detail::JoinAwaiter join() const { return Coroutine_detail::JoinAwaiter{ job }; }
+    };
+
+    /**
+     * @brief A handle to a coroutine started by @ref async, which can be awaited for its result
+     * @details `co_await deferred` suspends until the job completes, then returns a copy of its result or rethrows its exception.
+     */
+    template<typename T>
+    class Deferred : public Job
+    {
+    public:
+        using Job::Job;
+
+        Coroutine_detail::AwaitAwaiter<T> operator co_await() const { return Coroutine_detail::AwaitAwaiter<T>{ job }; }
+
+        /**
+         * @brief Return the result of a completed job without suspending
+         * @throw std::logic_error If the job has not completed
+         */
+        T getCompleted() const
+        {
+            if (!isCompleted())
+                throw std::logic_error{ "Deferred has not completed" };
+            return static_cast<Coroutine_detail::JobPromise<T>*>(job)->get();
+        }
+    };
+
+    /**
+     * @brief Start a new coroutine without blocking the calling thread, as a child of the job running on the calling thread
+     * @param func A function returning @ref Task, or a plain function
+     * @details
+     * Coroutines run on `ThreadPool::shared()`, the pool used by @ref parallel. A job is a coroutine frame of a few hundred bytes,
+     * recycled through @ref FrameAllocator, so there can be hundreds of thousands of them.
+     *
+     * A parent only completes after all its children. An exception other than @ref CancellationError escaping a child
+     * cancels its parent and all the siblings, and becomes the exception of the parent.
+     */
+    template<typename Func>
+    Job launch(Func&& func)
+    {
+        return Job{ Coroutine_detail::startJob(std::forward<Func>(func)) };
+    }
+
+    /**
+     * @brief Start a new coroutine like @ref launch, whose result can be awaited
+     */
+    template<typename Func>
+    auto async(Func&& func)
+    {
+        return Deferred<Coroutine_detail::JobValue<std::decay_t<Func>>>{ Coroutine_detail::startJob(std::forward<Func>(func)) };
+    }
+
+    /**
+     * @brief Run a coroutine and block the calling thread until it and all its children complete
+     * @return The result of `func`, or rethrow its exception
+     * @details This is the bridge between normal blocking code and coroutines, usually used in `main()`.
+     * Called from a worker of the shared pool, the worker runs other tasks while it waits.
+     */
+    template<typename Func>
+    auto runBlocking(Func&& func)
+    {
+        auto& current = Coroutine_detail::currentJob();
+        auto const previous = std::exchange(current, nullptr);
+        auto deferred = async(std::forward<Func>(func));
+        current = previous;
+
+        std::promise<void> done;
+        auto const job = deferred.job;
+        if (job->addWaiter(nullptr, {}, &done))
+        {
+            if (auto pool = ThreadPool::current())
+                pool->helpUntil([job] { return job->isCompleted(); });
+            done.get_future().wait();
+        }
+        return deferred.getCompleted();
+    }
+
+    /**
+     * @brief `co_await delay(duration)` suspends the coroutine, not the thread, for `duration`
+     * @details A cancelled coroutine is resumed immediately with @ref CancellationError.
+     */
+    template<typename Rep, typename Period>
+    Coroutine_detail::DelayAwaiter delay(std::chrono::duration<Rep, Period> duration)
+    {
+        return Coroutine_detail::DelayAwaiter{ std::chrono::duration_cast<std::chrono::steady_clock::duration>(duration) };
+    }
+
+    /**
+     * @brief `co_await yield()` lets other coroutines run, and throws @ref CancellationError if the job is cancelled
+     */
+    inline Coroutine_detail::YieldAwaiter yield()
+    {
+        return {};
+    }
+
+    /**
+     * @brief Return false if the job running on the calling thread is cancelled, for long computations without suspension points
+     */
+    inline bool isActive()
+    {
+        auto const job = Coroutine_detail::currentJob();
+        return job && !job->isCancelled();
+    }
+
+    /**
+     * @brief Throw @ref CancellationError if the job running on the calling thread is cancelled
+     */
+    inline void ensureActive()
+    {
+        Coroutine_detail::requireJob()->throwIfCancelled();
+    }
+
+    /**
+     * @brief Run `func` as a child job, and cancel it if it does not complete within `timeout`
+     * @return A task to be awaited for the result of `func`, which throws @ref TimeoutCancellationError on timeout
+     */
+    template<typename Rep, typename Period, typename Func>
+    Task<Coroutine_detail::JobValue<Func>> withTimeout(std::chrono::duration<Rep, Period> timeout, Func func)
+    {
+        using namespace Coroutine_detail;
+        auto child = async(std::move(func));
+        auto timedOut = std::make_shared<std::atomic<bool>>(false);
+        TimerGuard const guard{ Timer::instance().schedule(
+            std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(timeout),
+            [child, timedOut]() mutable
+            {
+                timedOut->store(true);
+                child.cancel();
+            }) };
+        try
+        {
+            if constexpr (std::is_void_v<JobValue<Func>>)
+                co_await child;
+            else
+                co_return co_await child;
+        }
+        catch (CancellationError const&)
+        {
+            if (timedOut->load() && !currentJob()->isCancelled())
+                throw TimeoutCancellationError{};
+            throw;
+        }
+    }
+
+    namespace Coroutine_detail
+    {
+        /**
+         * @brief Suspends a coroutine until a channel may have room or a value for it, is closed, or the job is cancelled
+         * @details The coroutine is registered as a @ref ChannelWaiter, so it is resumed by the other side of the channel instead of polling.
+         */
+        template<typename T, ChannelType Type>
+        class ChannelAwaiter
+        {
+            struct Suspended : CancelHook, ChannelWaiter
+            {
+                JobBase* job;
+                std::coroutine_handle<> handle;
+                std::atomic<bool> fired{ false };
+                bool byChannel = false;
+
+                Suspended(JobBase* job, std::coroutine_handle<> handle) : job(job), handle(handle) {}
+
+                /**
+                 * @brief Called by both the channel and the cancellation, whichever comes first resumes the coroutine
+                 */
+                bool wake() override
+                {
+                    if (fired.exchange(true))
+                        return false;
+                    byChannel = true;
+                    job->schedule(handle);
+                    return true;
+                }
+
+                void cancel() override
+                {
+                    if (!fired.exchange(true))
+                        job->schedule(handle);
+                }
+            };
+
+            Channel<T, Type>& channel;
+            ChannelWaiter::Side side;
+            std::shared_ptr<Suspended> suspended;
+        public:
+            ChannelAwaiter(Channel<T, Type>& channel, ChannelWaiter::Side side) : channel(channel), side(side) {}
+
+            bool await_ready() const noexcept { return false; }
+
+            bool await_suspend(std::coroutine_handle<> handle)
+            {
+                auto const job = requireJob();
+                auto const current = suspended = std::make_shared<Suspended>(job, handle);
+                job->setCancelHook(current);
+                //the coroutine may be resumed on another thread as soon as it is handed over, so nothing touches the frame afterwards
+                if (job->isCancelled())
+                {
+                    current->cancel();
+                    return true;
+                }
+                if (channel.addWaiter(current, side))
+                    return true;
+                //no need to wait, unless a cancellation has already scheduled the coroutine
+                return current->fired.exchange(true);
+            }
+
+            void await_resume() const
+            {
+                auto const job = requireJob();
+                job->setCancelHook(nullptr);
+                if (job->isCancelled())
+                {
+                    //do not swallow the wake-up, somebody else may be waiting for the same value or room
+                    if (suspended->byChannel)
+                        channel.wakeWaiter(side);
+                    throw CancellationError{};
+                }
+            }
+        };
+    }
+
+    /**
+     * @brief Send a value to a @ref Channel, suspending the coroutine instead of blocking the thread while the channel is full
+     * @details The coroutine is resumed by a receiver making room, or by closing the channel, so a suspended sender costs nothing.
+     * @throw ChannelClosedError If the channel is closed
+     */
+    template<typename T, ChannelType Type, typename U>
+    Task<> send(Channel<T, Type>& channel, U value)
+    {
+        while (!channel.trySend(std::move(value)))
+        {
+            if (channel.isClosedForSend())
+                throw ChannelClosedError{};
+            co_await Coroutine_detail::ChannelAwaiter<T, Type>{ channel, ChannelWaiter::Side::Send };
+        }
+    }
+
+    /**
+     * @brief Receive a value from a @ref Channel, suspending the coroutine instead of blocking the thread while the channel is empty
+     * @details The coroutine is resumed by a sender, or by closing the channel, so a suspended receiver costs nothing.
+     * @return An empty optional if the channel is closed and drained
+     */
+    template<typename T, ChannelType Type>
+    Task<std::optional<T>> receive(Channel<T, Type>& channel)
+    {
+        while (true)
+        {
+            if (auto value = channel.tryReceive())
+                co_return value;
+            if (channel.isClosedForReceive())
+                co_return std::nullopt;
+            co_await Coroutine_detail::ChannelAwaiter<T, Type>{ channel, ChannelWaiter::Side::Receive };
+        }
+    }
+
+#ifdef SugarPPNamespace
+}
+#endif
@@ -0,0 +1,242 @@
+/*****************************************************************//**
+ * \file   generator.hpp
+ * \brief  Python's generator (yield) port
+ *
+ * \author Peter
+ * \date   October 2026
+ * \note Requires C++20 coroutine support
+ *********************************************************************/
+
+#pragma once
+
+#include <coroutine>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include "allocator.hpp"
+
+#ifdef SugarPPNamespace
+namespace SugarPP
+{
+#endif
+
+    /**
+     * @brief A lazily evaluated sequence produced by a coroutine with `co_yield`, which can be used in a range-based for loop
+     * @details
+     * A typical usage is
+     * ~~~~{.cpp}
+     *     Generator<int> fibonacci()
+     *     {
+     *         int a = 0, b = 1;
+     *         while (true)
+     *         {
+     *             co_yield a;
+     *             a = std::exchange(b, a + b);
+     *         }
+     *     }
+     *
+     *     for (auto i : fibonacci())
+     *         ...
+     * ~~~~
+     * Values are yielded by reference: the iterator points directly at the object given to `co_yield`,
+     * which stays alive until the generator is resumed, so producing an item never copies it.
+     * Coroutine frames are allocated through @ref FrameAllocator.
+     *
+     * Since `begin()` and `end()` return the same iterator type, a Generator composes with @ref Enumerate and @ref Zip.
+     * @tparam T The yielded type. `Generator<T const&>` yields read-only references, `Generator<T>` yields mutable references.
+     */
+    template<typename T>
+    class Generator
+    {
+    public:
+        using value_type = std::remove_cv_t<std::remove_reference_t<T>>;
+        using reference = std::conditional_t<std::is_reference_v<T>, T, T&>;
+        using pointer = std::add_pointer_t<reference>;
+
+        struct promise_type : RecyclingFrame
+        {
+            pointer value = nullptr;
+            std::exception_ptr exception;
+
+            Generator get_return_object() noexcept
+            {
+                return Generator{ std::coroutine_handle<promise_type>::from_promise(*this) };
+            }
+
+            std::suspend_always initial_suspend() const noexcept { return {}; }
+            std::suspend_always final_suspend() const noexcept { return {}; }
+
+            std::suspend_always yield_value(std::remove_reference_t<reference>& element) noexcept
+            {
+                value = std::addressof(element);
+                return {};
+            }
+
+            /**
+             * @brief A temporary in a `co_yield` expression lives until the generator is resumed, so it is safe to refer to it
+             */
+            std::suspend_always yield_value(std::remove_reference_t<reference>&& element) noexcept
+            {
+                value = std::addressof(element);
+                return {};
+            }
+
+            void return_void() const noexcept {}
+
+            void unhandled_exception() noexcept
+            {
+                exception = std::current_exception();
+            }
+
+            /**
+             * @brief A generator can only yield, not wait for anything
+             */
+            template<typename U>
+            std::suspend_never await_transform(U&&) = delete;
+        };
+
+        /**
+         * @brief The iterator of a Generator, default constructed one is the end iterator
+         */
+        class iterator
+        {
+            std::coroutine_handle<promise_type> handle;
+        public:
+            using iterator_category = std::input_iterator_tag;
+            using difference_type = std::ptrdiff_t;
+            using value_type = Generator::value_type;
+            using reference = Generator::reference;
+            using pointer = Generator::pointer;
+
+            iterator() = default;
+            explicit iterator(std::coroutine_handle<promise_type> handle) : handle(handle) {}
+
+            /**
+             * @brief Return whether the generator has finished
+             */
+            [[nodiscard]] bool done() const noexcept
+            {
+                return !handle || handle.done();
+            }
+
+            /**
+             * @brief Resume the generator to produce the next value, rethrow if the generator throws
+             */
+            iterator& operator++()
+            {
+                handle.resume();
+                if (handle.done() && handle.promise().exception)
+                    std::rethrow_exception(std::exchange(handle.promise().exception, nullptr));
+                return *this;
+            }
+
+            void operator++(int)
+            {
+                ++*this;
+            }
+
+            reference operator*() const noexcept
+            {
+                return static_cast<reference>(*handle.promise().value);
+            }
+
+            pointer operator->() const noexcept
+            {
+                return handle.promise().value;
+            }
+
+            bool operator==(iterator const& rhs) const noexcept
+            {
+                return done() == rhs.done();
+            }
+
+            bool operator!=(iterator const& rhs) const noexcept
+            {
+                return !(*this == rhs);
+            }
+        };
+
+        Generator(Generator const&) = delete;
+        Generator& operator=(Generator const&) = delete;
+
+        Generator(Generator&& rhs) noexcept : handle(std::exchange(rhs.handle, nullptr)) {}
+
+        Generator& operator=(Generator&& rhs) noexcept
+        {
+            if (this != &rhs)
+            {
+                if (handle)
+                    handle.destroy();
+                handle = std::exchange(rhs.handle, nullptr);
+            }
+            return *this;
+        }
+
+        ~Generator()
+        {
+            if (handle)
+                handle.destroy();
+        }
+
+        /**
+         * @brief Run the generator until its first `co_yield` and return an iterator to that value
+         * @note A Generator can only be iterated once
+         */
+        iterator begin()
+        {
+            iterator first{ handle };
+            if (!first.done())
+                ++first;
+            return first;
+        }
+
+        /**
+         * @brief Return the end iterator
+         */
+        iterator end() const noexcept
+        {
+            return {};
+        }
+
+    private:
+        std::coroutine_handle<promise_type> handle;
+
+        explicit Generator(std::coroutine_handle<promise_type> handle) noexcept : handle(handle) {}
+    };
+
+    namespace Generator_detail
+    {
+        template<typename Iterable>
+        using yielded_t = decltype(*std::begin(std::declval<std::remove_reference_t<Iterable>&>()));
+
+        /**
+         * @brief `Iterable` is an lvalue reference for lvalue arguments, so they are not copied into the coroutine frame,
+         * while rvalue arguments are moved into the frame so they live as long as the generator
+         */
+        template<typename Iterable>
+        Generator<yielded_t<Iterable>> asGeneratorImpl(Iterable iterable)
+        {
+            for (auto&& element : iterable)
+                co_yield element;
+        }
+    }
+
+    /**
+     * @brief Expose anything that can be used in a range-based for loop, eg. @ref MultiRange or @ref FileIterator, as a Generator
+     * @param iterable Lvalues are referred to and must outlive the generator, rvalues are moved into the generator
+     * @details
+     * ~~~~{.cpp}
+     *     Generator<std::string const&> lines = asGenerator(FileIterator{ "log.txt" });
+     * ~~~~
+     */
+    template<typename Iterable>
+    auto asGenerator(Iterable&& iterable)
+    {
+        return Generator_detail::asGeneratorImpl<Iterable>(std::forward<Iterable>(iterable));
+    }
+
+#ifdef SugarPPNamespace
+}
+#endif
@@ -0,0 +1,742 @@
+/*****************************************************************//**
+ * \file   binaryLog.hpp
+ * \brief  A binary log which defers formatting, with the decoder of its files
+ *
+ * \author Peter
+ * \date   October 2026
+ * \note The files are decoded into text by the sugarpp-logdecode tool, built with the SugarPPBuildTools option of CMakeLists.txt,
+ * or by @ref decodeBinaryLog
+ *********************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iomanip>
+#include <istream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <queue>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "file.hpp"
+#include "log.hpp"
+
+#ifdef SugarPPNamespace
+namespace SugarPP
+{
+#endif
+
+    namespace BinaryLog_detail
+    {
+        /*
+         * A file starts with the 8 bytes of `magic`, then the time it was opened on the steady clock and on the system clock,
+         * in nanoseconds. Then come entries starting with a Kind byte:
+         * - Site: u32 id, u8 level, u32 line, u32 length and the file name, u32 length and the format
+         * - Record: u32 site id, u64 steady clock time, u8 argument count, then for each argument a Tag byte and its value,
+         *   which is 8 bytes for numbers, 1 byte for bool and char, and a u32 length and the characters for strings
+         * Numbers are in the byte order of the machine writing the file.
+         */
+        constexpr char magic[8]{ 'S', 'P', 'P', 'L', 'O', 'G', '1', '\n' };
+
+        enum Kind : std::uint8_t { SiteKind = 1, RecordKind = 2 };
+        constexpr std::uint64_t RecordHeaderSize = 1 + 4 + 8 + 1;     //kind, site id, time and argument count
+        enum Tag : std::uint8_t { SignedTag, UnsignedTag, FloatingTag, BoolTag, CharTag, StringTag };
+
+        struct SiteInfo
+        {
+            Level level;
+            char const* format;
+            char const* file;
+            unsigned line;
+        };
+
+        /**
+         * @brief Every @ref LogSite of the program, which the writer thread saves in the files before their records
+         */
+        struct Registry
+        {
+            std::mutex mutex;
+            std::vector<SiteInfo> sites;
+
+            static Registry& get()
+            {
+                static Registry registry;
+                return registry;
+            }
+
+            std::uint32_t add(SiteInfo site)
+            {
+                std::lock_guard lock{ mutex };
+                sites.push_back(site);
+                return static_cast<std::uint32_t>(sites.size() - 1);
+            }
+        };
+
+        inline std::uint64_t steadyNow()
+        {
+            return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+        }
+
+        /**
+         * @brief A single producer, single consumer ring of bytes, where a thread writes its records for the writer thread
+         * @details The positions only grow, and are masked when accessing the buffer. The producer publishes `head` only after a whole record.
+         */
+        class Ring
+        {
+            std::unique_ptr<char[]> data;
+            std::uint64_t capacity;
+            alignas(64) std::atomic<std::uint64_t> head{ 0 };
+            alignas(64) std::atomic<std::uint64_t> tail{ 0 };
+            alignas(64) std::uint64_t cachedTail = 0;      //only used by the producer, to avoid reading `tail` for every record
+            std::atomic<bool> busy{ false };                //the producer took the time of a record which is not published yet
+        public:
+            std::uint64_t const generation;
+            std::atomic<bool> retired{ false };
+
+            /*only used by the writer thread, see BinaryLog::run*/
+            static constexpr std::uint64_t NotBusy = ~std::uint64_t{ 0 };
+            std::uint64_t busyHead = NotBusy;               //`head` when the writer saw the ring busy
+            std::uint64_t busyBound = 0;                    //a time before the record being written
+
+            Ring(std::uint64_t capacity, std::uint64_t generation) :data(new char[capacity]), capacity(capacity), generation(generation) {}
+
+            [[nodiscard]] std::uint64_t size() const { return capacity; }
+
+            /**
+             * @brief Return the position to write `size` bytes at, waiting until the writer thread made room while `open` is true
+             * @param open Must turn false once the writer thread stops draining this ring, or the wait never ends
+             */
+            template<typename Open>
+            bool reserve(std::uint64_t size, std::uint64_t& position, Open const& open)
+            {
+                position = head.load(std::memory_order_relaxed);
+                while (position + size - cachedTail > capacity)
+                {
+                    cachedTail = tail.load(std::memory_order_acquire);
+                    if (position + size - cachedTail <= capacity)
+                        break;
+                    if (!open())
+                        return false;
+                    std::this_thread::yield();
+                }
+                return true;
+            }
+
+            void put(std::uint64_t position, void const* source, std::uint64_t size)
+            {
+                auto const offset = position % capacity;
+                auto const first = std::min(size, capacity - offset);
+                std::memcpy(data.get() + offset, source, static_cast<size_t>(first));
+                std::memcpy(data.get(), static_cast<char const*>(source) + first, static_cast<size_t>(size - first));
+            }
+
+            /**
+             * @brief Mark the ring busy before taking the time of a record, so that the writer thread holds back the records after that time
+             */
+            void beginRecord()
+            {
+                busy.store(true, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+            }
+
+            /**
+             * @brief Publish the record ending at `newHead`, and mark the ring not busy
+             */
+            void publish(std::uint64_t newHead)
+            {
+                head.store(newHead, std::memory_order_release);
+                busy.store(false, std::memory_order_release);
+            }
+
+            [[nodiscard]] bool isBusy() const { return busy.load(std::memory_order_seq_cst); }
+
+            [[nodiscard]] std::uint64_t published() const { return head.load(std::memory_order_acquire); }
+
+            [[nodiscard]] bool empty() const { return tail.load(std::memory_order_relaxed) == head.load(std::memory_order_acquire); }
+
+            [[nodiscard]] std::uint64_t released() const { return tail.load(std::memory_order_relaxed); }
+
+            /**
+             * @brief Copy the `size` bytes at `position` to `destination`
+             */
+            void get(std::uint64_t position, void* destination, std::uint64_t size) const
+            {
+                auto const offset = position % capacity;
+                auto const first = std::min(size, capacity - offset);
+                std::memcpy(destination, data.get() + offset, static_cast<size_t>(first));
+                std::memcpy(static_cast<char*>(destination) + first, data.get(), static_cast<size_t>(size - first));
+            }
+
+            /**
+             * @brief Write the `size` bytes at `position` to `file`
+             */
+            void write(std::uint64_t position, std::uint64_t size, std::FILE* file) const
+            {
+                auto const offset = position % capacity;
+                auto const first = std::min(size, capacity - offset);
+                std::fwrite(data.get() + offset, 1, static_cast<size_t>(first), file);
+                std::fwrite(data.get(), 1, static_cast<size_t>(size - first), file);
+            }
+
+            /**
+             * @brief Free the room of the bytes up to `until`, which have been written
+             */
+            void release(std::uint64_t until) { tail.store(until, std::memory_order_release); }
+
+            /**
+             * @brief Return the size of the published record at `position`, and its time in `time`
+             */
+            std::uint64_t recordSize(std::uint64_t position, std::uint64_t& time) const
+            {
+                get(position + 5, &time, 8);
+                std::uint8_t count;
+                get(position + 13, &count, 1);
+                auto size = RecordHeaderSize;
+                for (unsigned i = 0; i < count; ++i)
+                {
+                    std::uint8_t tag;
+                    get(position + size, &tag, 1);
+                    if (tag == BoolTag || tag == CharTag)
+                        size += 2;
+                    else if (tag == StringTag)
+                    {
+                        std::uint32_t length;
+                        get(position + size + 1, &length, 4);
+                        size += 5 + length;
+                    }
+                    else
+                        size += 9;
+                }
+                return size;
+            }
+        };
+
+        /**
+         * @brief Write the records of `rings` up to `heads` and older than `until` to `file` in the order of their time, and free their room
+         * @details The records of one ring are already in time order, so they are merged with a heap holding the next record of every ring.
+         */
+        inline void writeMerged(std::vector<std::shared_ptr<Ring>> const& rings, std::vector<std::uint64_t> heads, std::uint64_t until, std::FILE* file)
+        {
+            struct Next
+            {
+                std::uint64_t time;
+                size_t ring;
+                std::uint64_t position;
+                std::uint64_t size;
+
+                bool operator>(Next const& rhs) const { return time != rhs.time ? time > rhs.time : ring > rhs.ring; }
+            };
+            std::priority_queue<Next, std::vector<Next>, std::greater<>> next;
+            auto const push = [&](size_t ring, std::uint64_t position)
+            {
+                if (position == heads[ring])
+                    return;
+                std::uint64_t time;
+                auto const size = rings[ring]->recordSize(position, time);
+                if (time >= until)  //held back with the rest of the ring until a later flush
+                    heads[ring] = position;
+                else
+                    next.push({ time, ring, position, size });
+            };
+            for (size_t i = 0; i < rings.size(); ++i)
+                push(i, rings[i]->released());
+            while (!next.empty())
+            {
+                auto const record = next.top();
+                next.pop();
+                rings[record.ring]->write(record.position, record.size, file);
+                push(record.ring, record.position + record.size);
+            }
+            for (size_t i = 0; i < rings.size(); ++i)
+                rings[i]->release(heads[i]);
+        }
+
+        /**
+         * @brief The state of the open @ref BinaryLog, if any
+         */
+        struct State
+        {
+            std::atomic<bool> open{ false };
+            std::atomic<std::uint64_t> generation{ 0 };
+            std::mutex mutex;
+            std::condition_variable wake;
+            bool stopping = false;
+            std::vector<std::shared_ptr<Ring>> rings;
+            std::uint64_t ringSize = 0;
+
+            static State& get()
+            {
+                static State state;
+                return state;
+            }
+        };
+
+        /**
+         * @brief The ring of the calling thread, which is retired when the thread exits, so the writer thread frees it after draining it
+         */
+        struct ThreadRing
+        {
+            std::shared_ptr<Ring> ring;
+
+            ~ThreadRing()
+            {
+                if (ring)
+                    ring->retired.store(true, std::memory_order_release);
+            }
+        };
+
+        /**
+         * @brief Return the ring of the calling thread for the open log, creating it on the first record, or nullptr when no log is open
+         */
+        inline Ring* threadRing()
+        {
+            auto& state = State::get();
+            if (!state.open.load(std::memory_order_acquire))
+                return nullptr;
+            static thread_local ThreadRing local;
+            auto const generation = state.generation.load(std::memory_order_acquire);
+            if (!local.ring || local.ring->generation != generation)
+            {
+                if (local.ring)
+                    local.ring->retired.store(true, std::memory_order_release);
+                std::lock_guard lock{ state.mutex };
+                if (!state.open.load(std::memory_order_relaxed))
+                    return nullptr;
+                local.ring = std::make_shared<Ring>(state.ringSize, generation);
+                state.rings.push_back(local.ring);
+            }
+            return local.ring.get();
+        }
+
+        template<typename T>
+        constexpr bool is_string_v = std::is_convertible_v<T const&, std::string_view>;
+
+        /**
+         * @brief Return the number of bytes `arg` takes in a record
+         */
+        template<typename T>
+        std::uint64_t encodedSize(T const& arg)
+        {
+            if constexpr (std::is_same_v<T, bool> || std::is_same_v<T, char>)
+                return 2;
+            else if constexpr (std::is_arithmetic_v<T> || std::is_enum_v<T>)
+                return 9;
+            else if constexpr (std::is_same_v<T, char const*> || std::is_same_v<T, char*>)
+                return 5 + (arg ? std::strlen(arg) : 0);
+            else
+            {
+                static_assert(is_string_v<T>, "binaryLog() arguments must be numbers, bool, char or strings");
+                return 5 + std::string_view{ arg }.size();
+            }
+        }
+
+        /**
+         * @brief Write `arg` at `position` of `ring` and advance `position`
+         */
+        template<typename T>
+        void encode(Ring& ring, std::uint64_t& position, T const& arg)
+        {
+            auto const write = [&](auto const& value)
+            {
+                ring.put(position, &value, sizeof(value));
+                position += sizeof(value);
+            };
+            if constexpr (std::is_same_v<T, bool>)
+            {
+                write(BoolTag);
+                write(static_cast<std::uint8_t>(arg));
+            }
+            else if constexpr (std::is_same_v<T, char>)
+            {
+                write(CharTag);
+                write(arg);
+            }
+            else if constexpr (std::is_floating_point_v<T>)
+            {
+                write(FloatingTag);
+                write(static_cast<double>(arg));
+            }
+            else if constexpr (std::is_enum_v<T>)
+            {
+                write(SignedTag);
+                write(static_cast<std::int64_t>(arg));
+            }
+            else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>)
+            {
+                write(SignedTag);
+                write(static_cast<std::int64_t>(arg));
+            }
+            else if constexpr (std::is_integral_v<T>)
+            {
+                write(UnsignedTag);
+                write(static_cast<std::uint64_t>(arg));
+            }
+            else
+            {
+                std::string_view const text = [&arg]
+                {
+                    if constexpr (std::is_same_v<T, char const*> || std::is_same_v<T, char*>)
+                        return arg ? std::string_view{ arg } : std::string_view{};
+                    else
+                        return std::string_view{ arg };
+                }();
+                write(StringTag);
+                write(static_cast<std::uint32_t>(text.size()));
+                ring.put(position, text.data(), text.size());
+                position += text.size();
+            }
+        }
+
+        template<typename T>
+        void writeValue(std::FILE* file, T const& value)
+        {
+            std::fwrite(&value, sizeof(value), 1, file);
+        }
+
+        inline void writeText(std::FILE* file, char const* text)
+        {
+            auto const length = static_cast<std::uint32_t>(text ? std::strlen(text) : 0);
+            writeValue(file, length);
+            std::fwrite(text, 1, length, file);
+        }
+
+        template<typename T>
+        T readValue(std::istream& in)
+        {
+            T value;
+            if (!in.read(reinterpret_cast<char*>(&value), sizeof(value)))
+                throw std::runtime_error{ "truncated binary log" };
+            return value;
+        }
+
+        inline std::string readText(std::istream& in)
+        {
+            std::string text(readValue<std::uint32_t>(in), '\0');
+            if (!in.read(text.data(), static_cast<std::streamsize>(text.size())))
+                throw std::runtime_error{ "truncated binary log" };
+            return text;
+        }
+    }
+
+    /**
+     * @brief A call site of @ref binaryLog, which holds its level and its format, so that they are saved once instead of in every record
+     * @details Declare it `static` next to the call, with a string literal as format, where `{}` is replaced by the arguments in order:
+     * ~~~~{.cpp}
+     *     static LogSite<Level::Info> const site{ "read {} bytes from {}" };
+     *     binaryLog(site, size, path);
+     * ~~~~
+     */
+    template<Level level>
+    class LogSite
+    {
+        std::uint32_t siteId;
+    public:
+        /**
+         * @param format Must live until the end of the program, like a string literal
+         */
+        explicit LogSite(char const* format, char const* file = "", unsigned line = 0)
+            :siteId(BinaryLog_detail::Registry::get().add({ level, format, file, line }))
+        {
+        }
+
+        [[nodiscard]] std::uint32_t id() const { return siteId; }
+    };
+
+    /**
+     * @brief Record a message in the open @ref BinaryLog, without formatting it
+     * @details
+     * The arguments, which can be numbers, bool, char or strings, are copied as bytes into a ring buffer of the calling thread,
+     * which a background thread writes to the file. The strings are copied too, so they do not need to outlive the call.
+     * Levels are filtered like @ref log. Nothing is recorded when no log is open. When the ring of the thread is full, the call waits
+     * for the background thread to write it, and the time of the record is taken after waiting.
+     */
+    template<Level level, typename... Args>
+    void binaryLog(LogSite<level> const& site, Args const&... args)
+    {
+        static_assert(sizeof...(Args) < 256, "binaryLog() supports up to 255 arguments");
+        if constexpr (level >= Log_detail::compiledLevel && level != Level::Off)
+        {
+            if (!logEnabled<level>())
+                return;
+            auto const ring = BinaryLog_detail::threadRing();
+            if (!ring)
+                return;
+
+            std::uint64_t const size = BinaryLog_detail::RecordHeaderSize + (std::uint64_t{ 0 } + ... + BinaryLog_detail::encodedSize(args));
+            if (size > ring->size())
+                return;
+            std::uint64_t position;
+            //the ring is only drained while the log it was created for is open, not by a log opened after it
+            auto const drained = [ring]
+            {
+                auto const& state = BinaryLog_detail::State::get();
+                return state.open.load(std::memory_order_relaxed) && state.generation.load(std::memory_order_relaxed) == ring->generation;
+            };
+            if (!ring->reserve(size, position, drained))
+                return;
+            ring->beginRecord();
+            auto const time = BinaryLog_detail::steadyNow();
+
+            auto const start = position;
+            std::uint8_t const header[]{ BinaryLog_detail::RecordKind };
+            ring->put(position, header, 1);
+            position += 1;
+            auto const id = site.id();
+            ring->put(position, &id, 4);
+            position += 4;
+            ring->put(position, &time, 8);
+            position += 8;
+            auto const count = static_cast<std::uint8_t>(sizeof...(Args));
+            ring->put(position, &count, 1);
+            position += 1;
+            (BinaryLog_detail::encode(*ring, position, args), ...);
+            ring->publish(start + size);
+        }
+    }
+
+    /**
+     * @brief Opens a binary log file, which @ref binaryLog records to until it is destroyed
+     * @details Only one can be open at a time. Its background thread writes the rings of the threads to the file every `flushInterval`,
+     * merging the records of all the threads by their time, so the file is in time order. A record whose thread is still writing it
+     * holds back the newer records of the other threads until the next flush.
+     */
+    class BinaryLog
+    {
+        std::FILE* file = nullptr;
+        std::thread writer;
+        std::chrono::nanoseconds flushInterval;
+
+        void run()
+        {
+            using namespace BinaryLog_detail;
+            auto& state = State::get();
+            size_t writtenSites = 0;
+            std::uint64_t previousFlush = 0;
+            while (true)
+            {
+                std::vector<std::shared_ptr<Ring>> rings;
+                bool last;
+                {
+                    std::unique_lock lock{ state.mutex };
+                    state.wake.wait_for(lock, flushInterval, [&state] { return state.stopping; });
+                    last = state.stopping;
+                    rings = state.rings;
+                }
+
+                /*
+                 * A record is only written once no record older than it can be published later, so the file is in time order.
+                 * A ring which is not busy only publishes records taking their time after `now`. A ring busy with the same `head` as
+                 * in the previous flush is still writing the same record, otherwise its record took its time after the previous flush.
+                 */
+                auto const now = steadyNow();
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                auto until = last ? Ring::NotBusy : now;
+                /*the sites used by the records are registered before the records are published*/
+                std::vector<bool> retired;
+                std::vector<std::uint64_t> heads;
+                for (auto const& ring : rings)
+                {
+                    retired.push_back(ring->retired.load(std::memory_order_acquire));
+                    auto const busy = ring->isBusy();
+                    heads.push_back(ring->published());
+                    if (!busy)
+                        ring->busyHead = Ring::NotBusy;
+                    else
+                    {
+                        if (ring->busyHead != heads.back())
+                        {
+                            ring->busyHead = heads.back();
+                            ring->busyBound = previousFlush;
+                        }
+                        if (!last)
+                            until = std::min(until, ring->busyBound);
+                    }
+                }
+                previousFlush = now;
+                {
+                    auto& registry = Registry::get();
+                    std::lock_guard lock{ registry.mutex };
+                    for (; writtenSites < registry.sites.size(); ++writtenSites)
+                    {
+                        auto const& site = registry.sites[writtenSites];
+                        writeValue(file, SiteKind);
+                        writeValue(file, static_cast<std::uint32_t>(writtenSites));
+                        writeValue(file, static_cast<std::uint8_t>(site.level));
+                        writeValue(file, static_cast<std::uint32_t>(site.line));
+                        writeText(file, site.file);
+                        writeText(file, site.format);
+                    }
+                }
+                writeMerged(rings, std::move(heads), until, file);
+                std::fflush(file);
+
+                {
+                    std::lock_guard lock{ state.mutex };
+                    for (size_t i = 0; i < rings.size(); ++i)
+                    {
+                        if (retired[i] && rings[i]->empty())
+                            state.rings.erase(std::find(state.rings.begin(), state.rings.end(), rings[i]));
+                    }
+                }
+                if (last)
+                    return;
+            }
+        }
+    public:
+        /**
+         * @brief Create the file at `path` and start recording
+         * @param ringSize The size in bytes of the ring buffer of each thread, which bounds the size of a record
+         * @throw FileIOError if the file cannot be created
+         * @throw std::logic_error if another BinaryLog is open
+         */
+        explicit BinaryLog(std::string const& path, size_t ringSize = 1 << 20, std::chrono::nanoseconds flushInterval = std::chrono::milliseconds{ 1 })
+            :flushInterval(flushInterval)
+        {
+            using namespace BinaryLog_detail;
+            auto& state = State::get();
+            std::lock_guard lock{ state.mutex };
+            if (state.open.load(std::memory_order_relaxed))
+                throw std::logic_error{ "Only one BinaryLog can be open at a time" };
+            file = std::fopen(path.c_str(), "wb");
+            if (!file)
+                throw FileIOError{ path.c_str() };
+
+            std::fwrite(magic, 1, sizeof(magic), file);
+            writeValue(file, steadyNow());
+            writeValue(file, static_cast<std::int64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count()));
+
+            state.ringSize = std::max<size_t>(ringSize, 64);
+            state.stopping = false;
+            state.generation.fetch_add(1, std::memory_order_relaxed);
+            state.open.store(true, std::memory_order_release);
+            writer = std::thread{ [this] { run(); } };
+        }
+
+        BinaryLog(BinaryLog const&) = delete;
+        BinaryLog& operator=(BinaryLog const&) = delete;
+
+        /**
+         * @brief Write the remaining records and close the file
+         * @note The records made while it is being destroyed may be lost
+         */
+        ~BinaryLog()
+        {
+            auto& state = BinaryLog_detail::State::get();
+            {
+                std::lock_guard lock{ state.mutex };
+                state.open.store(false, std::memory_order_release);
+                state.stopping = true;
+            }
+            state.wake.notify_all();
+            writer.join();
+            {
+                std::lock_guard lock{ state.mutex };
+                state.rings.clear();
+            }
+            std::fclose(file);
+        }
+    };
+
+    /**
+     * @brief Write the messages of a binary log from `in` as text to `out`, one per line, and return how many there were
+     * @details A line is the time in seconds since the log was opened, the level and the formatted message.
+     * The values of the arguments without a `{}` in the format are appended, separated by spaces.
+     * @throw std::runtime_error if `in` is not a binary log, or is truncated
+     */
+    inline size_t decodeBinaryLog(std::istream& in, std::ostream& out)
+    {
+        using namespace BinaryLog_detail;
+        char header[sizeof(magic)];
+        if (!in.read(header, sizeof(header)) || std::memcmp(header, magic, sizeof(magic)) != 0)
+            throw std::runtime_error{ "not a SugarPP binary log" };
+        auto const start = readValue<std::uint64_t>(in);
+        (void)readValue<std::int64_t>(in);
+
+        struct Site
+        {
+            Level level;
+            std::string format;
+        };
+        std::vector<Site> sites;
+        size_t count = 0;
+        auto const flags = out.flags();
+        auto const precision = out.precision();
+        for (int kind; (kind = in.get()) != std::char_traits<char>::eof();)
+        {
+            if (kind == SiteKind)
+            {
+                auto const id = readValue<std::uint32_t>(in);
+                auto const levelByte = readValue<std::uint8_t>(in);
+                if (levelByte > static_cast<std::uint8_t>(Level::Off))
+                    throw std::runtime_error{ "corrupted binary log: invalid level " + std::to_string(levelByte) };
+                auto const level = static_cast<Level>(levelByte);
+                (void)readValue<std::uint32_t>(in);
+                (void)readText(in);
+                auto format = readText(in);
+                if (sites.size() <= id)
+                    sites.resize(id + 1);
+                sites[id] = { level, std::move(format) };
+                continue;
+            }
+            if (kind != RecordKind)
+                throw std::runtime_error{ "corrupted binary log" };
+
+            auto const id = readValue<std::uint32_t>(in);
+            auto const time = readValue<std::uint64_t>(in);
+            auto const argumentCount = readValue<std::uint8_t>(in);
+            if (id >= sites.size())
+                throw std::runtime_error{ "binary log record of an unknown site" };
+            auto const& site = sites[id];
+
+            out << std::fixed << std::setprecision(6) << static_cast<double>(time - start) / 1e9 << ' ' << Log_detail::prefix(site.level) << ' ';
+            out.flags(flags);
+            out.precision(precision);
+            size_t formatPosition = 0;
+            for (unsigned i = 0; i < argumentCount; ++i)
+            {
+                auto const placeholder = site.format.find("{}", formatPosition);
+                if (placeholder == std::string::npos)
+                {
+                    out << std::string_view{ site.format }.substr(formatPosition);
+                    if (!site.format.empty() || i != 0)
+                        out << ' ';
+                    formatPosition = site.format.size();
+                }
+                else
+                {
+                    out << std::string_view{ site.format }.substr(formatPosition, placeholder - formatPosition);
+                    formatPosition = placeholder + 2;
+                }
+
+                switch (readValue<std::uint8_t>(in))
+                {
+                case SignedTag: out << readValue<std::int64_t>(in); break;
+                case UnsignedTag: out << readValue<std::uint64_t>(in); break;
+                case FloatingTag: out << readValue<double>(in); break;
+                case BoolTag: out << (readValue<std::uint8_t>(in) ? "True" : "False"); break;
+                case CharTag: out << readValue<char>(in); break;
+                case StringTag: out << readText(in); break;
+                default: throw std::runtime_error{ "corrupted binary log" };
+                }
+            }
+            out << std::string_view{ site.format }.substr(formatPosition) << '\n';
+            ++count;
+        }
+        return count;
+    }
+
+#ifdef SugarPPNamespace
+}
+#endif
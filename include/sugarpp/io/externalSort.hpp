@@ -0,0 +1,555 @@
+/*****************************************************************//**
+ * \file   externalSort.hpp
+ * \brief  Sorting files larger than the memory, by lines or by fixed-size records
+ *
+ * \author Peter
+ * \date   October 2026
+ * \note The runs are written next to the output file, and removed when the sort finishes or throws
+ *********************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "file.hpp"
+#include "../range/sort.hpp"
+#include "../string/split.hpp"
+#include "../thread/threadPool.hpp"
+#include "../traits/traits.hpp"
+
+#ifdef SugarPPNamespace
+namespace SugarPP
+{
+#endif
+
+    namespace ExternalSort_detail
+    {
+        /**
+         * @brief The smallest buffer of a file read or written while merging, below which the disk spends its time seeking
+         */
+        constexpr size_t minBufferSize = 1 << 20;
+
+        /**
+         * @brief Whether `Record` means sorting by lines
+         */
+        template<typename Record>
+        constexpr bool byLines = std::is_same_v<Record, std::string_view>;
+
+        struct FileCloser
+        {
+            void operator()(std::FILE* file) const { std::fclose(file); }
+        };
+        using FilePtr = std::unique_ptr<std::FILE, FileCloser>;
+
+        inline FilePtr open(std::filesystem::path const& path, char const* mode)
+        {
+            FilePtr file{ std::fopen(path.string().c_str(), mode) };
+            if (!file)
+                throw FileIOError{ path.string().c_str() };
+            return file;
+        }
+
+        /**
+         * @brief Reads a file sequentially in large blocks, record by record or line by line
+         */
+        class Reader
+        {
+            std::filesystem::path path;
+            FilePtr file;
+            std::unique_ptr<char[]> buffer;
+            size_t capacity;
+            size_t position = 0;
+            size_t filled = 0;
+            bool end = false;
+
+            /**
+             * @brief Move the unread bytes to the front of the buffer, and read after them
+             */
+            void refill()
+            {
+                std::memmove(buffer.get(), buffer.get() + position, filled - position);
+                filled -= position;
+                position = 0;
+                auto const read = std::fread(buffer.get() + filled, 1, capacity - filled, file.get());
+                if (read < capacity - filled)
+                {
+                    if (std::ferror(file.get()))
+                        throw FileIOError{ path.string().c_str() };
+                    end = true;
+                }
+                filled += read;
+            }
+        public:
+            Reader(std::filesystem::path const& path, size_t bufferSize)
+                :path(path), file(open(path, "rb")), buffer(new char[bufferSize]), capacity(bufferSize)
+            {
+            }
+
+            /**
+             * @brief Read the next line, without its `'\n'`, which stays valid until the next call
+             */
+            bool nextLine(std::string_view& line)
+            {
+                while (true)
+                {
+                    auto const first = buffer.get() + position;
+                    auto const last = buffer.get() + filled;
+                    if (auto const newLine = String_detail::findChar(first, last, '\n'); newLine != last)
+                    {
+                        line = { first, static_cast<size_t>(newLine - first) };
+                        position += line.size() + 1;
+                        return true;
+                    }
+                    if (end)
+                    {
+                        if (first == last)
+                            return false;
+                        line = { first, static_cast<size_t>(last - first) };
+                        position = filled;
+                        return true;
+                    }
+                    if (position == 0 && filled == capacity)
+                    {
+                        /*a line longer than the buffer*/
+                        std::unique_ptr<char[]> grown{ new char[capacity * 2] };
+                        std::memcpy(grown.get(), buffer.get(), filled);
+                        buffer = std::move(grown);
+                        capacity *= 2;
+                    }
+                    refill();
+                }
+            }
+
+            template<typename Record>
+            bool nextRecord(Record& record)
+            {
+                if (filled - position < sizeof(Record))
+                {
+                    if (!end)
+                        refill();
+                    if (filled - position < sizeof(Record))
+                        return false;
+                }
+                std::memcpy(&record, buffer.get() + position, sizeof(Record));
+                position += sizeof(Record);
+                return true;
+            }
+
+            template<typename Record>
+            bool next(Record& record)
+            {
+                if constexpr (byLines<Record>)
+                    return nextLine(record);
+                else
+                    return nextRecord(record);
+            }
+        };
+
+        /**
+         * @brief Writes a file sequentially in large blocks
+         */
+        class Writer
+        {
+            std::filesystem::path path;
+            FilePtr file;
+            std::unique_ptr<char[]> buffer;
+            size_t capacity;
+            size_t filled = 0;
+
+            void flush()
+            {
+                if (std::fwrite(buffer.get(), 1, filled, file.get()) != filled)
+                    throw FileIOError{ path.string().c_str() };
+                filled = 0;
+            }
+
+            void write(char const* data, size_t size)
+            {
+                if (filled + size > capacity)
+                {
+                    flush();
+                    if (size > capacity)
+                    {
+                        if (std::fwrite(data, 1, size, file.get()) != size)
+                            throw FileIOError{ path.string().c_str() };
+                        return;
+                    }
+                }
+                std::memcpy(buffer.get() + filled, data, size);
+                filled += size;
+            }
+        public:
+            Writer(std::filesystem::path const& path, size_t bufferSize)
+                :path(path), file(open(path, "wb")), buffer(new char[bufferSize]), capacity(bufferSize)
+            {
+            }
+
+            /**
+             * @brief Write a record, or a line followed by `'\n'`
+             */
+            template<typename Record>
+            void write(Record const& record)
+            {
+                if constexpr (byLines<Record>)
+                {
+                    write(record.data(), record.size());
+                    write("\n", 1);
+                }
+                else
+                    write(reinterpret_cast<char const*>(&record), sizeof(Record));
+            }
+
+            /**
+             * @throw FileIOError if the file cannot be written
+             */
+            void close()
+            {
+                flush();
+                if (std::fclose(file.release()) != 0)
+                    throw FileIOError{ path.string().c_str() };
+            }
+        };
+
+        /**
+         * @brief The runs of a sort, removed with it
+         */
+        class TempFiles
+        {
+            std::filesystem::path prefix;
+            size_t count = 0;
+            std::vector<std::filesystem::path> paths;
+        public:
+            explicit TempFiles(std::filesystem::path const& output) :prefix(output)
+            {
+                prefix += ".run";
+            }
+
+            TempFiles(TempFiles const&) = delete;
+            TempFiles& operator=(TempFiles const&) = delete;
+
+            ~TempFiles()
+            {
+                for (auto const& path : paths)
+                {
+                    std::error_code error;
+                    std::filesystem::remove(path, error);
+                }
+            }
+
+            std::filesystem::path make()
+            {
+                auto path = prefix;
+                path += std::to_string(count++);
+                paths.push_back(path);
+                return path;
+            }
+
+            void remove(std::filesystem::path const& path)
+            {
+                std::error_code error;
+                std::filesystem::remove(path, error);
+                paths.erase(std::find(paths.begin(), paths.end(), path));
+            }
+        };
+
+        /**
+         * @brief A loser tree of `k` sources, which finds the smallest of their current records with about log2(k) comparisons per record
+         * @details Nodes 1 to k - 1 keep the loser of the match under them, and the leaves k to 2k - 1 are the sources,
+         * so that replacing the winner only replays the matches on its path to the root, against the losers kept there.
+         */
+        class LoserTree
+        {
+            std::vector<size_t> nodes;     //nodes[0] is the winner
+        public:
+            /**
+             * @param beats Whether source `a` is ahead of source `b`, `bool(size_t a, size_t b)`
+             */
+            template<typename Beats>
+            LoserTree(size_t k, Beats& beats) :nodes(k)
+            {
+                std::vector<size_t> winners(2 * k);
+                for (size_t i = 0; i < k; ++i)
+                    winners[k + i] = i;
+                for (auto node = k - 1; node >= 1; --node)
+                {
+                    auto const a = winners[2 * node];
+                    auto const b = winners[2 * node + 1];
+                    auto const aWins = beats(a, b);
+                    winners[node] = aWins ? a : b;
+                    nodes[node] = aWins ? b : a;
+                }
+                nodes[0] = k == 1 ? 0 : winners[1];
+            }
+
+            [[nodiscard]] size_t winner() const { return nodes[0]; }
+
+            /**
+             * @brief Find the winner again, after the record of the winner changed
+             */
+            template<typename Beats>
+            void replay(Beats& beats)
+            {
+                auto winner = nodes[0];
+                for (auto node = (winner + nodes.size()) / 2; node >= 1; node /= 2)
+                {
+                    if (beats(nodes[node], winner))
+                        std::swap(nodes[node], winner);
+                }
+                nodes[0] = winner;
+            }
+        };
+
+        /**
+         * @brief The type of the keys given by `KeyOrCompare`, or `char` if it is a comparator
+         */
+        template<typename Record, typename KeyOrCompare, bool = std::is_invocable_v<KeyOrCompare&, Record const&>>
+        struct KeyOf
+        {
+            using type = char;
+        };
+
+        template<typename Record, typename KeyOrCompare>
+        struct KeyOf<Record, KeyOrCompare, true>
+        {
+            using type = std::decay_t<std::invoke_result_t<KeyOrCompare&, Record const&>>;
+        };
+
+        /**
+         * @brief Merge the sorted `inputs` into `output`, using about `memoryBudget` bytes of buffers
+         * @details Equal records come out in the order of `inputs`, so that the merge is stable.
+         * With a key function, the key of the current record of each input is computed once.
+         */
+        template<typename Record, typename KeyOrCompare>
+        void merge(std::vector<std::filesystem::path> const& inputs, std::filesystem::path const& output, size_t memoryBudget, KeyOrCompare& keyOrCompare)
+        {
+            auto const k = inputs.size();
+            auto const bufferSize = std::max(minBufferSize, memoryBudget / (k + 1));
+            std::vector<Reader> readers;
+            readers.reserve(k);
+            for (auto const& input : inputs)
+                readers.emplace_back(input, bufferSize);
+            Writer writer{ output, bufferSize };
+
+            std::vector<Record> current(k);
+            std::vector<char> exhausted(k);
+            constexpr auto keyed = std::is_invocable_v<KeyOrCompare&, Record const&>;
+            std::vector<typename KeyOf<Record, KeyOrCompare>::type> keys(keyed ? k : 0);
+
+            auto const advance = [&](size_t i)
+            {
+                exhausted[i] = !readers[i].next(current[i]);
+                if constexpr (keyed)
+                {
+                    if (!exhausted[i])
+                        keys[i] = keyOrCompare(static_cast<Record const&>(current[i]));
+                }
+            };
+            auto const less = [&](size_t a, size_t b)
+            {
+                if constexpr (keyed)
+                    return keys[a] < keys[b];
+                else
+                    return static_cast<bool>(keyOrCompare(static_cast<Record const&>(current[a]), static_cast<Record const&>(current[b])));
+            };
+            auto beats = [&](size_t a, size_t b)
+            {
+                if (exhausted[a] || exhausted[b])
+                    return !exhausted[a];
+                return a < b ? !less(b, a) : less(a, b);
+            };
+
+            for (size_t i = 0; i < k; ++i)
+                advance(i);
+            LoserTree tree{ k, beats };
+            while (!exhausted[tree.winner()])
+            {
+                auto const winner = tree.winner();
+                writer.write(current[winner]);
+                advance(winner);
+                tree.replay(beats);
+            }
+            writer.close();
+        }
+
+        /**
+         * @brief Sort the data of `input` in memory, in parts taking `runSize` bytes with the scratch of sorting them, and write each sorted part to a temporary file
+         * @return The runs, or none if the input was sorted straight into `output` as it fitted in one run
+         */
+        template<typename Record, typename KeyOrCompare>
+        std::vector<std::filesystem::path> makeRuns(std::filesystem::path const& input, std::filesystem::path const& output,
+            size_t runSize, KeyOrCompare& keyOrCompare, ThreadPool& pool, TempFiles& temps)
+        {
+            auto const file = open(input, "rb");
+            std::vector<std::filesystem::path> runs;
+            auto const writeRun = [&](Record const* records, size_t count, bool last)
+            {
+                auto const path = last && runs.empty() ? output : temps.make();
+                Writer writer{ path, minBufferSize };
+                for (size_t i = 0; i < count; ++i)
+                    writer.write(records[i]);
+                writer.close();
+                if (path != output)
+                    runs.push_back(path);
+            };
+            auto const readInto = [&](char* data, size_t size)
+            {
+                auto const read = std::fread(data, 1, size, file.get());
+                if (read < size && std::ferror(file.get()))
+                    throw FileIOError{ input.string().c_str() };
+                return read;
+            };
+
+            if constexpr (byLines<Record>)
+            {
+                /*a run ends when its text, the index of its lines and the scratch of sorting them take runSize*/
+                constexpr auto perLine = sizeof(std::string_view) + Sort_detail::scratchSize<std::string_view, KeyOrCompare>();
+                auto capacity = runSize;
+                std::unique_ptr<char[]> buffer{ new char[capacity] };
+                std::vector<std::string_view> lines;
+                size_t filled = 0;
+                bool end = false;
+                while (true)
+                {
+                    lines.clear();
+                    char const* first = buffer.get();
+                    auto full = false;
+                    while (true)
+                    {
+                        auto const last = buffer.get() + filled;
+                        for (auto newLine = String_detail::findChar(first, last, '\n'); newLine != last; newLine = String_detail::findChar(first, last, '\n'))
+                        {
+                            if (!lines.empty() && static_cast<size_t>(newLine + 1 - buffer.get()) + (lines.size() + 1) * perLine > runSize)
+                            {
+                                full = true;
+                                break;
+                            }
+                            lines.emplace_back(first, static_cast<size_t>(newLine - first));
+                            first = newLine + 1;
+                        }
+                        if (full || (end && first == last))
+                            break;
+                        if (end)
+                        {
+                            lines.emplace_back(first, static_cast<size_t>(last - first));
+                            first = last;
+                            break;
+                        }
+                        if (filled == capacity)
+                        {
+                            if (!lines.empty())
+                                break;
+                            /*a line longer than a run*/
+                            std::unique_ptr<char[]> grown{ new char[capacity * 2] };
+                            std::memcpy(grown.get(), buffer.get(), filled);
+                            buffer = std::move(grown);
+                            capacity *= 2;
+                            first = buffer.get();
+                        }
+                        /*read a block at a time, so that the pages of the buffer past the run are not touched*/
+                        auto const size = std::min(minBufferSize, capacity - filled);
+                        auto const read = readInto(buffer.get() + filled, size);
+                        end = read < size;
+                        filled += read;
+                    }
+                    auto const last = buffer.get() + filled;
+                    Sort_detail::sort(&pool, lines.data(), lines.size(), keyOrCompare, Stability::Stable);
+                    writeRun(lines.data(), lines.size(), end && first == last);
+                    if (end && first == last)
+                        break;
+                    filled = static_cast<size_t>(last - first);
+                    std::memmove(buffer.get(), first, filled);
+                }
+            }
+            else
+            {
+                std::error_code error;
+                if (auto const size = std::filesystem::file_size(input, error); !error && size % sizeof(Record) != 0)
+                    throw std::invalid_argument{ "external_sort() input is not a whole number of records" };
+
+                auto const capacity = std::max<size_t>(1, runSize / (sizeof(Record) + Sort_detail::scratchSize<Record, KeyOrCompare>()));
+                std::unique_ptr<Record[]> records{ new Record[capacity] };
+                bool end = false;
+                while (!end)
+                {
+                    auto const count = readInto(reinterpret_cast<char*>(records.get()), capacity * sizeof(Record)) / sizeof(Record);
+                    end = count < capacity;
+                    Sort_detail::sort(&pool, records.get(), count, keyOrCompare, Stability::Stable);
+                    writeRun(records.get(), count, end);
+                }
+            }
+            return runs;
+        }
+    }
+
+    /**
+     * @brief Sort the file at `input` into `output` with about `memoryBudget` bytes of memory, for files larger than the memory
+     * @details
+     * With `Record` as `std::string_view`, the default, the file is sorted by lines. Otherwise it is sorted as an array of
+     * `Record`, which must be trivially copyable, like a binary dump of structs. A last line without `'\n'` gets one.
+     *
+     * The input is read in parts which take `memoryBudget` with the index of their lines and the scratch of sorting them,
+     * each of them sorted in parallel on `pool` with @ref sort,
+     * so numeric keys are radix sorted, and written to a temporary file next to `output`. The sorted parts are then merged
+     * with a loser tree, through buffers of at least 1 MB each, in several passes if there are too many of them for the budget.
+     * An input which fits in one part is sorted straight into `output`. The sort is stable.
+     * ~~~~{.cpp}
+     *     external_sort("access.log", "sorted.log", size_t{ 32 } << 30);     //by whole lines
+     *     external_sort("access.log", "by_time.log", size_t{ 32 } << 30, [](std::string_view line) { return line.substr(0, 19); });
+     *     external_sort<Trade>("trades.bin", "by_price.bin", size_t{ 32 } << 30, [](Trade const& trade) { return trade.price; });
+     * ~~~~
+     * @param keyOrCompare Either a key function taking a record, or a comparator taking two records, like @ref sort.
+     * A key of a line may refer to the line, which outlives the key.
+     * @throw FileIOError if a file cannot be read or written
+     * @throw std::invalid_argument if the size of the file is not a multiple of the size of `Record`
+     */
+    template<typename Record = std::string_view, typename KeyOrCompare = Traits_detail::Identity>
+    void external_sort(std::filesystem::path const& input, std::filesystem::path const& output, size_t memoryBudget,
+        KeyOrCompare&& keyOrCompare = {}, ThreadPool& pool = ThreadPool::shared())
+    {
+        static_assert(ExternalSort_detail::byLines<Record> || (std::is_trivially_copyable_v<Record> && std::is_default_constructible_v<Record>),
+            "external_sort() records must be std::string_view for lines, or trivially copyable");
+        using namespace ExternalSort_detail;
+
+        TempFiles temps{ output };
+        /*the budget of a run is less the buffer it is written through*/
+        auto runs = makeRuns<Record>(input, output, std::max(minBufferSize, memoryBudget - std::min(memoryBudget, minBufferSize)), keyOrCompare, pool, temps);
+        if (runs.empty())
+            return;
+
+        /*merge as many runs at once as the budget has buffers for*/
+        auto const fanIn = std::max<size_t>(2, memoryBudget / minBufferSize - 1);
+        while (runs.size() > fanIn)
+        {
+            std::vector<std::filesystem::path> merged;
+            for (size_t first = 0; first < runs.size(); first += fanIn)
+            {
+                std::vector<std::filesystem::path> const group(runs.begin() + first, runs.begin() + std::min(runs.size(), first + fanIn));
+                if (group.size() == 1)
+                {
+                    merged.push_back(group.front());
+                    continue;
+                }
+                merged.push_back(temps.make());
+                merge<Record>(group, merged.back(), memoryBudget, keyOrCompare);
+                for (auto const& run : group)
+                    temps.remove(run);
+            }
+            runs = std::move(merged);
+        }
+        merge<Record>(runs, output, memoryBudget, keyOrCompare);
+    }
+
+#ifdef SugarPPNamespace
+}
+#endif
@@ -0,0 +1,706 @@
+/*****************************************************************//**
+ * \file   file.hpp
+ * \brief  Reading files line by line or as a whole, through the page cache or around it
+ *
+ * \author Peter
+ * \date   October 2026
+ *********************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if __cplusplus >= 201703L
+#include <string_view>
+#include <filesystem>
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#ifdef SugarPPNamespace
+namespace SugarPP
+{
+#endif
+
+    struct FileIOError:std::runtime_error
+    {
+        FileIOError(const char* const fileName):std::runtime_error(std::string{fileName}+" causes a file IO error"){}
+    };
+
+    /**
+     * @brief The number of blocks a @ref FileIterator reads ahead on a background thread, 0 to read on the calling thread
+     */
+    struct ReadAhead
+    {
+        size_t depth = 0;
+    };
+
+    namespace File_detail
+    {
+        /**
+         * @brief Read the blocks of a file on its own thread, up to `depth` blocks ahead of the consumer
+         * @details The consumer swaps its block with the oldest read one, and its previous block is reused for the next read.
+         */
+        template<typename Char>
+        class Prefetcher
+        {
+            struct Block
+            {
+                std::vector<Char> data;
+                size_t size;
+            };
+
+            std::basic_ifstream<Char> fs;
+            std::mutex mutex;
+            std::condition_variable changed;
+            std::deque<Block> ready;
+            std::vector<std::vector<Char>> spare;
+            bool done = false;      //the file is read to the end
+            bool stopping = false;
+            std::thread reader;
+
+            void run()
+            {
+                while (true)
+                {
+                    std::vector<Char> data;
+                    {
+                        std::unique_lock lock{ mutex };
+                        changed.wait(lock, [this] { return stopping || !spare.empty(); });
+                        if (stopping)
+                            return;
+                        data = std::move(spare.back());
+                        spare.pop_back();
+                    }
+                    fs.read(data.data(), static_cast<std::streamsize>(data.size()));
+                    auto const size = static_cast<size_t>(fs.gcount());
+                    {
+                        std::lock_guard lock{ mutex };
+                        ready.push_back({ std::move(data), size });
+                        done = size == 0 || !fs;
+                    }
+                    changed.notify_all();
+                    if (size == 0 || !fs)
+                        return;
+                }
+            }
+        public:
+            Prefetcher(std::basic_ifstream<Char> fs, size_t blockSize, size_t depth) :fs(std::move(fs))
+            {
+                for (size_t i = 0; i < depth; ++i)
+                    spare.emplace_back(blockSize);
+                reader = std::thread{ [this] { run(); } };
+            }
+
+            ~Prefetcher()
+            {
+                {
+                    std::lock_guard lock{ mutex };
+                    stopping = true;
+                }
+                changed.notify_all();
+                reader.join();
+            }
+
+            /**
+             * @brief Swap `block` with the next read block, and return its size, which is 0 at the end of the file
+             */
+            size_t next(std::vector<Char>& block)
+            {
+                std::unique_lock lock{ mutex };
+                changed.wait(lock, [this] { return done || !ready.empty(); });
+                if (ready.empty())
+                    return 0;
+                auto& front = ready.front();
+                std::swap(block, front.data);
+                auto const size = front.size;
+                spare.push_back(std::move(front.data));
+                ready.pop_front();
+                lock.unlock();
+                changed.notify_all();
+                return size;
+            }
+        };
+    }
+
+    /**
+     * @brief Read a file line by line in a range-based for loop
+     * @details
+     * ~~~~{.cpp}
+     *     for (auto const& line : FileIterator{ "log.txt" })
+     *         ...
+     * ~~~~
+     * The file is read in blocks of `BlockSize` characters and split on `'\n'`, which behaves like `std::getline` but without
+     * going through the stream once per character. Every line is stored in the same buffer, so the reference you get
+     * is only valid until the next line is read.
+     *
+     * With a @ref ReadAhead, a background thread reads up to `depth` blocks ahead while the lines of the current one are
+     * processed, which hides the latency of a slow or cold disk behind the parsing:
+     * ~~~~{.cpp}
+     *     for (auto const& line : FileIterator{ "huge.log", ReadAhead{ 4 } })
+     *         ...
+     * ~~~~
+     * @tparam Char The type of char of the file, can be either char or wchar_t
+     */
+    template<typename Char = char>
+    class FileIterator
+    {
+        std::basic_ifstream<Char> fs;
+        std::vector<Char> block;
+        size_t blockBegin = 0;
+        size_t blockEnd = 0;
+        std::basic_string<Char> line;
+        std::unique_ptr<File_detail::Prefetcher<Char>> prefetcher;
+
+        /**
+         * @brief Read the next block into the buffer
+         * @return false if there is nothing left in the file
+         */
+        bool fill()
+        {
+            if (prefetcher)
+            {
+                blockBegin = 0;
+                blockEnd = prefetcher->next(block);
+                return blockEnd != 0;
+            }
+            if (!fs)
+                return false;
+            fs.read(block.data(), static_cast<std::streamsize>(block.size()));
+            blockBegin = 0;
+            blockEnd = static_cast<size_t>(fs.gcount());
+            return blockEnd != 0;
+        }
+
+        /**
+         * @brief Read the next line into `line`
+         * @return false if there is no more line
+         */
+        bool readLine()
+        {
+            line.clear();
+            bool hasContent = false;
+            while (true)
+            {
+                if (blockBegin == blockEnd && !fill())
+                    return hasContent;
+                hasContent = true;
+                auto const first = block.data() + blockBegin;
+                auto const count = blockEnd - blockBegin;
+                if (auto const newline = std::char_traits<Char>::find(first, count, Char('\n')))
+                {
+                    line.append(first, static_cast<size_t>(newline - first));
+                    blockBegin += static_cast<size_t>(newline - first) + 1;
+                    return true;
+                }
+                line.append(first, count);
+                blockBegin = blockEnd;
+            }
+        }
+
+#if __cplusplus >= 201703L
+        using path_type = std::filesystem::path;
+#else
+        using path_type = std::basic_string<Char>;
+#endif
+    public:
+        static constexpr size_t BlockSize = 64 * 1024;
+        using value_type = std::basic_string<Char>;
+
+        /**
+         * @brief The iterator of a FileIterator, default constructed one is the end iterator
+         */
+        class iterator
+        {
+            FileIterator* file = nullptr;
+        public:
+            using value_type = std::basic_string<Char>;
+            using difference_type = std::ptrdiff_t;
+            using pointer = std::basic_string<Char> const*;
+            using reference = std::basic_string<Char> const&;
+            using iterator_category = std::input_iterator_tag;
+
+            iterator() = default;
+            explicit iterator(FileIterator* file) :file(file && file->readLine() ? file : nullptr) {}
+
+            reference operator*() const { return file->line; }
+            pointer operator->() const { return &file->line; }
+            iterator& operator++()
+            {
+                if (!file->readLine())
+                    file = nullptr;
+                return *this;
+            }
+            bool operator==(iterator const& rhs) const { return file == rhs.file; }
+            bool operator!=(iterator const& rhs) const { return file != rhs.file; }
+        };
+
+        /**
+         * @brief Open the file
+         * @param readAhead The number of blocks to read ahead on a background thread, none by default
+         * @throw FileIOError if the file cannot be opened
+         */
+        FileIterator(path_type const& fileName, ReadAhead readAhead = {}) :fs(fileName), block(BlockSize)
+        {
+            if (!fs.is_open())
+#if __cplusplus >= 201703L
+                throw FileIOError{ fileName.string().c_str() };
+#else
+                throw FileIOError{ std::string(fileName.begin(), fileName.end()).c_str() };
+#endif
+            if (readAhead.depth != 0)
+                prefetcher = std::make_unique<File_detail::Prefetcher<Char>>(std::move(fs), BlockSize, readAhead.depth);
+        }
+        FileIterator(Char const* fileName, ReadAhead readAhead = {}) :FileIterator(path_type{ fileName }, readAhead) {}
+        FileIterator(std::basic_string<Char> const& fileName, ReadAhead readAhead = {}) :FileIterator(path_type{ fileName }, readAhead) {}
+
+#if __cplusplus >= 201703L
+        FileIterator(std::basic_string_view<Char> const fileName, ReadAhead readAhead = {}) :FileIterator(path_type{ fileName }, readAhead) {}
+        FileIterator(std::filesystem::directory_entry const& file, ReadAhead readAhead = {}) :FileIterator(file.path(), readAhead) {}
+#endif
+
+        /**
+         * @brief Read the first line and return an iterator to it
+         * @note A FileIterator can only be iterated once
+         */
+        iterator begin() { return iterator{ this }; }
+
+        /**
+         * @brief Return the end iterator
+         */
+        iterator end() const { return {}; }
+    };
+
+    namespace File_detail
+    {
+        /**
+         * @brief A buffer aligned for `O_DIRECT`, whose address, size and file offset must be multiples of the block size
+         */
+        struct AlignedBuffer
+        {
+            static constexpr size_t Alignment = 4096;
+
+            struct Free
+            {
+                void operator()(char* data) const { ::operator delete(data, std::align_val_t{ Alignment }); }
+            };
+
+            std::unique_ptr<char, Free> data;
+
+            explicit AlignedBuffer(size_t size) :data(static_cast<char*>(::operator new(size, std::align_val_t{ Alignment }))) {}
+        };
+    }
+
+    /**
+     * @brief Read a file once from start to end without going through the page cache, as chunks or line by line
+     * @details
+     * For one-pass scans of files larger than the memory, reading through the page cache evicts the hot data of the
+     * other processes. A DirectReader opens the file with `O_DIRECT` on Linux, or `F_NOCACHE` on macOS, and `depth` background
+     * threads keep as many aligned reads of `chunkSize` bytes in flight ahead of the consumer, so the device sees a queue of
+     * reads instead of one at a time.
+     *
+     * Where the file system does not support `O_DIRECT`, like tmpfs, it falls back to buffered reads, and drops every
+     * chunk from the page cache with `POSIX_FADV_DONTNEED` once it is read. @ref direct tells which way is used.
+     * Use either @ref nextChunk or the lines, like a @ref FileIterator:
+     * ~~~~{.cpp}
+     *     for (auto const& line : DirectReader{ "huge.csv" })
+     *         ...
+     *     DirectReader reader{ "huge.bin" };
+     *     for (auto chunk = reader.nextChunk(); !chunk.empty(); chunk = reader.nextChunk())
+     *         ...
+     * ~~~~
+     */
+    class DirectReader
+    {
+        struct Chunk
+        {
+            File_detail::AlignedBuffer buffer;
+            size_t size;
+        };
+
+#if defined(__unix__) || defined(__APPLE__)
+        int fd = -1;
+#else
+        std::FILE* file = nullptr;
+#endif
+        std::string name;
+        size_t chunkSize;
+        std::atomic<bool> isDirect{ false };     //cleared by a reader thread if O_DIRECT reads fail
+        static constexpr std::uint64_t NoIndex = (std::numeric_limits<std::uint64_t>::max)();
+        std::mutex mutex;
+        std::condition_variable changed;
+        std::map<std::uint64_t, Chunk> ready;   //the chunks read, by index, which may complete out of order
+        std::vector<File_detail::AlignedBuffer> spare;
+        std::uint64_t nextRead = 0;             //index of the next chunk to read
+        std::uint64_t nextIndex = 0;            //index of the next chunk to return
+        std::uint64_t endIndex = NoIndex;       //index of the first chunk past the end of the file, or which failed
+        std::uint64_t failedIndex = NoIndex;
+        bool stopping = false;
+        std::vector<std::thread> readers;
+
+        File_detail::AlignedBuffer current{ File_detail::AlignedBuffer::Alignment };
+        size_t currentSize = 0;
+        size_t position = 0;        //of the next line in `current`
+        std::string line;
+
+        /**
+         * @brief Read the chunk at `offset` into `data`, return its size, which is less than `chunkSize` only at the end of the file, or -1 on error
+         */
+        long long readAt(char* data, std::uint64_t offset)
+        {
+#if defined(__unix__) || defined(__APPLE__)
+            size_t total = 0;
+            while (total < chunkSize)
+            {
+                auto const direct = isDirect.load(std::memory_order_relaxed);
+                auto const read = ::pread(fd, data + total, chunkSize - total, static_cast<off_t>(offset + total));
+                if (read < 0 && errno == EINTR)
+                    continue;
+#ifdef O_DIRECT
+                if (read < 0 && errno == EINVAL && direct)
+                {
+                    /*the offset is aligned, so the file system does not support O_DIRECT reads*/
+                    ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) & ~O_DIRECT);
+                    isDirect = false;
+                    continue;
+                }
+#endif
+                if (read < 0)
+                    return -1;
+                total += static_cast<size_t>(read);
+                //a short read of a regular file is its end, and reading on from the unaligned offset would fail under O_DIRECT
+                if (read == 0 || direct)
+                    break;
+            }
+#if defined(POSIX_FADV_DONTNEED)
+            if (!isDirect && total != 0)
+                ::posix_fadvise(fd, static_cast<off_t>(offset), static_cast<off_t>(total), POSIX_FADV_DONTNEED);
+#endif
+            return static_cast<long long>(total);
+#else
+            (void)offset;
+            auto const read = std::fread(data, 1, chunkSize, file);
+            return std::ferror(file) ? -1 : static_cast<long long>(read);
+#endif
+        }
+
+        /**
+         * @brief Run by every reader thread: claim the next chunk whenever there is a spare buffer, until the end of the file
+         */
+        void run()
+        {
+            std::unique_lock lock{ mutex };
+            while (true)
+            {
+                changed.wait(lock, [this] { return stopping || nextRead >= endIndex || !spare.empty(); });
+                if (stopping || nextRead >= endIndex)
+                    return;
+                auto buffer = std::move(spare.back());
+                spare.pop_back();
+                auto const index = nextRead++;
+                lock.unlock();
+
+                auto const read = readAt(buffer.data.get(), index * chunkSize);
+
+                lock.lock();
+                if (read < 0)
+                {
+                    failedIndex = (std::min)(failedIndex, index);
+                    endIndex = (std::min)(endIndex, index);
+                }
+                else if (static_cast<size_t>(read) < chunkSize)
+                    endIndex = (std::min)(endIndex, read == 0 ? index : index + 1);
+                if (read > 0)
+                    ready.emplace(index, Chunk{ std::move(buffer), static_cast<size_t>(read) });
+                else
+                    spare.push_back(std::move(buffer));
+                changed.notify_all();
+            }
+        }
+
+        bool nextLine()
+        {
+            line.clear();
+            bool hasContent = false;
+            while (true)
+            {
+                if (position == currentSize && nextChunk().empty())
+                    return hasContent;
+                hasContent = true;
+                auto const first = current.data.get() + position;
+                auto const count = currentSize - position;
+                if (auto const newline = std::char_traits<char>::find(first, count, '\n'))
+                {
+                    line.append(first, static_cast<size_t>(newline - first));
+                    position += static_cast<size_t>(newline - first) + 1;
+                    return true;
+                }
+                line.append(first, count);
+                position = currentSize;
+            }
+        }
+    public:
+        /**
+         * @brief The iterator over the lines of a DirectReader, default constructed one is the end iterator
+         */
+        class iterator
+        {
+            DirectReader* reader = nullptr;
+        public:
+            using value_type = std::string;
+            using difference_type = std::ptrdiff_t;
+            using pointer = std::string const*;
+            using reference = std::string const&;
+            using iterator_category = std::input_iterator_tag;
+
+            iterator() = default;
+            explicit iterator(DirectReader* reader) :reader(reader && reader->nextLine() ? reader : nullptr) {}
+
+            reference operator*() const { return reader->line; }
+            pointer operator->() const { return &reader->line; }
+            iterator& operator++()
+            {
+                if (!reader->nextLine())
+                    reader = nullptr;
+                return *this;
+            }
+            bool operator==(iterator const& rhs) const { return reader == rhs.reader; }
+            bool operator!=(iterator const& rhs) const { return reader != rhs.reader; }
+        };
+
+        /**
+         * @brief Open the file and start reading it
+         * @param chunkSize The size of every read, rounded up to a multiple of 4096 bytes
+         * @param depth The number of reads kept in flight ahead of the consumer, each by its own thread
+         * @throw FileIOError if the file cannot be opened
+         */
+        explicit DirectReader(std::filesystem::path const& path, size_t chunkSize = 1 << 20, size_t depth = 4)
+            :name(path.string()),
+            chunkSize((std::max<size_t>(chunkSize, 1) + File_detail::AlignedBuffer::Alignment - 1) / File_detail::AlignedBuffer::Alignment * File_detail::AlignedBuffer::Alignment)
+        {
+#if defined(__unix__) || defined(__APPLE__)
+#ifdef O_DIRECT
+            fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC | O_DIRECT);
+            isDirect = fd >= 0;
+#endif
+            if (fd < 0)
+                fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0)
+                throw FileIOError{ name.c_str() };
+#if defined(F_NOCACHE)
+            isDirect = ::fcntl(fd, F_NOCACHE, 1) == 0;
+#endif
+#if defined(POSIX_FADV_SEQUENTIAL)
+            if (!isDirect)
+                ::posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+#else
+            file = std::fopen(name.c_str(), "rb");
+            if (!file)
+                throw FileIOError{ name.c_str() };
+#endif
+            depth = std::max<size_t>(depth, 1);
+            for (size_t i = 0; i < depth; ++i)
+                spare.emplace_back(this->chunkSize);
+            current = File_detail::AlignedBuffer{ this->chunkSize };
+#if !defined(__unix__) && !defined(__APPLE__)
+            depth = 1;      //std::fread reads at the position of the stream, so only one thread can read
+#endif
+            for (size_t i = 0; i < depth; ++i)
+                readers.emplace_back([this] { run(); });
+        }
+
+        DirectReader(DirectReader const&) = delete;
+        DirectReader& operator=(DirectReader const&) = delete;
+
+        ~DirectReader()
+        {
+            {
+                std::lock_guard lock{ mutex };
+                stopping = true;
+            }
+            changed.notify_all();
+            for (auto& thread : readers)
+                thread.join();
+#if defined(__unix__) || defined(__APPLE__)
+            ::close(fd);
+#else
+            std::fclose(file);
+#endif
+        }
+
+        /**
+         * @brief Return whether the page cache is bypassed, which is false when the file system does not support it
+         * @note It may turn false after the first read, when the file system only rejects `O_DIRECT` reads
+         */
+        [[nodiscard]] bool direct() const
+        {
+            return isDirect.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Return the next chunk of the file, which is empty at the end, and valid until the next call
+         * @throw FileIOError if reading fails
+         */
+        std::string_view nextChunk()
+        {
+            std::unique_lock lock{ mutex };
+            changed.wait(lock, [this] { return nextIndex >= endIndex || ready.count(nextIndex) != 0; });
+            auto const chunk = ready.find(nextIndex);
+            if (chunk == ready.end())
+            {
+                if (nextIndex >= failedIndex)
+                    throw FileIOError{ name.c_str() };
+                currentSize = position = 0;
+                return {};
+            }
+            std::swap(current, chunk->second.buffer);
+            currentSize = chunk->second.size;
+            position = 0;
+            spare.push_back(std::move(chunk->second.buffer));
+            ready.erase(chunk);
+            ++nextIndex;
+            lock.unlock();
+            changed.notify_all();
+            return { current.data.get(), currentSize };
+        }
+
+        /**
+         * @brief Read the first line and return an iterator to it
+         * @note The lines are only valid until the next one is read, and a DirectReader can only be iterated once
+         */
+        iterator begin() { return iterator{ this }; }
+
+        iterator end() const { return {}; }
+    };
+
+    /**
+     * @brief Read a whole file into a long string
+     * @param fname The input file name
+     * @tparam Char The type of char of the returned string, can be either char or wchar_t
+     * @tparam EnableException To throw an IO exception or not during the operation
+     * @return A std::basic_string<Char> which contains the original content of the file
+     * @details Will construct a std::filesystem::path object to detect whether the file exist or not in C++17
+     */
+    template<bool EnableException = false, typename Char = char>
+    auto file_to_string(const char* fname)
+    {
+#if __cplusplus >= 201703L
+        if constexpr (EnableException)
+        {
+            if (std::filesystem::directory_entry{ fname }.exists())
+            {
+                std::basic_ifstream<Char> fs{ fname };
+                if (fs.is_open())
+                    return std::basic_string<Char>(std::istreambuf_iterator<Char>{fs}, std::istreambuf_iterator<Char>{});
+            }
+            else
+                throw FileIOError{ fname };
+        }
+        else
+        {
+            std::basic_ifstream<Char> fs{ fname };
+            return std::basic_string<Char>(std::istreambuf_iterator<Char>{fs}, std::istreambuf_iterator<Char>{});
+        }
+#else
+        std::basic_ifstream<Char> fs{ fname };
+        if constexpr (EnableException)
+        {
+            if (!fs.is_open())
+                throw FileIOError{ fname };
+        }
+        return std::basic_string<Char>(std::istreambuf_iterator<Char>{fs}, std::istreambuf_iterator<Char>{});
+#endif
+    }
+
+    /**
+     * @brief Read a whole file into a std::vector<Char>
+     * @param fname The input file name
+     * @tparam Char The type of char of the returned vector, can be either char or wchar_t
+     * @tparam EnableException To throw an IO exception or not during the operation
+     * @return A std::vector<Char> which contains the original content of the file
+     * @details Will construct a std::filesystem::path object to detect whether the file exist or not in C++17
+     */
+    template<bool EnableException=false, typename Char=char>
+    auto file_to_vec(const char* fname)
+    {
+#if __cplusplus >= 201703L
+        if constexpr (EnableException)
+        {
+            if (std::filesystem::directory_entry{ fname }.exists())
+            {
+                std::basic_ifstream<Char> fs{ fname };
+                if (fs.is_open())
+                    return std::vector<Char>(std::istreambuf_iterator<Char>{fs}, std::istreambuf_iterator<Char>{});
+            }
+            else
+                throw FileIOError{ fname };
+        }
+        else
+        {
+            std::basic_ifstream<Char> fs{ fname };
+            return std::vector<Char>(std::istreambuf_iterator<Char>{fs}, std::istreambuf_iterator<Char>{});
+        }
+#else
+        std::basic_ifstream<Char> fs{ fname };
+        if constexpr (EnableException)
+        {
+            if (!fs.is_open())
+                throw FileIOError{ fname };
+        }
+        return std::vector<Char>(std::istreambuf_iterator<Char>{fs}, std::istreambuf_iterator<Char>{});
+#endif
+    }
+
+    /**
+     * @brief Read a whole file into a std::vector using `allocator`, like an @ref AlignedAllocator or a @ref HugePageAllocator
+     * @param fname The input file name
+     * @param allocator The allocator of the returned vector, whose `value_type` is the type of char
+     * @tparam EnableException To throw an IO exception or not during the operation
+     * @details The vector is sized once to the file and read into with a single `read`, so a large buffer is allocated only once.
+     * The file is read in binary mode.
+     */
+    template<bool EnableException = false, typename Allocator>
+    auto file_to_vec(const char* fname, Allocator const& allocator)
+    {
+        using Char = typename std::allocator_traits<Allocator>::value_type;
+        std::vector<Char, Allocator> content(allocator);
+        std::basic_ifstream<Char> fs{ fname, std::ios::binary | std::ios::ate };
+        if (!fs.is_open())
+        {
+            if constexpr (EnableException)
+                throw FileIOError{ fname };
+            return content;
+        }
+        content.resize(static_cast<size_t>(fs.tellg()));
+        fs.seekg(0);
+        fs.read(content.data(), static_cast<std::streamsize>(content.size()));
+        content.resize(static_cast<size_t>(fs.gcount()));
+        return content;
+    }
+
+#ifdef SugarPPNamespace
+}
+#endif
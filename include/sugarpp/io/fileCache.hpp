@@ -0,0 +1,235 @@
+/*****************************************************************//**
+ * \file   fileCache.hpp
+ * \brief  A cache of whole files read into memory, revalidated by their size and modification time
+ *
+ * \author Peter
+ * \date   October 2026
+ *********************************************************************/
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <utility>
+#include "file.hpp"
+#include "../collection/hashMap.hpp"
+
+#ifdef __unix__
+#include <sys/stat.h>
+#endif
+
+#ifdef SugarPPNamespace
+namespace SugarPP
+{
+#endif
+
+    /**
+     * @brief The counters of a @ref FileCache
+     */
+    struct FileCacheStats
+    {
+        std::uint64_t hits = 0;     /**< How many times a file was returned from memory */
+        std::uint64_t misses = 0;   /**< How many times a file was read, because it was not cached or it changed */
+        size_t entries = 0;         /**< The number of cached files */
+        size_t bytes = 0;           /**< Their total size */
+    };
+
+    namespace FileCache_detail
+    {
+        /**
+         * @brief What identifies a version of a file, which changes when the file is written or replaced
+         */
+        struct Stamp
+        {
+            std::uintmax_t size = 0;
+            std::int64_t modified = 0;      //in nanoseconds
+            std::uint64_t inode = 0;
+            std::uint64_t device = 0;
+
+            bool operator==(Stamp const& rhs) const
+            {
+                return size == rhs.size && modified == rhs.modified && inode == rhs.inode && device == rhs.device;
+            }
+            bool operator!=(Stamp const& rhs) const { return !(*this == rhs); }
+        };
+
+        /**
+         * @brief Return the stamp of the file at `path` with a single `stat` where available
+         * @throw FileIOError if `path` is not a regular file
+         */
+        inline Stamp stampOf(std::filesystem::path const& path)
+        {
+#ifdef __unix__
+            struct stat status;
+            if (::stat(path.c_str(), &status) != 0 || !S_ISREG(status.st_mode))
+                throw FileIOError{ path.c_str() };
+#if defined(__APPLE__)
+            auto const& time = status.st_mtimespec;
+#else
+            auto const& time = status.st_mtim;
+#endif
+            return { static_cast<std::uintmax_t>(status.st_size), static_cast<std::int64_t>(time.tv_sec) * 1000000000 + time.tv_nsec,
+                static_cast<std::uint64_t>(status.st_ino), static_cast<std::uint64_t>(status.st_dev) };
+#else
+            std::error_code error;
+            auto const size = std::filesystem::file_size(path, error);
+            if (error)
+                throw FileIOError{ path.string().c_str() };
+            auto const modified = std::filesystem::last_write_time(path, error);
+            if (error)
+                throw FileIOError{ path.string().c_str() };
+            return { size, static_cast<std::int64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(modified.time_since_epoch()).count()), 0, 0 };
+#endif
+        }
+    }
+
+    /**
+     * @brief A thread-safe cache of files read into memory, for the templates and configurations read over and over
+     * @details
+     * @ref get returns the content of a file as a shared immutable string. A cached file is checked with one `stat` per call,
+     * comparing its size, modification time and inode with those when it was read, so that a modified or replaced file is read again.
+     * With `revalidateAfter`, a file checked less than that long ago is returned without a `stat`, at the cost of seeing
+     * changes late. When the cached files exceed `budget` bytes, the least recently used ones are evicted. The strings
+     * already returned stay valid, as they are shared.
+     * ~~~~{.cpp}
+     *     FileCache templates{ 64 << 20 };
+     *     auto const page = templates.get("templates/index.html");     //std::shared_ptr<std::string const>
+     * ~~~~
+     */
+    class FileCache
+    {
+        using Key = std::filesystem::path::string_type;
+        using Clock = std::chrono::steady_clock;
+
+        struct Entry
+        {
+            Key key;
+            std::shared_ptr<std::string const> content;
+            FileCache_detail::Stamp stamp;
+            Clock::time_point checked;
+        };
+
+        size_t budget;
+        Clock::duration revalidateAfter;
+        mutable std::mutex mutex;
+        std::list<Entry> entries;                              //the most recently used first
+        HashMap<Key, std::list<Entry>::iterator> index;
+        size_t bytes = 0;
+        std::uint64_t hits = 0;
+        std::uint64_t misses = 0;
+
+        std::shared_ptr<std::string const> hit(std::list<Entry>::iterator entry)
+        {
+            entries.splice(entries.begin(), entries, entry);
+            ++hits;
+            return entry->content;
+        }
+
+        void remove(std::list<Entry>::iterator entry)
+        {
+            bytes -= entry->content->size();
+            index.erase(entry->key);
+            entries.erase(entry);
+        }
+
+        static std::shared_ptr<std::string const> read(std::filesystem::path const& path, std::uintmax_t size)
+        {
+            std::ifstream fs{ path, std::ios::binary };
+            if (!fs.is_open())
+                throw FileIOError{ path.string().c_str() };
+            auto content = std::make_shared<std::string>(static_cast<size_t>(size), '\0');
+            fs.read(content->data(), static_cast<std::streamsize>(size));
+            content->resize(static_cast<size_t>(fs.gcount()));
+            return content;
+        }
+    public:
+        /**
+         * @param budget The maximum total size in bytes of the cached files. A larger file is returned without being cached
+         * @param revalidateAfter How long a checked file is trusted without checking it again, none by default
+         */
+        explicit FileCache(size_t budget = 64 << 20, Clock::duration revalidateAfter = {}) :budget(budget), revalidateAfter(revalidateAfter) {}
+
+        FileCache(FileCache const&) = delete;
+        FileCache& operator=(FileCache const&) = delete;
+
+        /**
+         * @brief Return the content of the file at `path`, from memory if it did not change since it was cached
+         * @throw FileIOError if `path` is not a regular file or cannot be read
+         */
+        [[nodiscard]] std::shared_ptr<std::string const> get(std::filesystem::path const& path)
+        {
+            auto const& key = path.native();
+            if (revalidateAfter != Clock::duration::zero())
+            {
+                std::lock_guard lock{ mutex };
+                if (auto const found = index.find(key); found != index.end() && Clock::now() - found->second->checked < revalidateAfter)
+                    return hit(found->second);
+            }
+
+            auto const stamp = FileCache_detail::stampOf(path);
+            {
+                std::lock_guard lock{ mutex };
+                if (auto const found = index.find(key); found != index.end() && found->second->stamp == stamp)
+                {
+                    found->second->checked = Clock::now();
+                    return hit(found->second);
+                }
+            }
+
+            /*read without holding the lock, so that hits on other files are not blocked meanwhile*/
+            auto content = read(path, stamp.size);
+            std::lock_guard lock{ mutex };
+            ++misses;
+            if (auto const found = index.find(key); found != index.end())
+                remove(found->second);
+            if (content->size() <= budget)
+            {
+                entries.push_front({ key, content, stamp, Clock::now() });
+                index.try_emplace(key, entries.begin());
+                bytes += content->size();
+                while (bytes > budget)
+                    remove(std::prev(entries.end()));
+            }
+            return content;
+        }
+
+        /**
+         * @brief Forget the file at `path`, so that the next @ref get reads it again
+         */
+        void invalidate(std::filesystem::path const& path)
+        {
+            std::lock_guard lock{ mutex };
+            if (auto const found = index.find(path.native()); found != index.end())
+                remove(found->second);
+        }
+
+        /**
+         * @brief Forget every file
+         */
+        void clear()
+        {
+            std::lock_guard lock{ mutex };
+            index.clear();
+            entries.clear();
+            bytes = 0;
+        }
+
+        [[nodiscard]] FileCacheStats stats() const
+        {
+            std::lock_guard lock{ mutex };
+            return { hits, misses, entries.size(), bytes };
+        }
+    };
+
+#ifdef SugarPPNamespace
+}
+#endif
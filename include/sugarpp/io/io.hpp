@@ -11,14 +11,13 @@
 #include <iostream>
 #include <string>
 #include <tuple>
-#include <fstream>
 #include <mutex>
-#include <vector>
 #include <typeinfo>     //for typeid().name
+#include <iterator>
+#include "../traits/traits.hpp"
 
 #if __cplusplus >= 201703L
 #include <string_view>
-#include <filesystem>
 #endif
 
 #ifdef SugarPPNamespace
@@ -157,39 +156,9 @@ namespace SugarPP
 
     namespace detail
     {
-
-        template<typename T>
-        struct is_tuple_impl : std::false_type {};
-
-        template<typename... Ts>
-        struct is_tuple_impl<std::tuple<Ts...>> : std::true_type {};
-
-        template<typename T>
-        struct is_tuple : is_tuple_impl<std::decay_t<T>> {};
-
-        template<typename T, typename = void>
-        struct iterable_impl :std::false_type {};
-
-        template<typename T>
-        struct iterable_impl<T, decltype(std::begin(std::declval<T>()), void())> :std::true_type {};  //still works even when T is const
-
-        template<typename T>
-        struct iterable :iterable_impl
-        <
-            std::conditional_t
-            <
-                std::is_array_v<std::remove_reference_t<T>>,
-                T,
-                std::decay_t<T>
-            >
-        > {};
-
-
-        template<typename T, std::ostream& os = std::cout, typename = void>
-        struct printable :std::false_type {};
-
-        template<typename T, std::ostream& os>
-        struct printable<T, os, decltype(os << std::declval<T>(), void())> :std::true_type {};
+        using Traits_detail::is_tuple;
+        using Traits_detail::iterable;
+        using Traits_detail::printable;
 
         template<char delim = ' ', std::ostream& os = std::cout, typename T>
         void print_impl(T&& arg)
@@ -330,118 +299,11 @@ namespace SugarPP
         }
     };
 
-    struct FileIOError:std::runtime_error
-    {
-        FileIOError(const char* const fileName):std::runtime_error(std::string{fileName}+" causes a file IO error"){}
-    };
-
-    template<typename Char = char>
-    class FileIterator
-    {
-        std::ifstream fs;
-    public:
-        using value_type = std::basic_string<Char>;
-        using difference_type = std::ptrdiff_t;
-        using pointer = std::basic_string<Char>*;
-        using reference = std::basic_string<Char>&;
-        using iterator_category = std::forward_iterator_tag;
-
-        FileIterator(Char const* fileName);
-        FileIterator(std::basic_string<Char> const& fileName);
-
-#if __cplusplus >= 201703L
-        FileIterator(std::basic_string_view<Char> const fileName);
-        FileIterator(std::filesystem::directory_entry const& file);
-#endif
-        value_type operator*() const
-        {
-
-        }
-        FileIterator& operator++()
-        {
-
-        }
-
-    };
-
-    /**
-     * @brief Read a whole file into a long string
-     * @param fname The input file name
-     * @tparam Char The type of char of the returned string, can be either char or wchar_t
-     * @tparam EnableException To throw an IO exception or not during the operation
-     * @return A std::basic_string<Char> which contains the original content of the file
-     * @details Will construct a std::filesystem::path object to detect whether the file exist or not in C++17
-     */
-    template<bool EnableException = false, typename Char = char>
-    auto file_to_string(const char* fname)
-    {
-#if __cplusplus >= 201703L
-        if constexpr (EnableException)
-        {
-            if (std::filesystem::directory_entry{ fname }.exists())
-            {
-                std::basic_ifstream<Char> fs{ fname };
-                if (fs.is_open())
-                    return std::basic_string<Char>(std::istreambuf_iterator<Char>{fs}, std::istreambuf_iterator<Char>{});
-            }
-            else
-                throw FileIOError{ fname };
-        }
-        else
-        {
-            std::basic_ifstream<Char> fs{ fname };
-            return std::basic_string<Char>(std::istreambuf_iterator<Char>{fs}, std::istreambuf_iterator<Char>{});
-        }
-#else
-        std::basic_ifstream<Char> fs{ fname };
-        if constexpr (EnableException)
-        {
-            if (!fs.is_open())
-                throw FileIOError{ fname };
-        }
-        return std::basic_string<Char>(std::istreambuf_iterator<Char>{fs}, std::istreambuf_iterator<Char>{});
+#ifdef SugarPPNamespace
+}
 #endif
-    }
 
-    /**
-     * @brief Read a whole file into a std::vector<Char>
-     * @param fname The input file name
-     * @tparam Char The type of char of the returned vector, can be either char or wchar_t
-     * @tparam EnableException To throw an IO exception or not during the operation
-     * @return A std::vector<Char> which contains the original content of the file
-     * @details Will construct a std::filesystem::path object to detect whether the file exist or not in C++17
-     */
-    template<bool EnableException=false, typename Char=char>
-    auto file_to_vec(const char* fname)
-    {
-#if __cplusplus >= 201703L
-        if constexpr (EnableException)
-        {
-            if (std::filesystem::directory_entry{ fname }.exists())
-            {
-                std::basic_ifstream<Char> fs{ fname };
-                if (fs.is_open())
-                    return std::vector<Char>(std::istreambuf_iterator<Char>{fs}, std::istreambuf_iterator<Char>{});
-            }
-            else
-                throw FileIOError{ fname };
-        }
-        else
-        {
-            std::basic_ifstream<Char> fs{ fname };
-            return std::vector<Char>(std::istreambuf_iterator<Char>{fs}, std::istreambuf_iterator<Char>{});
-        }
-#else
-        std::basic_ifstream<Char> fs{ fname };
-        if constexpr (EnableException)
-        {
-            if (!fs.is_open())
-                throw FileIOError{ fname };
-        }
-        return std::vector<Char>(std::istreambuf_iterator<Char>{fs}, std::istreambuf_iterator<Char>{});
+/*FileIterator and the file functions used to be here, so they are still included unless SugarPPLeanHeaders is defined*/
+#ifndef SugarPPLeanHeaders
+#include "file.hpp"
 #endif
-    }
-
-#ifdef SugarPPNamespace
-}
-#endif
\ No newline at end of file
@@ -0,0 +1,190 @@
+/*****************************************************************//**
+ * \file   log.hpp
+ * \brief  Leveled logging through @ref ThreadSafe, which costs one relaxed atomic load when the level is disabled
+ *
+ * \author Peter
+ * \date   October 2026
+ * \note Define SugarPPLogLevel to the number of the lowest @ref Level to compile, like `-DSugarPPLogLevel=2` to remove the
+ * trace and debug messages from the program entirely. Every level is compiled by default.
+ *********************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <type_traits>
+#include <utility>
+#include "io.hpp"
+
+#ifndef SugarPPLogLevel
+#define SugarPPLogLevel 0
+#endif
+
+#ifdef SugarPPNamespace
+namespace SugarPP
+{
+#endif
+
+    /**
+     * @brief The severity of a log message, in increasing order
+     */
+    enum class Level
+    {
+        Trace,      /**< 0 */
+        Debug,      /**< 1 */
+        Info,       /**< 2 */
+        Warning,    /**< 3 */
+        Error,      /**< 4 */
+        Off         /**< 5, to disable every message */
+    };
+
+    namespace Log_detail
+    {
+        /**
+         * @brief The messages below this level are removed at compile time
+         */
+        inline constexpr Level compiledLevel = static_cast<Level>(SugarPPLogLevel);
+
+        inline std::atomic<Level>& runtimeLevel()
+        {
+            static std::atomic<Level> level{ Level::Info };
+            return level;
+        }
+
+        constexpr char const* prefix(Level level)
+        {
+            constexpr char const* names[]{ "[Trace]", "[Debug]", "[Info]", "[Warning]", "[Error]", "[Off]" };
+            return names[static_cast<int>(level)];
+        }
+
+        /**
+         * @brief Call an argument which is a function without parameters, so that it is only computed when the message is written
+         */
+        template<typename T>
+        decltype(auto) evaluate(T&& arg)
+        {
+            if constexpr (std::is_invocable_v<T&> && !Traits_detail::printable<T>::value)
+                return arg();
+            else
+                return std::forward<T>(arg);
+        }
+
+        /**
+         * @brief The base of the limiters passed as the first argument of @ref log
+         */
+        struct Limiter {};
+
+        template<typename T>
+        using is_limiter = std::is_base_of<Limiter, std::remove_cv_t<std::remove_reference_t<T>>>;
+    }
+
+    /**
+     * @brief Set the lowest level logged at run time, which is @ref Level::Info by default
+     */
+    inline void setLogLevel(Level level)
+    {
+        Log_detail::runtimeLevel().store(level, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Return the lowest level logged at run time
+     */
+    inline Level logLevel()
+    {
+        return Log_detail::runtimeLevel().load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Return whether messages of `level` are logged, which is free at compile time when `level` is below SugarPPLogLevel
+     */
+    template<Level level>
+    bool logEnabled()
+    {
+        if constexpr (level < Log_detail::compiledLevel || level == Level::Off)
+            return false;
+        else
+            return level >= logLevel();
+    }
+
+    /**
+     * @brief Let one call in every `n` through, to sample a message logged in a hot loop
+     * @details It is shared by the threads, so keep it `static` at the call site:
+     * ~~~~{.cpp}
+     *     static LogEvery every{ 1000 };
+     *     log<Level::Debug>(every, "processed", i);
+     * ~~~~
+     */
+    class LogEvery : Log_detail::Limiter
+    {
+        std::atomic<std::uint64_t> calls{ 0 };
+        std::uint64_t n;
+    public:
+        explicit LogEvery(std::uint64_t n) :n(n == 0 ? 1 : n) {}
+
+        bool allow() { return calls.fetch_add(1, std::memory_order_relaxed) % n == 0; }
+    };
+
+    /**
+     * @brief Let through at most `perSecond` calls per second on average, and bursts of up to `burst` calls
+     * @details A lock-free token bucket, in the form of the generic cell rate algorithm. Keep it `static` at the call site like @ref LogEvery.
+     */
+    class LogRate : Log_detail::Limiter
+    {
+        using Clock = std::chrono::steady_clock;
+        std::atomic<std::int64_t> theoreticalArrival{ 0 };    //in nanoseconds of Clock
+        std::int64_t interval;
+        std::int64_t tolerance;
+    public:
+        explicit LogRate(double perSecond, unsigned burst = 1)
+            :interval(static_cast<std::int64_t>(1e9 / (perSecond > 0 ? perSecond : 1e-9))), tolerance(interval * static_cast<std::int64_t>(burst == 0 ? 0 : burst - 1))
+        {
+        }
+
+        bool allow()
+        {
+            auto const now = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+            auto arrival = theoreticalArrival.load(std::memory_order_relaxed);
+            while (true)
+            {
+                if (now < arrival - tolerance)
+                    return false;
+                auto const next = (arrival > now ? arrival : now) + interval;
+                if (theoreticalArrival.compare_exchange_weak(arrival, next, std::memory_order_relaxed))
+                    return true;
+            }
+        }
+    };
+
+    /**
+     * @brief Write `args` with the name of `level` in front to `os` through @ref ThreadSafe, if `level` is enabled
+     * @details
+     * Nothing is formatted and no lock is taken when `level` is below the run time level, and the call is removed when it is
+     * below SugarPPLogLevel. The arguments are still evaluated by the caller, so pass the expensive ones as functions without
+     * parameters, which are only called when the message is written:
+     * ~~~~{.cpp}
+     *     log<Level::Debug>("state:", [&] { return dump(state); });
+     * ~~~~
+     * If the first argument is a @ref LogEvery or a @ref LogRate, it decides whether an enabled message is written.
+     */
+    template<Level level, std::ostream& os = std::clog, typename First, typename... Args>
+    void log(First&& first, Args&&... args)
+    {
+        if constexpr (level >= Log_detail::compiledLevel && level != Level::Off)
+        {
+            if (!logEnabled<level>())
+                return;
+            if constexpr (Log_detail::is_limiter<First>::value)
+            {
+                if (first.allow())
+                    ThreadSafe<os>::print(Log_detail::prefix(level), Log_detail::evaluate(std::forward<Args>(args))...);
+            }
+            else
+                ThreadSafe<os>::print(Log_detail::prefix(level), Log_detail::evaluate(std::forward<First>(first)), Log_detail::evaluate(std::forward<Args>(args))...);
+        }
+    }
+
+#ifdef SugarPPNamespace
+}
+#endif
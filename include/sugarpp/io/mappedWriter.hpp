@@ -0,0 +1,284 @@
+/*****************************************************************//**
+ * \file   mappedWriter.hpp
+ * \brief  Writing a file through a preallocated memory mapping, with @ref print-style formatting straight into it
+ *
+ * \author Peter
+ * \date   October 2026
+ * \note Where memory mapping is not available, the text is kept in memory and written to the file when it is closed
+ *********************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include "file.hpp"
+
+#if __has_include(<version>)
+#include <version>
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+#define SugarPPMappedWriterMmap
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#ifdef SugarPPNamespace
+namespace SugarPP
+{
+#endif
+
+    /**
+     * @brief Write a large file, like a report or a dump, directly into its memory mapping
+     * @details
+     * The file is allocated with `expectedSize` bytes up front and mapped, so writing is a copy into memory, without a
+     * `write` call per buffer like `std::ofstream`. Numbers are formatted with `std::to_chars` right into the mapping.
+     * When the text outgrows the file, it is extended and remapped, at least doubling its size. @ref close truncates it
+     * to the bytes written, and is called by the destructor.
+     * ~~~~{.cpp}
+     *     MappedWriter report{ "report.txt", 64 << 20 };
+     *     for (auto const& [name, total] : totals)
+     *         report.print(name, total);   //name 12.5\n
+     * ~~~~
+     */
+    class MappedWriter
+    {
+        std::string name;
+        char* data = nullptr;
+        size_t capacity = 0;
+        size_t length = 0;
+#ifdef SugarPPMappedWriterMmap
+        int fd = -1;
+#else
+        std::unique_ptr<char[]> memory;
+#endif
+
+        /**
+         * @brief Make the file and the mapping `newCapacity` bytes long
+         */
+        void resize(size_t newCapacity)
+        {
+#ifdef SugarPPMappedWriterMmap
+            auto const page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+            newCapacity = (std::max<size_t>(newCapacity, 1) + page - 1) / page * page;
+#if defined(__linux__)
+            /*allocate the blocks now, so that writing to the mapping cannot fail with SIGBUS on a full disk*/
+            auto const allocated = ::posix_fallocate(fd, 0, static_cast<off_t>(newCapacity));
+            if (allocated == ENOSPC || (allocated != 0 && ::ftruncate(fd, static_cast<off_t>(newCapacity)) != 0))
+                throw FileIOError{ name.c_str() };
+#else
+            if (::ftruncate(fd, static_cast<off_t>(newCapacity)) != 0)
+                throw FileIOError{ name.c_str() };
+#endif
+            /*on failure the old mapping is kept, so what was written is still there for close to truncate the file to*/
+#if defined(__linux__) && defined(MREMAP_MAYMOVE)
+            auto const mapped = data
+                ? ::mremap(data, capacity, newCapacity, MREMAP_MAYMOVE)
+                : ::mmap(nullptr, newCapacity, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            if (mapped == MAP_FAILED)
+                throw FileIOError{ name.c_str() };
+#else
+            auto const mapped = ::mmap(nullptr, newCapacity, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            if (mapped == MAP_FAILED)
+                throw FileIOError{ name.c_str() };
+            if (data)
+                ::munmap(data, capacity);
+#endif
+            data = static_cast<char*>(mapped);
+#else
+            auto grown = std::make_unique<char[]>(newCapacity);
+            std::memcpy(grown.get(), data, length);
+            memory = std::move(grown);
+            data = memory.get();
+#endif
+            capacity = newCapacity;
+        }
+
+        /**
+         * @brief Return where to write `size` more bytes
+         */
+        char* reserve(size_t size)
+        {
+            if (length + size > capacity)
+                resize(std::max(length + size, capacity * 2));
+            return data + length;
+        }
+
+        template<typename T>
+        void format(T const& arg)
+        {
+            using Type = std::decay_t<T>;
+            if constexpr (std::is_same_v<Type, bool>)
+                write(arg ? "True" : "False");
+            else if constexpr (std::is_same_v<Type, char> || std::is_same_v<Type, signed char> || std::is_same_v<Type, unsigned char>)
+                put(static_cast<char>(arg));    //like std::ostream, so std::int8_t is a character too
+            else if constexpr (std::is_integral_v<Type>)
+            {
+                /*digits10 is one short of the longest number, and one more for the sign*/
+                constexpr auto maxSize = static_cast<size_t>(std::numeric_limits<Type>::digits10) + 2;
+                auto const first = reserve(maxSize);
+                length = static_cast<size_t>(std::to_chars(first, first + maxSize, arg).ptr - data);
+            }
+            else if constexpr (std::is_floating_point_v<Type>)
+            {
+                /*the same as the default precision of std::ostream, so that it writes like print*/
+#ifdef __cpp_lib_to_chars
+                auto const first = reserve(32);
+                length = static_cast<size_t>(std::to_chars(first, first + 32, arg, std::chars_format::general, 6).ptr - data);
+#else
+                auto const first = reserve(32);
+                length += static_cast<size_t>(std::snprintf(first, 32, "%g", static_cast<double>(arg)));
+#endif
+            }
+            else if constexpr (std::is_convertible_v<T const&, std::string_view>)
+                write(std::string_view{ arg });
+            else
+            {
+                std::ostringstream os;
+                os << arg;
+                write(os.str());
+            }
+        }
+    public:
+        /**
+         * @brief Create or truncate the file at `path`, and allocate and map `expectedSize` bytes of it
+         * @throw FileIOError if the file cannot be created or mapped
+         */
+        explicit MappedWriter(std::filesystem::path const& path, size_t expectedSize = 1 << 20) :name(path.string())
+        {
+#ifdef SugarPPMappedWriterMmap
+            fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+            if (fd < 0)
+                throw FileIOError{ name.c_str() };
+            try
+            {
+                resize(expectedSize);
+            }
+            catch (...)
+            {
+                ::close(fd);
+                throw;
+            }
+#else
+            if (auto const file = std::fopen(name.c_str(), "wb"))
+                std::fclose(file);
+            else
+                throw FileIOError{ name.c_str() };
+            resize(expectedSize);
+#endif
+        }
+
+        MappedWriter(MappedWriter const&) = delete;
+        MappedWriter& operator=(MappedWriter const&) = delete;
+
+        ~MappedWriter()
+        {
+            try
+            {
+                close();
+            }
+            catch (FileIOError const&)
+            {
+            }
+        }
+
+        /**
+         * @brief Write `text` as is
+         */
+        void write(std::string_view text)
+        {
+            std::memcpy(reserve(text.size()), text.data(), text.size());
+            length += text.size();
+        }
+
+        /**
+         * @brief Write a character
+         */
+        void put(char c)
+        {
+            *reserve(1) = c;
+            ++length;
+        }
+
+        /**
+         * @brief Write the arguments separated by `delim` and a new line, formatted like @ref print
+         * @details Numbers, `bool`, characters and strings are formatted straight into the file, other types go through their `operator<<`.
+         */
+        template<char delim = ' ', typename... Args>
+        void print(Args const&... args)
+        {
+            bool first = true;
+            ((first ? void() : put(delim), format(args), first = false), ...);
+            put('\n');
+        }
+
+        /**
+         * @brief Return the number of bytes written
+         */
+        [[nodiscard]] size_t size() const { return length; }
+
+        /**
+         * @brief Write the modified pages to the disk now, blocking until they are written
+         */
+        void flush()
+        {
+#ifdef SugarPPMappedWriterMmap
+            if (data && ::msync(data, capacity, MS_SYNC) != 0)
+                throw FileIOError{ name.c_str() };
+#endif
+        }
+
+        /**
+         * @brief Unmap the file and truncate it to the bytes written. Nothing can be written afterward
+         * @param sync Whether to write the pages to the disk before returning, otherwise the system writes them later
+         * @throw FileIOError if the file cannot be truncated
+         */
+        void close(bool sync = false)
+        {
+#ifdef SugarPPMappedWriterMmap
+            if (fd < 0)
+                return;
+            if (sync)
+                flush();
+            if (data)
+                ::munmap(data, capacity);
+            data = nullptr;
+            capacity = 0;
+            auto const truncated = ::ftruncate(fd, static_cast<off_t>(length)) == 0 && (!sync || ::fsync(fd) == 0);
+            ::close(fd);
+            fd = -1;
+            if (!truncated)
+                throw FileIOError{ name.c_str() };
+#else
+            if (!data)
+                return;
+            auto const file = std::fopen(name.c_str(), "wb");
+            auto const written = file && std::fwrite(data, 1, length, file) == length;
+            if (file)
+                std::fclose(file);
+            memory.reset();
+            data = nullptr;
+            capacity = 0;
+            if (!written)
+                throw FileIOError{ name.c_str() };
+#endif
+        }
+    };
+
+#ifdef SugarPPNamespace
+}
+#endif
@@ -0,0 +1,302 @@
+/*****************************************************************//**
+ * \file   scan.hpp
+ * \brief  Parsing a line into typed fields with a pattern, like `scanf` but type-safe and without streams
+ *
+ * \author Peter
+ * \date   October 2026
+ * \note The pattern is checked at compile time in C++20, with `consteval`, and when @ref scan is called in C++17
+ *********************************************************************/
+
+#pragma once
+
+#include <charconv>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#if __has_include(<version>)
+#include <version>
+#endif
+
+#ifdef __cpp_consteval
+#define SugarPPScanConsteval consteval
+#else
+#define SugarPPScanConsteval constexpr
+#endif
+
+#ifdef SugarPPNamespace
+namespace SugarPP
+{
+#endif
+
+    namespace Scan_detail
+    {
+        constexpr size_t invalid = static_cast<size_t>(-1);
+
+        constexpr bool isSpace(char c)
+        {
+            return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+        }
+
+        /**
+         * @brief Return the number of `{}` in `pattern`, or `invalid` if it has a brace which is neither a `{}` nor doubled
+         */
+        constexpr size_t countFields(std::string_view pattern)
+        {
+            size_t count = 0;
+            for (size_t i = 0; i < pattern.size(); ++i)
+            {
+                if (pattern[i] != '{' && pattern[i] != '}')
+                    continue;
+                if (i + 1 == pattern.size())
+                    return invalid;
+                if (pattern[i] == '{' && pattern[i + 1] == '}')
+                    ++count;
+                else if (pattern[i + 1] != pattern[i])
+                    return invalid;
+                ++i;
+            }
+            return count;
+        }
+
+        /**
+         * @brief Not constexpr, so that calling it while checking a pattern at compile time is an error
+         */
+        inline void invalidPattern()
+        {
+            throw std::invalid_argument{ "the scan pattern does not have one {} per type, or has an unmatched brace" };
+        }
+
+        template<typename T>
+        constexpr bool is_text_v = std::is_same_v<T, std::string_view> || std::is_same_v<T, std::string>;
+
+        template<typename T>
+        constexpr bool is_scannable_v = std::is_arithmetic_v<T> || is_text_v<T>;
+
+        /**
+         * @brief Matches a text against a pattern, with `{}` for the fields
+         */
+        class Cursor
+        {
+            std::string_view pattern;
+            std::string_view text;
+            size_t p = 0;
+            size_t t = 0;
+
+            void skipSpaces()
+            {
+                while (t < text.size() && isSpace(text[t]))
+                    ++t;
+            }
+
+            /**
+             * @brief Return where a text field ends: at the next literal of the pattern, at a space, or at the end
+             */
+            size_t fieldEnd() const
+            {
+                auto const isEnd = p == pattern.size();
+                auto const next = isEnd ? '\0' : pattern[p];
+                if (isEnd || isSpace(next) || (next == '{' && pattern[p + 1] == '}'))
+                {
+                    auto end = t;
+                    while (end < text.size() && (isEnd || !isSpace(text[end])))
+                        ++end;
+                    if (isEnd)
+                    {
+                        while (end > t && isSpace(text[end - 1]))
+                            --end;
+                    }
+                    return end;
+                }
+                auto const found = text.find(next, t);
+                return found == std::string_view::npos ? text.size() : found;
+            }
+
+            template<typename T>
+            bool parseNumber(T& value)
+            {
+#if !defined(__cpp_lib_to_chars)
+                if constexpr (std::is_floating_point_v<T>)
+                {
+                    /*std::from_chars of floating point is not available everywhere, and strtod needs a null-terminated string*/
+                    auto end = t;
+                    while (end < text.size() && !isSpace(text[end]))
+                        ++end;
+                    std::string const copy{ text.substr(t, end - t) };
+                    char* parsed = nullptr;
+                    value = static_cast<T>(std::strtod(copy.c_str(), &parsed));
+                    if (parsed == copy.c_str())
+                        return false;
+                    t += static_cast<size_t>(parsed - copy.c_str());
+                    return true;
+                }
+                else
+#endif
+                {
+                    auto const result = std::from_chars(text.data() + t, text.data() + text.size(), value);
+                    if (result.ec != std::errc{})
+                        return false;
+                    t = static_cast<size_t>(result.ptr - text.data());
+                    return true;
+                }
+            }
+        public:
+            Cursor(std::string_view pattern, std::string_view text) :pattern(pattern), text(text) {}
+
+            /**
+             * @brief Match the pattern up to the next `{}`, or to its end, where only spaces may be left in the text
+             */
+            bool matchLiteral()
+            {
+                while (p < pattern.size())
+                {
+                    auto const c = pattern[p];
+                    if (c == '{' && pattern[p + 1] == '}')
+                        return true;
+                    if (isSpace(c))
+                    {
+                        while (p < pattern.size() && isSpace(pattern[p]))
+                            ++p;
+                        skipSpaces();
+                        continue;
+                    }
+                    if (t == text.size() || text[t] != c)
+                        return false;
+                    ++t;
+                    p += (c == '{' || c == '}') ? 2 : 1;
+                }
+                skipSpaces();
+                return t == text.size();
+            }
+
+            /**
+             * @brief Parse the field of the current `{}` into `value`
+             */
+            template<typename T>
+            bool parse(T& value)
+            {
+                p += 2;
+                if constexpr (std::is_same_v<T, bool>)
+                {
+                    for (auto [word, result] : { std::pair{ "true", true }, std::pair{ "false", false }, std::pair{ "True", true },
+                        std::pair{ "False", false }, std::pair{ "1", true }, std::pair{ "0", false } })
+                    {
+                        if (text.substr(t).substr(0, std::char_traits<char>::length(word)) == word)
+                        {
+                            value = result;
+                            t += std::char_traits<char>::length(word);
+                            return true;
+                        }
+                    }
+                    return false;
+                }
+                else if constexpr (std::is_same_v<T, char>)
+                {
+                    if (t == text.size())
+                        return false;
+                    value = text[t++];
+                    return true;
+                }
+                else if constexpr (is_text_v<T>)
+                {
+                    auto const end = fieldEnd();
+                    value = T{ text.substr(t, end - t) };
+                    t = end;
+                    return true;
+                }
+                else
+                    return parseNumber(value);
+            }
+        };
+
+        template<typename Tuple, size_t... I>
+        bool scanInto(Cursor& cursor, Tuple& fields, std::index_sequence<I...>)
+        {
+            return ((cursor.matchLiteral() && cursor.parse(std::get<I>(fields))) && ...) && cursor.matchLiteral();
+        }
+
+        template<typename T>
+        struct type_identity
+        {
+            using type = T;
+        };
+    }
+
+    /**
+     * @brief The pattern of @ref scan, which is checked to have one `{}` per type when it is constructed
+     * @details In C++20 its constructor is `consteval`, so a wrong pattern does not compile, like `std::format_string`.
+     */
+    template<typename... Ts>
+    class ScanFormat
+    {
+        std::string_view pattern;
+    public:
+        SugarPPScanConsteval ScanFormat(char const* pattern) :pattern(pattern)
+        {
+            if (Scan_detail::countFields(this->pattern) != sizeof...(Ts))
+                Scan_detail::invalidPattern();
+        }
+
+        [[nodiscard]] constexpr std::string_view get() const { return pattern; }
+    };
+
+    /**
+     * @brief Parse `line` into a tuple of `Ts...` with `pattern`, where each `{}` is a field, in one pass without streams
+     * @details
+     * The rest of the pattern must appear as is in the line, except that spaces in the pattern match any number of spaces,
+     * and `{{` and `}}` match single braces. Spaces at the end of the line are ignored. The fields are parsed by type:
+     * - integers and floating point numbers with `std::from_chars`, so in the C locale and without a leading `+`
+     * - `bool` from `true`, `false`, `True`, `False`, `1` or `0`
+     * - `char` from a single character
+     * - `std::string_view` and `std::string` up to the character following the `{}` in the pattern, or up to a space if it is
+     *   followed by a space, or up to the end of the line if it is the last thing in the pattern. A `std::string_view` refers to `line`.
+     * ~~~~{.cpp}
+     *     if (auto const fields = scan<int, double, std::string_view>(line, "{} {} {}"))
+     *         auto const [id, price, name] = *fields;
+     *     auto const [key, value] = *scan<std::string_view, std::string_view>("path = /tmp", "{} = {}");
+     * ~~~~
+     * @return `std::nullopt` if `line` does not match the pattern
+     * @throw std::invalid_argument in C++17 if the pattern does not have one `{}` per type
+     */
+    template<typename... Ts>
+    [[nodiscard]] std::optional<std::tuple<Ts...>> scan(std::string_view line, typename Scan_detail::type_identity<ScanFormat<Ts...>>::type pattern)
+    {
+        static_assert((Scan_detail::is_scannable_v<Ts> && ...), "scan() fields must be numbers, bool, char, std::string_view or std::string");
+        std::tuple<Ts...> fields{};
+        Scan_detail::Cursor cursor{ pattern.get(), line };
+        if (!Scan_detail::scanInto(cursor, fields, std::index_sequence_for<Ts...>{}))
+            return std::nullopt;
+        return fields;
+    }
+
+    /**
+     * @brief Read a line from `is`, `std::cin` by default, and parse it with @ref scan
+     * @details The line is read into a buffer reused by the calling thread, so reading many lines does not allocate.
+     * Unlike @ref input, a line which does not match is not asked again, and the stream is left at the next line.
+     * ~~~~{.cpp}
+     *     while (auto const point = input_line<int, int>("{},{}"))
+     *         ...
+     * ~~~~
+     * @return `std::nullopt` at the end of the input, or if the line does not match the pattern
+     */
+    template<typename... Ts>
+    [[nodiscard]] std::optional<std::tuple<Ts...>> input_line(typename Scan_detail::type_identity<ScanFormat<Ts...>>::type pattern, std::istream& is = std::cin)
+    {
+        static_assert(!(std::is_same_v<Ts, std::string_view> || ...), "input_line() fields cannot be std::string_view, as the line does not outlive the call, use std::string");
+        static thread_local std::string line;
+        if (!std::getline(is, line))
+            return std::nullopt;
+        return scan<Ts...>(line, pattern);
+    }
+
+#ifdef SugarPPNamespace
+}
+#endif
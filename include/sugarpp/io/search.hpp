@@ -0,0 +1,211 @@
+/*****************************************************************//**
+ * \file   search.hpp
+ * \brief  Counting the lines of files and searching them for a string, with SIMD and in parallel on a @ref ThreadPool
+ *
+ * \author Peter
+ * \date   October 2026
+ * \note The files are memory mapped where available, else read whole with @ref file_to_string
+ *********************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "file.hpp"
+#include "../range/parallel.hpp"
+#include "../range/range.hpp"
+#include "../string/split.hpp"
+#include "../thread/threadPool.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#define SugarPPSearchMmap
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef SugarPPNamespace
+namespace SugarPP
+{
+#endif
+
+    /**
+     * @brief A match of @ref find_all
+     */
+    struct FileMatch
+    {
+        size_t offset;  /**< The number of bytes before the match in the file */
+        size_t line;    /**< The number of the line of the match, from 1 */
+    };
+
+    namespace Search_detail
+    {
+        /**
+         * @brief The smallest part of a file searched by a task, so that small files are searched on the calling thread
+         */
+        constexpr size_t minChunkSize = 1 << 20;
+
+        /**
+         * @brief The whole content of a file, mapped read-only
+         */
+        class MappedFile
+        {
+#ifdef SugarPPSearchMmap
+            void* mapping = nullptr;
+            size_t length = 0;
+#else
+            std::string content;
+#endif
+        public:
+            /**
+             * @throw FileIOError if the file cannot be opened or mapped
+             */
+            explicit MappedFile(std::filesystem::path const& path)
+            {
+#ifdef SugarPPSearchMmap
+                auto const fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+                if (fd < 0)
+                    throw FileIOError{ path.c_str() };
+                struct stat status;
+                if (::fstat(fd, &status) != 0)
+                {
+                    ::close(fd);
+                    throw FileIOError{ path.c_str() };
+                }
+                length = static_cast<size_t>(status.st_size);
+                if (length != 0)
+                    mapping = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+                ::close(fd);
+                if (mapping == MAP_FAILED)
+                    throw FileIOError{ path.c_str() };
+#else
+                content = file_to_string<true>(path.string().c_str());
+#endif
+            }
+
+            MappedFile(MappedFile const&) = delete;
+            MappedFile& operator=(MappedFile const&) = delete;
+
+            ~MappedFile()
+            {
+#ifdef SugarPPSearchMmap
+                if (mapping)
+                    ::munmap(mapping, length);
+#endif
+            }
+
+#ifdef SugarPPSearchMmap
+            [[nodiscard]] char const* data() const { return static_cast<char const*>(mapping); }
+            [[nodiscard]] size_t size() const { return length; }
+#else
+            [[nodiscard]] char const* data() const { return content.data(); }
+            [[nodiscard]] size_t size() const { return content.size(); }
+#endif
+        };
+
+        /**
+         * @brief Call `func(chunkIndex, first, last)` for `chunkCount` consecutive parts of `file` on `pool`
+         */
+        template<typename Func>
+        void forEachPart(ThreadPool& pool, MappedFile const& file, size_t chunkCount, Func&& func)
+        {
+            auto const size = file.size();
+            Range_detail::forEachChunk(pool, Range(size_t{ 0 }, chunkCount), chunkCount, [&](size_t chunk, auto)
+            {
+                func(chunk, file.data() + size * chunk / chunkCount, file.data() + size * (chunk + 1) / chunkCount);
+            });
+        }
+
+        inline size_t chunkCountOf(size_t size, ThreadPool& pool)
+        {
+            return std::max<size_t>(1, std::min<size_t>(size / minChunkSize, size_t{ pool.size() } * 4));
+        }
+    }
+
+    /**
+     * @brief Return the number of lines of the file at `path`, counted in parallel on `pool` with SIMD
+     * @details The same as the number of lines a @ref FileIterator gives: a last line without `'\n'` counts, an empty file has none.
+     * @throw FileIOError if the file cannot be opened
+     */
+    [[nodiscard]] inline size_t count_lines(std::filesystem::path const& path, ThreadPool& pool = ThreadPool::shared())
+    {
+        Search_detail::MappedFile const file{ path };
+        if (file.size() == 0)
+            return 0;
+        auto const chunkCount = Search_detail::chunkCountOf(file.size(), pool);
+        std::vector<size_t> counts(chunkCount);
+        Search_detail::forEachPart(pool, file, chunkCount, [&counts](size_t chunk, char const* first, char const* last)
+        {
+            counts[chunk] = String_detail::countChar(first, last, '\n');
+        });
+
+        size_t lines = file.data()[file.size() - 1] != '\n';
+        for (auto count : counts)
+            lines += count;
+        return lines;
+    }
+
+    /**
+     * @brief Return every occurrence of `needle` in the file at `path`, with its byte offset and its line number, like `grep -b -n`
+     * @details
+     * The file is split into parts searched in parallel on `pool`, comparing the first and the last character of `needle`
+     * with 16 positions at once, and the lines are counted with SIMD too. Overlapping occurrences are all reported, in order.
+     * ~~~~{.cpp}
+     *     for (auto const [offset, line] : find_all("server.log", "timeout"))
+     *         print(line, offset);
+     * ~~~~
+     * @throw std::invalid_argument if `needle` is empty
+     * @throw FileIOError if the file cannot be opened
+     */
+    [[nodiscard]] inline std::vector<FileMatch> find_all(std::filesystem::path const& path, std::string_view needle, ThreadPool& pool = ThreadPool::shared())
+    {
+        if (needle.empty())
+            throw std::invalid_argument{ "find_all() needs a non-empty needle" };
+        Search_detail::MappedFile const file{ path };
+        if (file.size() < needle.size())
+            return {};
+
+        auto const chunkCount = Search_detail::chunkCountOf(file.size(), pool);
+        std::vector<std::vector<FileMatch>> matches(chunkCount);
+        std::vector<size_t> newlines(chunkCount);
+        auto const end = file.data() + file.size();
+        Search_detail::forEachPart(pool, file, chunkCount, [&](size_t chunk, char const* first, char const* last)
+        {
+            /*a match starts in the part, but may end in the next one*/
+            auto const searchEnd = std::min(end, last + (needle.size() - 1));
+            auto& found = matches[chunk];
+            size_t lines = 0;
+            auto counted = first;
+            for (auto position = first; ; ++position)
+            {
+                position = needle.size() == 1 ? String_detail::findChar(position, searchEnd, needle.front())
+                    : String_detail::findString(position, searchEnd, needle);
+                if (position >= last)
+                    break;
+                lines += String_detail::countChar(counted, position, '\n');
+                counted = position;
+                found.push_back({ static_cast<size_t>(position - file.data()), lines });
+            }
+            newlines[chunk] = lines + String_detail::countChar(counted, last, '\n');
+        });
+
+        std::vector<FileMatch> result;
+        size_t lineOfChunk = 1;
+        for (size_t chunk = 0; chunk < chunkCount; ++chunk)
+        {
+            for (auto const& match : matches[chunk])
+                result.push_back({ match.offset, lineOfChunk + match.line });
+            lineOfChunk += newlines[chunk];
+        }
+        return result;
+    }
+
+#ifdef SugarPPNamespace
+}
+#endif
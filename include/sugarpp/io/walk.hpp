@@ -0,0 +1,323 @@
+/*****************************************************************//**
+ * \file   walk.hpp
+ * \brief  Walking a directory tree, with the subdirectories listed in parallel on a @ref ThreadPool
+ *
+ * \author Peter
+ * \date   October 2026
+ * \note On Linux, directories are listed with `getdents64`, and the type of the entries comes from `d_type`, so most
+ * file systems need no `stat` per entry. Elsewhere, `std::filesystem::directory_iterator` is used.
+ *********************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include "file.hpp"
+#include "../channel/channel.hpp"
+#include "../thread/threadPool.hpp"
+
+#ifdef __linux__
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#ifdef SugarPPNamespace
+namespace SugarPP
+{
+#endif
+
+    /**
+     * @brief The type of an entry found by @ref walk. Symbolic links are not followed
+     */
+    enum class EntryType
+    {
+        File,
+        Directory,
+        Symlink,
+        Other       /**< Sockets, pipes, devices, and entries which disappeared while being listed */
+    };
+
+    /**
+     * @brief An entry found by @ref walk
+     */
+    struct WalkEntry
+    {
+        std::filesystem::path path;     /**< The path of the root joined with the names down to the entry */
+        EntryType type;
+
+        [[nodiscard]] bool isFile() const { return type == EntryType::File; }
+        [[nodiscard]] bool isDirectory() const { return type == EntryType::Directory; }
+    };
+
+    namespace Walk_detail
+    {
+        /**
+         * @brief The filter of @ref walk without a filter
+         */
+        struct All
+        {
+            constexpr bool operator()(WalkEntry const&) const { return true; }
+        };
+
+#ifdef __linux__
+        inline EntryType fromMode(mode_t mode)
+        {
+            if (S_ISREG(mode))
+                return EntryType::File;
+            if (S_ISDIR(mode))
+                return EntryType::Directory;
+            if (S_ISLNK(mode))
+                return EntryType::Symlink;
+            return EntryType::Other;
+        }
+
+        struct FileDescriptor
+        {
+            int fd;
+            ~FileDescriptor() { if (fd >= 0) ::close(fd); }
+        };
+#endif
+
+        /**
+         * @brief Call `onEntry(path&&, EntryType)` for every entry of `directory` but `.` and `..`
+         * @return false if `directory` cannot be opened
+         */
+        template<typename OnEntry>
+        bool list(std::filesystem::path const& directory, OnEntry&& onEntry)
+        {
+#ifdef __linux__
+            FileDescriptor const dir{ ::open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC) };
+            if (dir.fd < 0)
+                return false;
+
+            auto prefix = directory.native();
+            if (!prefix.empty() && prefix.back() != '/')
+                prefix += '/';
+
+            /*a linux_dirent64 is: u64 inode, i64 offset, u16 record length, u8 type, then the null-terminated name*/
+            alignas(8) char buffer[32 * 1024];
+            while (true)
+            {
+                auto const read = ::syscall(SYS_getdents64, dir.fd, buffer, sizeof(buffer));
+                if (read <= 0)
+                    return true;
+                for (long offset = 0; offset < read;)
+                {
+                    auto const record = buffer + offset;
+                    unsigned short length;
+                    std::memcpy(&length, record + 16, sizeof(length));
+                    offset += length;
+
+                    auto const dType = static_cast<unsigned char>(record[18]);
+                    std::string_view const name{ record + 19 };
+                    if (name == "." || name == "..")
+                        continue;
+
+                    EntryType type;
+                    switch (dType)
+                    {
+                    case DT_REG: type = EntryType::File; break;
+                    case DT_DIR: type = EntryType::Directory; break;
+                    case DT_LNK: type = EntryType::Symlink; break;
+                    case DT_UNKNOWN:
+                    {
+                        /*some file systems do not fill d_type*/
+                        struct stat status;
+                        type = ::fstatat(dir.fd, record + 19, &status, AT_SYMLINK_NOFOLLOW) == 0 ? fromMode(status.st_mode) : EntryType::Other;
+                        break;
+                    }
+                    default: type = EntryType::Other;
+                    }
+
+                    std::string path;
+                    path.reserve(prefix.size() + name.size());
+                    path.append(prefix).append(name);
+                    onEntry(std::filesystem::path{ std::move(path) }, type);
+                }
+            }
+#else
+            std::error_code error;
+            std::filesystem::directory_iterator iter{ directory, error };
+            if (error)
+                return false;
+            for (; iter != std::filesystem::directory_iterator{}; iter.increment(error))
+            {
+                if (error)
+                    return true;
+                auto const status = iter->symlink_status(error);
+                auto type = EntryType::Other;
+                if (!error)
+                {
+                    if (std::filesystem::is_regular_file(status))
+                        type = EntryType::File;
+                    else if (std::filesystem::is_directory(status))
+                        type = EntryType::Directory;
+                    else if (std::filesystem::is_symlink(status))
+                        type = EntryType::Symlink;
+                }
+                onEntry(std::filesystem::path{ iter->path() }, type);
+            }
+            return true;
+#endif
+        }
+
+        /**
+         * @brief Lists a directory on the calling thread, and posts the listing of each subdirectory to the pool
+         */
+        template<typename Callback, typename Filter>
+        struct Walker
+        {
+            Callback& callback;
+            Filter& filter;
+            ThreadPool& pool;
+            std::atomic<size_t> pending{ 1 };   //the directories posted and not listed yet, with the root
+            std::atomic<bool> failed{ false };
+            std::mutex errorMutex;
+            std::exception_ptr error;
+
+            Walker(Callback& callback, Filter& filter, ThreadPool& pool) :callback(callback), filter(filter), pool(pool) {}
+
+            void visit(std::filesystem::path const& directory)
+            {
+                if (!failed.load(std::memory_order_relaxed))
+                {
+                    try
+                    {
+                        list(directory, [this](std::filesystem::path&& path, EntryType type)
+                        {
+                            WalkEntry entry{ std::move(path), type };
+                            if (failed.load(std::memory_order_relaxed) || !filter(static_cast<WalkEntry const&>(entry)))
+                                return;
+                            if (type == EntryType::Directory)
+                            {
+                                pending.fetch_add(1, std::memory_order_relaxed);
+                                try
+                                {
+                                    pool.post([this, subdirectory = entry.path] { visit(subdirectory); });
+                                }
+                                catch (...)
+                                {
+                                    //not posted, so it is not going to be listed, and the error is recorded below
+                                    pending.fetch_sub(1, std::memory_order_relaxed);
+                                    throw;
+                                }
+                            }
+                            callback(std::move(entry));
+                        });
+                    }
+                    catch (...)
+                    {
+                        std::lock_guard lock{ errorMutex };
+                        if (!error)
+                            error = std::current_exception();
+                        failed.store(true, std::memory_order_relaxed);
+                    }
+                }
+                pending.fetch_sub(1, std::memory_order_acq_rel);
+            }
+
+            void run(std::filesystem::path const& root)
+            {
+                std::error_code statusError;
+                if (!std::filesystem::is_directory(root, statusError))
+                    throw FileIOError{ root.string().c_str() };
+                visit(root);
+                pool.helpUntil([this] { return pending.load(std::memory_order_acquire) == 0; });
+                if (error)
+                    std::rethrow_exception(error);
+            }
+        };
+
+        template<typename Callback, typename Filter>
+        void walk(std::filesystem::path const& root, Callback& callback, Filter& filter, ThreadPool& pool)
+        {
+            Walker<Callback, Filter>{ callback, filter, pool }.run(root);
+        }
+    }
+
+    /**
+     * @brief Call `callback(WalkEntry)` for every entry under `root` accepted by `filter`, listing the subdirectories in parallel on `pool`
+     * @details
+     * The directories rejected by `filter(WalkEntry const&)` are not entered, like with `find -prune`, so a filter selecting
+     * files should accept the directories to descend into:
+     * ~~~~{.cpp}
+     *     std::atomic<size_t> sources{ 0 };
+     *     walk("src", [&](WalkEntry const& entry) { if (entry.isFile()) ++sources; },
+     *         [](WalkEntry const& entry) { return entry.isDirectory() ? entry.path.filename() != ".git" : entry.path.extension() == ".cpp"; });
+     * ~~~~
+     * `callback` is called concurrently from the workers of `pool`, and from the calling thread which helps until the walk is done.
+     * The entries are in no particular order, and `root` itself is not reported. Symbolic links are reported, but not followed.
+     * Directories which cannot be opened, like for lack of permission, are reported but skipped.
+     *
+     * If `callback` or `filter` throws, no more entries are reported, and the first exception is rethrown once the tasks already
+     * posted are finished.
+     * @throw FileIOError if `root` is not a directory
+     */
+    template<typename Callback, typename Filter>
+    void walk(std::filesystem::path const& root, Callback&& callback, Filter&& filter, ThreadPool& pool)
+    {
+        Walk_detail::walk(root, callback, filter, pool);
+    }
+
+    /**
+     * @brief Walk `root` on the shared pool, see @ref walk
+     */
+    template<typename Callback, typename Filter>
+    void walk(std::filesystem::path const& root, Callback&& callback, Filter&& filter)
+    {
+        Walk_detail::walk(root, callback, filter, ThreadPool::shared());
+    }
+
+    /**
+     * @brief Walk every entry under `root` on the shared pool, see @ref walk
+     */
+    template<typename Callback>
+    void walk(std::filesystem::path const& root, Callback&& callback)
+    {
+        Walk_detail::All all;
+        Walk_detail::walk(root, callback, all, ThreadPool::shared());
+    }
+
+    /**
+     * @brief Send every entry under `root` accepted by `filter` to `channel`, and close it at the end of the walk
+     * @details It returns when the walk is done, so receive from another thread, which is not a worker of `pool`, or else
+     * the workers may all block on a full channel:
+     * ~~~~{.cpp}
+     *     Channel<WalkEntry> entries{ 1024 };
+     *     std::thread walker{ [&] { walk("/data", entries); } };
+     *     while (auto entry = entries.receive())
+     *         index(entry->path);
+     *     walker.join();
+     * ~~~~
+     * The channel is closed even if the walk throws. It must be an MPMC channel, as every worker of `pool` sends to it.
+     */
+    template<ChannelType Type, typename Filter = Walk_detail::All>
+    void walk(std::filesystem::path const& root, Channel<WalkEntry, Type>& channel, Filter&& filter = {}, ThreadPool& pool = ThreadPool::shared())
+    {
+        static_assert(Type == ChannelType::MPMC, "walk() sends from several threads, so it needs an MPMC channel");
+        auto send = [&channel](WalkEntry&& entry) { channel.send(std::move(entry)); };
+        try
+        {
+            Walk_detail::walk(root, send, filter, pool);
+        }
+        catch (...)
+        {
+            channel.close();
+            throw;
+        }
+        channel.close();
+    }
+
+#ifdef SugarPPNamespace
+}
+#endif
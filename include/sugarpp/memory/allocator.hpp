@@ -0,0 +1,220 @@
+/*****************************************************************//**
+ * \file   allocator.hpp
+ * \brief  Standard allocators for large buffers: aligned, and backed by huge pages
+ *
+ * \author Peter
+ * \date   October 2026
+ * \note Huge pages are only requested on Linux. Elsewhere @ref HugePageAllocator allocates memory aligned to a huge page
+ *********************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <type_traits>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+#ifdef SugarPPNamespace
+namespace SugarPP
+{
+#endif
+
+    namespace Allocator_detail
+    {
+        /**
+         * @brief The size of a huge page on x86-64 and most ARM64 systems
+         */
+        constexpr size_t hugePageSize = size_t{ 2 } << 20;
+
+        /**
+         * @brief The cache line size assumed by @ref AlignedAllocator, which is also enough for 512-bit SIMD loads
+         */
+        constexpr size_t cacheLineSize = 64;
+
+        template<typename T>
+        size_t bytesOf(size_t count)
+        {
+            if (count > std::numeric_limits<size_t>::max() / sizeof(T))
+                throw std::bad_array_new_length{};
+            return count * sizeof(T);
+        }
+
+        constexpr size_t roundUp(size_t bytes, size_t alignment)
+        {
+            return (bytes + alignment - 1) / alignment * alignment;
+        }
+
+#ifdef __linux__
+        /**
+         * @brief Map `bytes`, a multiple of @ref hugePageSize, from the reserved pool of huge pages, or return null
+         */
+        inline void* mapReserved(size_t bytes)
+        {
+#ifdef MAP_HUGETLB
+            auto flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB;
+#ifdef MAP_HUGE_2MB
+            flags |= MAP_HUGE_2MB;
+#endif
+            auto const memory = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, flags, -1, 0);
+            return memory == MAP_FAILED ? nullptr : memory;
+#else
+            (void)bytes;
+            return nullptr;
+#endif
+        }
+
+        /**
+         * @brief Map `bytes`, a multiple of @ref hugePageSize, at an address aligned to a huge page, and ask for transparent huge pages
+         * @details The kernel can only back the whole huge pages of a mapping, so one more huge page is mapped and the unaligned ends are unmapped.
+         */
+        inline void* mapTransparent(size_t bytes)
+        {
+            auto const memory = ::mmap(nullptr, bytes + hugePageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (memory == MAP_FAILED)
+                throw std::bad_alloc{};
+            auto const first = static_cast<char*>(memory);
+            auto const aligned = reinterpret_cast<char*>(roundUp(reinterpret_cast<std::uintptr_t>(first), hugePageSize));
+            if (aligned != first)
+                ::munmap(first, static_cast<size_t>(aligned - first));
+            if (auto const tail = static_cast<size_t>(first + bytes + hugePageSize - (aligned + bytes)))
+                ::munmap(aligned + bytes, tail);
+#ifdef MADV_HUGEPAGE
+            ::madvise(aligned, bytes, MADV_HUGEPAGE);
+#endif
+            return aligned;
+        }
+#endif
+    }
+
+    /**
+     * @brief A standard allocator aligning its memory to `Align` bytes, 64 by default, for aligned SIMD loads and no false sharing
+     * ~~~~{.cpp}
+     *     std::vector<float, AlignedAllocator<float>> samples(1 << 20);   //samples.data() is 64-byte aligned
+     * ~~~~
+     */
+    template<typename T, size_t Align = Allocator_detail::cacheLineSize>
+    class AlignedAllocator
+    {
+        static_assert(Align != 0 && (Align & (Align - 1)) == 0, "AlignedAllocator alignment must be a power of 2");
+        static_assert(Align >= alignof(T), "AlignedAllocator alignment must be at least the alignment of the type");
+    public:
+        using value_type = T;
+
+        template<typename U>
+        struct rebind
+        {
+            using other = AlignedAllocator<U, Align>;
+        };
+
+        constexpr AlignedAllocator() noexcept = default;
+
+        template<typename U>
+        constexpr AlignedAllocator(AlignedAllocator<U, Align> const&) noexcept {}
+
+        [[nodiscard]] T* allocate(size_t count)
+        {
+            return static_cast<T*>(::operator new(Allocator_detail::bytesOf<T>(count), std::align_val_t{ Align }));
+        }
+
+        void deallocate(T* pointer, size_t) noexcept
+        {
+            ::operator delete(pointer, std::align_val_t{ Align });
+        }
+
+        template<typename U>
+        constexpr bool operator==(AlignedAllocator<U, Align> const&) const noexcept { return true; }
+        template<typename U>
+        constexpr bool operator!=(AlignedAllocator<U, Align> const&) const noexcept { return false; }
+    };
+
+    /**
+     * @brief How @ref HugePageAllocator gets its huge pages
+     */
+    enum class HugePages
+    {
+        Transparent,    /**< Ask the kernel for transparent huge pages with `madvise(MADV_HUGEPAGE)`, which it gives when it can */
+        Reserved        /**< Take them from the pool reserved in `/proc/sys/vm/nr_hugepages` with `MAP_HUGETLB`, and fall back to transparent ones when it is empty */
+    };
+
+    /**
+     * @brief A standard allocator backing its allocations of 2 MB or more with huge pages, for multi-GB arrays which would miss the TLB
+     * @details
+     * A 2 MB page covers 512 pages of 4 KB with one TLB entry, so scanning or randomly accessing a large array takes far fewer
+     * TLB misses. Every large allocation is its own mapping, aligned to a huge page and rounded up to a multiple of it, so
+     * it suits a few large buffers rather than many growing ones. Smaller allocations are only aligned to 64 bytes.
+     * ~~~~{.cpp}
+     *     std::vector<std::uint64_t, HugePageAllocator<std::uint64_t>> table(1 << 28);
+     *     auto const data = file_to_vec("data.bin", HugePageAllocator<char>{});
+     * ~~~~
+     */
+    template<typename T, HugePages Mode = HugePages::Transparent>
+    class HugePageAllocator
+    {
+        static_assert(alignof(T) <= Allocator_detail::hugePageSize, "HugePageAllocator cannot align to more than a huge page");
+
+        static constexpr size_t smallAlignment = std::max(Allocator_detail::cacheLineSize, alignof(T));
+    public:
+        using value_type = T;
+
+        template<typename U>
+        struct rebind
+        {
+            using other = HugePageAllocator<U, Mode>;
+        };
+
+        constexpr HugePageAllocator() noexcept = default;
+
+        template<typename U>
+        constexpr HugePageAllocator(HugePageAllocator<U, Mode> const&) noexcept {}
+
+        [[nodiscard]] T* allocate(size_t count)
+        {
+            auto const bytes = Allocator_detail::bytesOf<T>(count);
+            if (bytes < Allocator_detail::hugePageSize)
+                return static_cast<T*>(::operator new(bytes, std::align_val_t{ smallAlignment }));
+
+            auto const mapped = Allocator_detail::roundUp(bytes, Allocator_detail::hugePageSize);
+            if (mapped < bytes)
+                throw std::bad_array_new_length{};
+#ifdef __linux__
+            if constexpr (Mode == HugePages::Reserved)
+            {
+                if (auto const memory = Allocator_detail::mapReserved(mapped))
+                    return static_cast<T*>(memory);
+            }
+            return static_cast<T*>(Allocator_detail::mapTransparent(mapped));
+#else
+            return static_cast<T*>(::operator new(mapped, std::align_val_t{ Allocator_detail::hugePageSize }));
+#endif
+        }
+
+        void deallocate(T* pointer, size_t count) noexcept
+        {
+            auto const bytes = count * sizeof(T);
+            if (bytes < Allocator_detail::hugePageSize)
+            {
+                ::operator delete(pointer, std::align_val_t{ smallAlignment });
+                return;
+            }
+#ifdef __linux__
+            ::munmap(pointer, Allocator_detail::roundUp(bytes, Allocator_detail::hugePageSize));
+#else
+            ::operator delete(pointer, std::align_val_t{ Allocator_detail::hugePageSize });
+#endif
+        }
+
+        template<typename U>
+        constexpr bool operator==(HugePageAllocator<U, Mode> const&) const noexcept { return true; }
+        template<typename U>
+        constexpr bool operator!=(HugePageAllocator<U, Mode> const&) const noexcept { return false; }
+    };
+
+#ifdef SugarPPNamespace
+}
+#endif
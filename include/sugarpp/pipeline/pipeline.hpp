@@ -0,0 +1,517 @@
+/*****************************************************************//**
+ * \file   pipeline.hpp
+ * \brief  Multi-stage streaming pipeline, similar to Kotlin's Flow
+ *
+ * \author Peter
+ * \date   October 2026
+ *********************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "../channel/channel.hpp"
+#include "../io/file.hpp"
+#include "../io/io.hpp"
+#include "../thread/threadPool.hpp"
+
+#ifdef SugarPPNamespace
+namespace SugarPP
+{
+#endif
+
+    /**
+     * @brief Whether the items reach the serial stages and the sink of a @ref Pipeline in the same order as they come from the source
+     */
+    enum class PipelineOrder
+    {
+        Preserve,
+        Any
+    };
+
+    /**
+     * @brief A stage of a @ref Pipeline, created by @ref stage
+     */
+    template<typename Func>
+    struct Stage
+    {
+        Func func;
+        unsigned parallelism;
+    };
+
+    /**
+     * @brief The last stage of a @ref Pipeline, created by @ref sink
+     */
+    template<typename Func>
+    struct Sink
+    {
+        Func func;
+        unsigned parallelism;
+    };
+
+    /**
+     * @brief Create a stage transforming every item with `func`
+     * @param func Called with an rvalue of the item. If it returns an `std::optional`, empty results are dropped, so a stage can also filter.
+     * @param parallelism The number of batches processed at the same time. `func` must be thread-safe if it is more than 1.
+     * A stage with parallelism 1 is serial: it processes one batch at a time, in order unless the pipeline is created with @ref PipelineOrder::Any.
+     */
+    template<typename Func>
+    Stage<std::decay_t<Func>> stage(Func&& func, unsigned parallelism = 1)
+    {
+        return { std::forward<Func>(func), (std::max)(parallelism, 1u) };
+    }
+
+    /**
+     * @brief Create a sink consuming every item with `func`, which is serial unless `parallelism` is more than 1
+     */
+    template<typename Func>
+    Sink<std::decay_t<Func>> sink(Func&& func, unsigned parallelism = 1)
+    {
+        return { std::forward<Func>(func), (std::max)(parallelism, 1u) };
+    }
+
+    /**
+     * @brief Create a sink printing every item on its own line with @ref ThreadSafe
+     */
+    template<std::ostream& os = std::cout>
+    auto printSink()
+    {
+        return sink([](auto const& item) { ThreadSafe<os>::printLn(item); });
+    }
+
+    /**
+     * @brief Create a sink writing every item followed by a new line to a file
+     * @throw FileIOError If the file cannot be opened
+     */
+    inline auto fileSink(std::string const& fileName)
+    {
+        auto file = std::make_shared<std::ofstream>(fileName);
+        if (!file->is_open())
+            throw FileIOError{ fileName.c_str() };
+        return sink([file = std::move(file)](auto const& item) { *file << item << '\n'; });
+    }
+
+    namespace Pipeline_detail
+    {
+        template<typename T>
+        struct Batch
+        {
+            std::size_t sequence;
+            std::vector<T> items;
+        };
+
+        /**
+         * @brief A sink outputs batches without items, only to pass their sequence numbers on
+         */
+        template<>
+        struct Batch<void>
+        {
+            std::size_t sequence;
+            std::vector<char> items;
+        };
+
+        template<typename Result>
+        struct StageOutput
+        {
+            using type = Result;
+            static constexpr bool filters = false;
+        };
+
+        template<typename T>
+        struct StageOutput<std::optional<T>>
+        {
+            using type = T;
+            static constexpr bool filters = true;
+        };
+
+        template<typename Func, typename In>
+        using StageResult = std::decay_t<std::invoke_result_t<Func&, In&&>>;
+
+        /**
+         * @brief The runtime state of a stage, which admits up to `parallelism` batches at once and queues the others
+         */
+        template<typename Func, typename In>
+        struct StageRuntime
+        {
+            using Input = In;
+            using Output = typename StageOutput<StageResult<Func, In>>::type;
+
+            Func func;
+            unsigned parallelism;
+            bool inOrder = false;
+
+            std::mutex m;
+            unsigned active = 0;
+            std::size_t next = 0;
+            std::deque<Batch<In>> waiting;
+            std::map<std::size_t, Batch<In>> reorder;
+
+            template<typename Builder>
+            StageRuntime(Builder&& builder) :func(std::move(builder.func)), parallelism(builder.parallelism) {}
+
+            /**
+             * @return true if the caller should run `batch` now, otherwise the batch is queued
+             */
+            bool admit(Batch<In>& batch)
+            {
+                std::lock_guard lock{ m };
+                if (inOrder)
+                {
+                    if (active != 0 || batch.sequence != next)
+                    {
+                        auto const sequence = batch.sequence;
+                        reorder.emplace(sequence, std::move(batch));
+                        return false;
+                    }
+                }
+                else if (active == parallelism)
+                {
+                    waiting.push_back(std::move(batch));
+                    return false;
+                }
+                ++active;
+                return true;
+            }
+
+            /**
+             * @brief Called after running a batch
+             * @return The next queued batch, which takes over the slot of the finished one
+             */
+            std::optional<Batch<In>> leave()
+            {
+                std::lock_guard lock{ m };
+                if (inOrder)
+                {
+                    ++next;
+                    if (!reorder.empty() && reorder.begin()->first == next)
+                    {
+                        auto batch = std::move(reorder.begin()->second);
+                        reorder.erase(reorder.begin());
+                        return batch;
+                    }
+                }
+                else if (!waiting.empty())
+                {
+                    auto batch = std::move(waiting.front());
+                    waiting.pop_front();
+                    return batch;
+                }
+                --active;
+                return std::nullopt;
+            }
+
+            Batch<Output> apply(Batch<In>&& batch)
+            {
+                Batch<Output> output{ batch.sequence, {} };
+                if constexpr (std::is_void_v<Output>)
+                {
+                    for (auto& item : batch.items)
+                        func(std::move(item));
+                }
+                else
+                {
+                    output.items.reserve(batch.items.size());
+                    for (auto& item : batch.items)
+                    {
+                        if constexpr (StageOutput<StageResult<Func, In>>::filters)
+                        {
+                            if (auto result = func(std::move(item)))
+                                output.items.push_back(std::move(*result));
+                        }
+                        else
+                            output.items.push_back(func(std::move(item)));
+                    }
+                }
+                return output;
+            }
+        };
+
+        template<typename In, typename... Funcs>
+        struct StageChain
+        {
+            using type = std::tuple<>;
+        };
+
+        template<typename In, typename Func, typename... Rest>
+        struct StageChain<In, Func, Rest...>
+        {
+            using Head = StageRuntime<Func, In>;
+            using type = decltype(std::tuple_cat(
+                std::declval<std::tuple<Head>>(),
+                std::declval<typename StageChain<typename Head::Output, Rest...>::type>()
+            ));
+        };
+
+        template<typename Iterable>
+        class IterableReader
+        {
+            Iterable iterable;
+            decltype(std::begin(std::declval<std::remove_reference_t<Iterable>&>())) current;
+            decltype(std::end(std::declval<std::remove_reference_t<Iterable>&>())) last;
+        public:
+            using value_type = std::decay_t<decltype(*current)>;
+
+            explicit IterableReader(Iterable&& iterable)
+                : iterable(std::forward<Iterable>(iterable)), current(std::begin(this->iterable)), last(std::end(this->iterable))
+            {
+            }
+
+            /**
+             * @return false if the source is exhausted
+             */
+            bool read(std::vector<value_type>& items, std::size_t count)
+            {
+                for (; count != 0 && current != last; --count, ++current)
+                    items.push_back(*current);
+                return current != last;
+            }
+        };
+
+        template<typename T, ChannelType Type>
+        class ChannelReader
+        {
+            Channel<T, Type>& channel;
+        public:
+            using value_type = T;
+
+            explicit ChannelReader(Channel<T, Type>& channel) : channel(channel) {}
+
+            bool read(std::vector<T>& items, std::size_t count)
+            {
+                return channel.receiveBatch(std::back_inserter(items), count) != 0;
+            }
+        };
+
+        template<typename Source>
+        struct ReaderOf
+        {
+            using type = IterableReader<Source>;
+        };
+
+        template<typename T, ChannelType Type>
+        struct ReaderOf<Channel<T, Type>&>
+        {
+            using type = ChannelReader<T, Type>;
+        };
+
+        /**
+         * @brief Runs a pipeline: the calling thread reads the source, the stages run as tasks on the shared pool
+         * @details
+         * At most `maxInFlight` batches are between the source and the sink, which bounds the queues in front of every stage
+         * and is what slows down the source when a later stage is slower. A task never blocks: a batch which cannot enter
+         * a busy stage is queued and later run by the task leaving that stage.
+         */
+        template<typename Reader, typename... Funcs>
+        class Runtime
+        {
+            using Stages = typename StageChain<typename Reader::value_type, Funcs...>::type;
+            static constexpr std::size_t StageCount = sizeof...(Funcs);
+
+            template<std::size_t I>
+            using StageAt = std::tuple_element_t<I, Stages>;
+
+            Reader& reader;
+            Stages stages;
+            ThreadPool& pool;
+
+            std::mutex m;
+            std::condition_variable batchDone;
+            std::size_t inFlight = 0;
+            std::atomic<bool> failed{ false };
+            std::exception_ptr exception;
+
+            void fail(std::exception_ptr error)
+            {
+                std::lock_guard lock{ m };
+                if (!exception)
+                    exception = std::move(error);
+                failed.store(true);
+            }
+
+            void finish()
+            {
+                std::lock_guard lock{ m };
+                --inFlight;
+                batchDone.notify_one();
+            }
+
+            template<typename Predicate>
+            void waitUntil(Predicate&& predicate)
+            {
+                if (ThreadPool::current() == &pool)
+                {
+                    pool.helpUntil([&] { std::lock_guard lock{ m }; return predicate(); });
+                    return;
+                }
+                std::unique_lock lock{ m };
+                batchDone.wait(lock, predicate);
+            }
+
+            template<std::size_t I>
+            void enter(Batch<typename StageAt<I>::Input> batch)
+            {
+                if (std::get<I>(stages).admit(batch))
+                    run<I>(std::move(batch));
+            }
+
+            template<std::size_t I>
+            void run(Batch<typename StageAt<I>::Input> batch)
+            {
+                auto& stage = std::get<I>(stages);
+                //after a failure, empty batches still flow through so the ordered stages keep going
+                Batch<typename StageAt<I>::Output> output{ batch.sequence, {} };
+                if (!failed.load())
+                {
+                    try
+                    {
+                        output = stage.apply(std::move(batch));
+                    }
+                    catch (...)
+                    {
+                        fail(std::current_exception());
+                    }
+                }
+                if (auto next = stage.leave())
+                    pool.post([this, next = std::move(*next)]() mutable { run<I>(std::move(next)); });
+
+                if constexpr (I + 1 < StageCount)
+                    enter<I + 1>(std::move(output));
+                else
+                    finish();
+            }
+
+        public:
+            template<typename... Builders>
+            Runtime(Reader& reader, PipelineOrder order, Builders&&... builders)
+                : reader(reader), stages(std::forward<Builders>(builders)...), pool(ThreadPool::shared())
+            {
+                std::apply([order](auto&... stage) { ((stage.inOrder = order == PipelineOrder::Preserve && stage.parallelism == 1), ...); }, stages);
+            }
+
+            void execute(std::size_t batchSize)
+            {
+                auto const maxInFlight = (std::max)(4u, 2 * pool.size());
+                bool more = true;
+                for (std::size_t sequence = 0; more && !failed.load(); ++sequence)
+                {
+                    waitUntil([&] { return inFlight < maxInFlight; });
+                    Batch<typename Reader::value_type> batch{ sequence, {} };
+                    batch.items.reserve(batchSize);
+                    try
+                    {
+                        more = reader.read(batch.items, batchSize);
+                    }
+                    catch (...)
+                    {
+                        fail(std::current_exception());
+                        break;
+                    }
+                    if (batch.items.empty())
+                        break;
+                    {
+                        std::lock_guard lock{ m };
+                        ++inFlight;
+                    }
+                    pool.post([this, batch = std::move(batch)]() mutable { enter<0>(std::move(batch)); });
+                }
+                waitUntil([this] { return inFlight == 0; });
+                if (exception)
+                    std::rethrow_exception(exception);
+            }
+        };
+    }
+
+    template<typename Source, typename... Funcs>
+    class Pipeline;
+
+    template<typename Iterable>
+    Pipeline<Iterable> pipeline(Iterable&& source, std::size_t batchSize = 256, PipelineOrder order = PipelineOrder::Preserve);
+
+    /**
+     * @brief A source followed by stages, which runs when a @ref sink is attached, created by @ref pipeline
+     * @details
+     * ~~~~{.cpp}
+     *     pipeline(FileIterator{ "data.csv" })
+     *         | stage([](std::string line) { return parse(line); }, 4)     //4 batches parsed at once
+     *         | stage([](Record record) { return record.valid ? std::optional{ record } : std::nullopt; })
+     *         | sink([&](Record record) { database.insert(record); });
+     * ~~~~
+     * The calling thread reads items from the source in batches and blocks until the sink has consumed all of them.
+     * Stages run as tasks on `ThreadPool::shared()`, the pool used by @ref parallel, so the workers keep transforming items while
+     * the calling thread waits for I/O. The first exception thrown by the source or a stage stops the pipeline and is rethrown.
+     */
+    template<typename Source, typename... Funcs>
+    class Pipeline
+    {
+        Source source;
+        std::tuple<Stage<Funcs>...> stages;
+        std::size_t batchSize;
+        PipelineOrder order;
+
+        template<typename, typename...>
+        friend class Pipeline;
+
+        template<typename Iterable>
+        friend Pipeline<Iterable> pipeline(Iterable&& source, std::size_t batchSize, PipelineOrder order);
+
+        Pipeline(Source&& source, std::tuple<Stage<Funcs>...>&& stages, std::size_t batchSize, PipelineOrder order)
+            : source(std::forward<Source>(source)), stages(std::move(stages)), batchSize(batchSize), order(order)
+        {
+        }
+
+    public:
+        /**
+         * @brief Append a stage
+         */
+        template<typename Func>
+        Pipeline<Source, Funcs..., Func> operator|(Stage<Func> next) &&
+        {
+            return { std::forward<Source>(source), std::tuple_cat(std::move(stages), std::make_tuple(std::move(next))), batchSize, order };
+        }
+
+        /**
+         * @brief Attach the sink, and run the pipeline until the source is exhausted and every item is consumed
+         */
+        template<typename Func>
+        void operator|(Sink<Func> last) &&
+        {
+            using Reader = typename Pipeline_detail::ReaderOf<Source>::type;
+            Reader reader{ std::forward<Source>(source) };
+            std::apply([&](auto&&... stage)
+            {
+                Pipeline_detail::Runtime<Reader, Funcs..., Func> runtime{ reader, order, std::move(stage)..., std::move(last) };
+                runtime.execute(batchSize);
+            }, std::move(stages));
+        }
+    };
+
+    /**
+     * @brief Start a @ref Pipeline reading from `source`
+     * @param source Anything iterable, like a container, a @ref Range or a @ref FileIterator, or a @ref Channel which is read until it is closed.
+     * An lvalue is referenced and an rvalue is moved into the pipeline.
+     * @param batchSize The number of items handed from a stage to the next one at once
+     */
+    template<typename Iterable>
+    Pipeline<Iterable> pipeline(Iterable&& source, std::size_t batchSize, PipelineOrder order)
+    {
+        return { std::forward<Iterable>(source), {}, (std::max)(batchSize, std::size_t{ 1 }), order };
+    }
+
+#ifdef SugarPPNamespace
+}
+#endif
@@ -7,7 +7,9 @@
  *********************************************************************/
 #pragma once
 
+#include <iterator>
 #include <tuple>
+#include <utility>
 
 #ifdef SugarPPNamespace
 namespace SugarPP
@@ -37,7 +39,7 @@ namespace SugarPP
         }
         auto operator*()
         {
-            return std::forward_as_tuple(index, *iter);
+            return std::tuple<CounterType&, decltype(*iter)>{ index, *iter };
         }
         bool operator!=(EnumerateIterator const& rhs) const
         {
@@ -46,21 +48,22 @@ namespace SugarPP
     };
     /**
      * @brief A Python-like Enumerate object, when dereference, returns <index, content>
-     * @tparam Iterable The type of the `iterable` object
+     * @tparam Iterable The type of the `iterable` object, which is an lvalue reference when constructed from an lvalue
      * @tparam CounterType The type of the counter, default to `size_t`
      */
     template<typename Iterable, typename CounterType = size_t>
     class Enumerate
     {
-        Iterable& iterable;
+        Iterable iterable; //lvalue reference or value type
         CounterType index;
     public:
         /**
          * @brief Construct an Enumerate object by an iterable and an optional index
-         * @param iterable Any type of object that supports iteration, eg. returns a iterator when calling `std::begin(iterable)`
+         * @param iterable Any type of object that supports iteration, eg. returns a iterator when calling `std::begin(iterable)`.
+         * Rvalues (eg. a @ref Generator) are moved into the Enumerate object.
          * @param start A counter which defaults to 0
          */
-        Enumerate(Iterable& iterable, CounterType start = 0) :iterable(iterable), index(start) {}
+        Enumerate(Iterable&& iterable, CounterType start = 0) :iterable(std::forward<Iterable>(iterable)), index(start) {}
         /**
          * @return Return an EnumerateIterator object, that points to the start of the `iterable`
          */
@@ -71,6 +74,12 @@ namespace SugarPP
          */
         auto end() { return EnumerateIterator{ std::end(iterable), index }; }
     };
+
+    template<typename Iterable>
+    Enumerate(Iterable&&)->Enumerate<Iterable>;
+
+    template<typename Iterable, typename CounterType>
+    Enumerate(Iterable&&, CounterType)->Enumerate<Iterable, CounterType>;
 #ifdef SugarPPNamespace
 }
 #endif
\ No newline at end of file
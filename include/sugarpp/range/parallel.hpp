@@ -0,0 +1,342 @@
+/*****************************************************************//**
+ * \file   parallel.hpp
+ * \brief  Parallel for loop and search over a numeric @ref Range, and NUMA first-touch initialization matching the loop
+ *
+ * \author Peter
+ * \date   October 2026
+ *********************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "range.hpp"
+#include "../thread/threadPool.hpp"
+
+#ifdef SugarPPNamespace
+namespace SugarPP
+{
+#endif
+
+    namespace Range_detail
+    {
+        /**
+         * @brief Return the number of values a numeric range produces when iterated
+         */
+        template<typename RangeType>
+        size_t count(RangeType const& range)
+        {
+            auto const span = range.span();
+            if (!(span > 0))
+                return 0;
+            if constexpr (std::is_integral_v<typename RangeType::value_type>)
+                return static_cast<size_t>((span + range.step - 1) / range.step);
+            else
+                return static_cast<size_t>(std::ceil(span / range.step));
+        }
+
+        /**
+         * @brief Return the worker of a pool of `workerCount` workers that chunk `chunk` of `chunkCount` runs on, when the pool is pinned
+         */
+        inline unsigned chunkWorker(size_t chunk, size_t chunkCount, unsigned workerCount)
+        {
+            return static_cast<unsigned>(chunk * workerCount / chunkCount);
+        }
+
+        /**
+         * @brief Split `range` into `chunkCount` consecutive sub-ranges of (almost) the same number of values and call `func(chunkIndex, chunk)` for each of them on `pool`.
+         * @details If the workers of `pool` are not pinned, every chunk but the last is run on `pool`, the last one runs on the calling thread,
+         * which then helps running pending tasks until all the chunks are finished.
+         * If they are pinned, every chunk is posted to the worker given by @ref chunkWorker, so the same chunk always runs on the same NUMA node,
+         * and the calling thread only helps if it is a worker of `pool`. The first exception thrown by `func` is rethrown.
+         */
+        template<typename RangeType, typename Func>
+        void forEachChunk(ThreadPool& pool, RangeType const& range, size_t chunkCount, Func&& func)
+        {
+            auto const total = count(range);
+            auto const perChunk = total / chunkCount;
+            auto const remainder = total % chunkCount;
+            auto const start = *range;
+            auto const valueAt = [&](size_t index)
+            {
+                return index == total ? range.end() : static_cast<typename RangeType::value_type>(start + index * range.step);
+            };
+
+            std::atomic<size_t> remaining{ chunkCount };
+            std::mutex doneMutex;
+            std::condition_variable done;
+            std::exception_ptr exception;
+            std::mutex exceptionMutex;
+            auto const runChunk = [&](size_t chunk)
+            {
+                auto const first = chunk * perChunk + std::min(chunk, remainder);
+                auto const last = first + perChunk + (chunk < remainder ? 1 : 0);
+                try
+                {
+                    func(chunk, RangeType{ valueAt(first), valueAt(last), range.step });
+                }
+                catch (...)
+                {
+                    std::lock_guard lock{ exceptionMutex };
+                    if (!exception)
+                        exception = std::current_exception();
+                }
+                std::lock_guard lock{ doneMutex };
+                if (remaining.fetch_sub(1, std::memory_order_release) == 1)
+                    done.notify_all();
+            };
+            auto const finished = [&remaining] { return remaining.load(std::memory_order_acquire) == 0; };
+
+            if (pool.affinity() == ThreadAffinity::None)
+            {
+                for (size_t chunk = 0; chunk + 1 < chunkCount; ++chunk)
+                    pool.post([&runChunk, chunk] { runChunk(chunk); });
+                runChunk(chunkCount - 1);
+            }
+            else
+            {
+                for (size_t chunk = 0; chunk < chunkCount; ++chunk)
+                    pool.postTo(chunkWorker(chunk, chunkCount, pool.size()), [&runChunk, chunk] { runChunk(chunk); });
+            }
+
+            if (ThreadPool::current() == &pool || pool.affinity() == ThreadAffinity::None)
+                pool.helpUntil(finished);
+            std::unique_lock lock{ doneMutex };    //also waits for the last chunk to release it
+            done.wait(lock, finished);
+
+            if (exception)
+                std::rethrow_exception(exception);
+        }
+
+        template<typename RangeType, typename Func>
+        auto parallelOn(ThreadPool& pool, RangeType range, Func& func, unsigned threadCount)
+        {
+            /* If there are 7 tasks but 8 threads, we only launch 7 tasks
+             *
+             */
+            auto const chunkCount = std::min<size_t>(count(range), std::max(threadCount, 1u));
+            using result_type = std::invoke_result_t<Func&, RangeType>;
+            if constexpr (std::is_same_v<result_type, void>)
+            {
+                if (chunkCount != 0)
+                    forEachChunk(pool, range, chunkCount, [&func](size_t, RangeType chunk) { func(chunk); });
+            }
+            else
+            {
+                std::vector<std::optional<result_type>> results(chunkCount);
+                if (chunkCount != 0)
+                    forEachChunk(pool, range, chunkCount, [&func, &results](size_t chunk, RangeType subRange) { results[chunk].emplace(func(subRange)); });
+
+                std::vector<result_type> values;
+                values.reserve(chunkCount);
+                for (auto& result : results)
+                    values.push_back(std::move(*result));
+                return values;
+            }
+        }
+
+        /**
+         * @brief The number of sub-chunks per thread of a parallel search, which is how often a worker checks whether it can stop
+         */
+        constexpr size_t searchSubChunks = 64;
+
+        /**
+         * @brief Return the index of the first value of `range` satisfying `pred`, or the number of values if there is none
+         * @details
+         * The values are split into small sub-chunks, which the workers take in increasing order. A match lowers the shared `found`
+         * index, and a worker stops when the next sub-chunk starts after it, as none of its values can be the first match.
+         * Every sub-chunk before the first match is still searched completely, so the result is the same as a sequential search.
+         */
+        template<typename RangeType, typename Pred>
+        size_t findFirst(ThreadPool& pool, RangeType const& range, Pred& pred, unsigned threadCount)
+        {
+            auto const total = count(range);
+            auto const workerCount = std::min<size_t>(total, std::max(threadCount, 1u));
+            if (workerCount == 0)
+                return total;
+
+            auto const start = *range;
+            auto const subChunk = std::max<size_t>(1, total / (workerCount * searchSubChunks));
+            auto const subChunkCount = (total + subChunk - 1) / subChunk;
+            std::atomic<size_t> next{ 0 };
+            std::atomic<size_t> found{ total };
+            forEachChunk(pool, Range(size_t{ 0 }, workerCount), workerCount, [&](size_t, auto)
+            {
+                for (auto k = next.fetch_add(1, std::memory_order_relaxed); k < subChunkCount; k = next.fetch_add(1, std::memory_order_relaxed))
+                {
+                    auto const first = k * subChunk;
+                    if (first >= found.load(std::memory_order_relaxed))
+                        return;
+                    auto const last = std::min(total, first + subChunk);
+                    for (auto i = first; i < last; ++i)
+                    {
+                        if (pred(static_cast<typename RangeType::value_type>(start + i * range.step)))
+                        {
+                            auto current = found.load(std::memory_order_relaxed);
+                            while (i < current && !found.compare_exchange_weak(current, i, std::memory_order_relaxed))
+                                ;
+                            return;
+                        }
+                    }
+                }
+            });
+            return found.load();
+        }
+
+        template<typename RangeType, typename Pred>
+        std::optional<typename RangeType::value_type> findIf(ThreadPool& pool, RangeType const& range, Pred& pred, unsigned threadCount)
+        {
+            auto const index = findFirst(pool, range, pred, threadCount);
+            if (index == count(range))
+                return std::nullopt;
+            return static_cast<typename RangeType::value_type>(*range + index * range.step);
+        }
+    }
+
+    /**
+     * @brief An execution policy making the algorithms of SugarPP which take it run in parallel on a @ref ThreadPool
+     * ~~~~{.cpp}
+     *     sum(par, v);             //on the shared pool
+     *     sum(par.on(pool), v);    //on a pool of your own
+     * ~~~~
+     */
+    struct ParallelPolicy
+    {
+        ThreadPool* pool = nullptr;
+
+        /**
+         * @brief Return the pool to run on, which is the shared pool unless set with @ref on
+         */
+        [[nodiscard]] ThreadPool& getPool() const
+        {
+            return pool ? *pool : ThreadPool::shared();
+        }
+
+        /**
+         * @brief Return a policy running on `threadPool`
+         */
+        [[nodiscard]] constexpr ParallelPolicy on(ThreadPool& threadPool) const
+        {
+            return ParallelPolicy{ &threadPool };
+        }
+    };
+
+    /**
+     * @brief The execution policy running on the shared @ref ThreadPool
+     */
+    inline constexpr ParallelPolicy par{};
+
+    /**
+     * @brief A parallel for loop for a specific range
+     * @tparam Range The type of [range], which is of the form: Range<value_type, value_type, stepSizeType>
+     * @tparam Func The type of [func], which is of the form: Func<ReturnType(Range)>
+     * @param range The range loop variable
+     * @param func Should be a function that takes a range as parameter and may or may not return stuff
+     * @param threadCount The hint of number of threads to use, which is the number of sub-ranges [range] is split into. The real number depends on the number of steps in [range]
+     * @return std::vector<ReturnType>, in the order of the sub-ranges / void if [func] returns void
+     * @details The sub-ranges run on the shared @ref ThreadPool and the calling thread, so no thread is created per call.
+    */
+    template<typename RangeType, typename Func>
+    auto parallel(RangeType range, Func&& func, unsigned threadCount = std::thread::hardware_concurrency())
+    {
+        return Range_detail::parallelOn(ThreadPool::shared(), range, func, threadCount);
+    }
+
+    /**
+     * @brief A parallel for loop for a specific range, on `pool` with one sub-range per worker
+     * @details If the workers of `pool` are pinned with a @ref ThreadAffinity, a sub-range always runs on the same worker for the same
+     * number of steps, so memory initialized with @ref firstTouch on `pool` is mostly accessed from its own NUMA node.
+     */
+    template<typename RangeType, typename Func>
+    auto parallel(RangeType range, Func&& func, ThreadPool& pool)
+    {
+        return Range_detail::parallelOn(pool, range, func, pool.size());
+    }
+
+    /**
+     * @brief Return the first value of `range` satisfying `pred`, searched in parallel
+     * @details
+     * The workers stop soon after a match is found, instead of running `range` to the end like @ref parallel. The result is
+     * still the lowest matching value, as with a sequential search, not whichever match was found first.
+     * `pred` is called from several threads at the same time, and may be called for some values after the match.
+     * ~~~~{.cpp}
+     *     auto key = parallel_find_if(Range(0ull, 1ull << 40), [](auto candidate) { return hash(candidate) == target; });
+     * ~~~~
+     * @return The value, or `std::nullopt` if no value satisfies `pred`
+     */
+    template<typename RangeType, typename Pred>
+    [[nodiscard]] auto parallel_find_if(RangeType range, Pred&& pred, unsigned threadCount = std::thread::hardware_concurrency())
+    {
+        return Range_detail::findIf(ThreadPool::shared(), range, pred, threadCount);
+    }
+
+    /**
+     * @brief Return the first value of `range` satisfying `pred`, searched in parallel on the workers of `pool`
+     */
+    template<typename RangeType, typename Pred>
+    [[nodiscard]] auto parallel_find_if(RangeType range, Pred&& pred, ThreadPool& pool)
+    {
+        return Range_detail::findIf(pool, range, pred, pool.size());
+    }
+
+    /**
+     * @brief Return whether any value of `range` satisfies `pred`, stopping the search soon after a match is found
+     */
+    template<typename RangeType, typename Pred>
+    [[nodiscard]] bool parallel_any_of(RangeType range, Pred&& pred, unsigned threadCount = std::thread::hardware_concurrency())
+    {
+        return Range_detail::findFirst(ThreadPool::shared(), range, pred, threadCount) != Range_detail::count(range);
+    }
+
+    /**
+     * @brief Return whether any value of `range` satisfies `pred`, searched on the workers of `pool`
+     */
+    template<typename RangeType, typename Pred>
+    [[nodiscard]] bool parallel_any_of(RangeType range, Pred&& pred, ThreadPool& pool)
+    {
+        return Range_detail::findFirst(pool, range, pred, pool.size()) != Range_detail::count(range);
+    }
+
+    /**
+     * @brief Construct `count` copies of `value` in the uninitialized storage at `data`, in parallel on `pool`
+     * @details Memory is placed on the NUMA node of the thread first writing to it. The elements are written with the same sub-ranges on the same workers
+     * as `parallel(Range(0, count), func, pool)`, so such a loop later accesses local memory, if the workers of `pool` are pinned.
+     * It only helps for memory which was not written yet, see @ref makeFirstTouched.
+     */
+    template<typename T>
+    void firstTouch(ThreadPool& pool, T* data, size_t count, T const& value = T{})
+    {
+        static_assert(std::is_nothrow_copy_constructible_v<T>, "firstTouch() can not undo the elements constructed when copying throws");
+        parallel(Range(size_t{ 0 }, count), [data, &value](auto chunk)
+        {
+            std::uninitialized_fill(data + *chunk, data + chunk.end(), value);
+        }, pool);
+    }
+
+    /**
+     * @brief Allocate an array of `count` copies of `value`, initialized with @ref firstTouch on `pool`
+     * @details Unlike `std::vector` or `std::make_unique`, the memory is not written by the calling thread before.
+     */
+    template<typename T>
+    std::unique_ptr<T[]> makeFirstTouched(ThreadPool& pool, size_t count, T const& value = T{})
+    {
+        static_assert(std::is_trivially_default_constructible_v<T> && std::is_trivially_destructible_v<T>, "Only arrays of trivial types can be allocated without writing to them");
+        std::unique_ptr<T[]> data{ new T[count] };
+        firstTouch(pool, data.get(), count, value);
+        return data;
+    }
+
+#ifdef SugarPPNamespace
+}
+#endif
@@ -4,17 +4,20 @@
  *
  * \author Peter
  * \date   September 2020
- * \note Not to be confused with C++20's ranges
+ * \note Not to be confused with C++20's ranges. @ref parallel is in parallel.hpp, which is included unless SugarPPLeanHeaders is defined
  *********************************************************************/
 
 #pragma once
 #include <type_traits>
 #include <random>
-#include <iostream>
+#include <ostream>
 #include <algorithm>
-#include <variant>
 #include <array>
-#include <thread>
+#include <cstddef>
+#include <cstdlib>  //for rand()
+#include <iterator>
+#include <memory>
+#include <tuple>
 #include <vector>
 
 
@@ -25,12 +28,17 @@ namespace SugarPP
 
     /**
      * @brief Shared random engine for all @ref Range
-     * @details Stored a `static` protected `std::mt19937` member, which will be initialized at first use.
+     * @details A `static` `std::mt19937` returned by a protected function, which is initialized at first use.
+     * It is not a `static inline` member, as GCC 12 crashes writing one into the sugarpp module when the module also has generic lambdas.
      */
     class RangeRandomEngineBase
     {
     protected:
-        static inline std::mt19937 rdEngine{ std::random_device{}() };
+        static std::mt19937& rdEngine()
+        {
+            static std::mt19937 engine{ std::random_device{}() };
+            return engine;
+        }
     };
 
 
@@ -347,7 +355,7 @@ namespace SugarPP
          */
         [[nodiscard]] static auto& getRandomEngine()
         {
-            return rdEngine;
+            return rdEngine();
         }
 
         /**
@@ -355,7 +363,7 @@ namespace SugarPP
          */
         [[nodiscard]] auto rand() const
         {
-            return getDistribution()(rdEngine);
+            return getDistribution()(rdEngine());
         }
 
         /**
@@ -371,7 +379,24 @@ namespace SugarPP
         [[nodiscard]] auto rand() const
         {
             std::array<value_type, N> values;
-            std::generate(values.begin(), values.end(), [dist = getDistribution()]() mutable { return dist(rdEngine); });
+            std::generate(values.begin(), values.end(), [dist = getDistribution()]() mutable { return dist(rdEngine()); });
+            return values;
+        }
+
+        /**
+         * @brief Return a `std::vector` of `count` random numbers within the range, allocated with `allocator`
+         * @note
+         * The vector is allocated once, so that a large one can use a @ref HugePageAllocator or an @ref AlignedAllocator
+         * ~~~~{.cpp}
+         * auto const samples = Range(0.0, 1.0).rand(size_t{ 1 } << 28, HugePageAllocator<double>{});
+         * ~~~~
+         */
+        template<typename Allocator = std::allocator<value_type>>
+        [[nodiscard]] auto rand(size_t count, Allocator const& allocator = {}) const
+        {
+            std::vector<value_type, Allocator> values(allocator);
+            values.reserve(count);
+            std::generate_n(std::back_inserter(values), count, [dist = getDistribution()]() mutable { return dist(rdEngine()); });
             return values;
         }
 
@@ -408,7 +433,7 @@ namespace SugarPP
         {
             std::generate_n(container.size() >= count ? std::begin(container) : std::back_inserter(container), count, [dist = getDistribution()]() mutable
             {
-                return dist(rdEngine);
+                return dist(rdEngine());
             });
         }
 
@@ -424,7 +449,7 @@ namespace SugarPP
             //The maximum value of std::uniform_int_distribution is inclusive so need to -1 to exclude the max value edge case
             std::generate(begin, end, [dist = getDistribution()]() mutable
             {
-                return dist(rdEngine);
+                return dist(rdEngine());
             });
         }
 
@@ -595,61 +620,11 @@ namespace SugarPP
     template<typename Container>
     Range(Container&&)->Range<RangeType::Container, Container, long long>;
 
-    /**
-     * @brief A parallel for loop for a specific range
-     * @tparam Range The type of [range], which is of the form: Range<value_type, value_type, stepSizeType>
-     * @tparam Func The type of [func], which is of the form: Func<ReturnType(Range)>
-     * @param range The range loop variable
-     * @param func Should be a function that takes a range as parameter and may or may not return stuff
-     * @param threadCount The hint of number of threads to launch. The real number of threads depend on the number of steps in [range]
-     * @return std::vector<ReturnType> / void if [func] returns void
-    */
-    template<typename RangeType, typename Func>
-    auto parallel(RangeType range, Func&& func, unsigned threadCount = std::thread::hardware_concurrency())
-        ->std::enable_if_t< std::is_same_v<std::invoke_result_t<std::remove_reference_t<Func>, RangeType>, void>>
-    {
-        /* If there are 7 tasks but 8 threads, we only launch 7 threads
-         *
-         */
-        const auto steps = range.steps();
-        const auto threadNum = std::min<std::common_type_t<decltype(steps), decltype(threadCount)>>(steps, threadCount);
-        const auto perThread = steps / threadNum;
-        std::vector<std::thread> threads;
-        threads.reserve(threadNum);
-
-
-        //for the first (threadNum-1) threads
-        for (auto i = 0; i < threadNum - 1; ++i)
-            threads.emplace_back([&func, &range, perThread] { func(Range{ *range, *(range += perThread), range.step }); });
-        //the last thread
-        threads.emplace_back([&func, &range] {func(Range{ *(++range), range.end(), range.step }); });
-        for (auto& thread : threads)
-            thread.join();
-
-    }
-
-
-    template<typename RangeType, typename Func>
-    auto parallel(RangeType range, Func&& func, unsigned threadCount)
-        ->std::enable_if_t<!std::is_same_v<std::invoke_result_t<std::remove_reference_t<Func>, RangeType>, void>>
-    {
-        const auto steps = range.steps();
-        const auto threadNum = std::min<std::common_type_t<decltype(steps), decltype(threadCount)>>(steps, threadCount);
-        const auto perThread = steps / threadNum;
-        std::vector<std::thread> threads;
-        threads.reserve(threadNum);
-
-        using result_type = std::invoke_result_t<std::remove_reference_t<Func>, RangeType>;
-        std::vector<result_type> results;
-        results.reserve(threadNum);
-        for (auto i = 0; i < threadNum; ++i)
-            threads.emplace_back([&func, &range, perThread, &results] { results.emplace_back(std::forward<result_type>(func(Range{ *range, *(range += perThread), range.step }))); });
-        //the last thread
-        threads.emplace_back([&func, &range, &results] {results.emplace_back(std::forward<result_type>(func(Range{ *range, range.end(), range.step }))); });
-        for (auto& thread : threads)
-            thread.join();
-        return results;
-    }
 #ifdef SugarPPNamespace
 }
-#endif
\ No newline at end of file
+#endif
+
+/*parallel used to be here, so it is still included unless SugarPPLeanHeaders is defined*/
+#ifndef SugarPPLeanHeaders
+#include "parallel.hpp"
+#endif
@@ -0,0 +1,585 @@
+/*****************************************************************//**
+ * \file   reduce.hpp
+ * \brief  Python-style sum, min, max, minmax, any and all over iterables and numeric @ref Range
+ *
+ * \author Peter
+ * \date   October 2026
+ *********************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "range.hpp"
+#include "parallel.hpp"
+#include "../traits/traits.hpp"
+
+#ifdef SugarPPNamespace
+namespace SugarPP
+{
+#endif
+
+    /**
+     * @brief How @ref sum adds floating point numbers. Integers are always added with the fast kernel.
+     */
+    enum class Summation
+    {
+        Fast,       /**< Several independent accumulators, which is the fastest and already more accurate than a single accumulator */
+        Pairwise,   /**< Recursively add the sums of both halves, so the error grows with O(log n) instead of O(n) */
+        Kahan       /**< Compensated summation, so the error does not grow with n. It is a few times slower, and broken by `-ffast-math` */
+    };
+
+    namespace Reduce_detail
+    {
+        template<typename T>
+        using SumType = std::decay_t<decltype(std::declval<T>() + std::declval<T>())>;
+
+        template<typename Iterable>
+        using ElementType = std::decay_t<decltype(*std::begin(std::declval<Iterable&>()))>;
+
+        template<typename T>
+        struct is_numeric_range : std::false_type {};
+
+        template<typename ValueType, typename StepType>
+        struct is_numeric_range<Range<RangeType::Numeric, ValueType, StepType>> : std::true_type {};
+
+        /**
+         * @brief Whether `Iterable` stores arithmetic values contiguously, like `std::vector`, `std::array` or a C array, which the kernels read directly
+         */
+        template<typename Iterable, typename = void>
+        struct contiguous_arithmetic : std::false_type {};
+
+        template<typename Iterable>
+        struct contiguous_arithmetic<Iterable, std::void_t<decltype(std::data(std::declval<Iterable&>())), decltype(std::size(std::declval<Iterable&>()))>>
+            : std::is_arithmetic<std::remove_cv_t<std::remove_pointer_t<decltype(std::data(std::declval<Iterable&>()))>>> {};
+
+        /**
+         * @brief The number of independent accumulators of the kernels, which is two 256-bit registers of `T`
+         * @details The kernels are plain loops over arrays of accumulators with no dependency between them,
+         * which compilers turn into SIMD instructions of whatever instruction set is enabled, while also hiding the latency of the additions.
+         */
+        template<typename T>
+        constexpr size_t lanes = sizeof(T) <= 8 ? 64 / sizeof(T) : 4;
+
+        /**
+         * @brief The minimum number of elements of a chunk when running in parallel
+         */
+        constexpr size_t parallelGrain = size_t{ 1 } << 15;
+
+        template<typename R, size_t N>
+        R addLanes(R(&accumulators)[N])
+        {
+            for (auto width = N / 2; width != 0; width /= 2)
+            {
+                for (size_t j = 0; j < width; ++j)
+                    accumulators[j] += accumulators[j + width];
+            }
+            return accumulators[0];
+        }
+
+        /**
+         * @brief Add `value` to `sum`, keeping the lost low-order bits in `compensation`, which is Neumaier's variant of Kahan summation
+         */
+        template<typename R>
+        void addCompensated(R& sum, R& compensation, R value)
+        {
+            auto const total = sum + value;
+            if (std::abs(sum) >= std::abs(value))
+                compensation += (sum - total) + value;
+            else
+                compensation += (value - total) + sum;
+            sum = total;
+        }
+
+        template<typename R, typename T>
+        R sumFast(T const* data, size_t count)
+        {
+            constexpr auto width = lanes<R>;
+            R accumulators[width]{};
+            size_t i = 0;
+            for (; i + width <= count; i += width)
+            {
+                for (size_t j = 0; j < width; ++j)
+                    accumulators[j] += static_cast<R>(data[i + j]);
+            }
+            for (size_t j = 0; i < count; ++i, ++j)
+                accumulators[j] += static_cast<R>(data[i]);
+            return addLanes(accumulators);
+        }
+
+        template<typename R, typename T>
+        R sumPairwise(T const* data, size_t count)
+        {
+            if (count <= 8 * lanes<R>)
+                return sumFast<R>(data, count);
+            auto const half = count / 2 / lanes<R> * lanes<R>;
+            return sumPairwise<R>(data, half) + sumPairwise<R>(data + half, count - half);
+        }
+
+        template<typename R, typename T>
+        R sumKahan(T const* data, size_t count)
+        {
+            constexpr auto width = lanes<R>;
+            R sums[width]{};
+            R compensations[width]{};
+            auto const add = [&sums, &compensations](size_t j, R value)
+            {
+                auto const y = value - compensations[j];
+                auto const total = sums[j] + y;
+                compensations[j] = (total - sums[j]) - y;
+                sums[j] = total;
+            };
+            size_t i = 0;
+            for (; i + width <= count; i += width)
+            {
+                for (size_t j = 0; j < width; ++j)
+                    add(j, static_cast<R>(data[i + j]));
+            }
+            for (size_t j = 0; i < count; ++i, ++j)
+                add(j, static_cast<R>(data[i]));
+
+            R sum{};
+            R compensation{};
+            for (size_t j = 0; j < width; ++j)
+            {
+                addCompensated(sum, compensation, sums[j]);
+                addCompensated(sum, compensation, -compensations[j]);
+            }
+            return sum + compensation;
+        }
+
+        template<typename R, typename T>
+        R sumContiguous(T const* data, size_t count, Summation summation)
+        {
+            if constexpr (std::is_floating_point_v<R>)
+            {
+                if (summation == Summation::Pairwise)
+                    return sumPairwise<R>(data, count);
+                if (summation == Summation::Kahan)
+                    return sumKahan<R>(data, count);
+            }
+            return sumFast<R>(data, count);
+        }
+
+        /**
+         * @brief Return the smallest and the largest of `count` values at `data`, where `count` is not 0
+         * @note With NaN in the data, the result is unspecified
+         */
+        template<typename T>
+        std::pair<T, T> extremes(T const* data, size_t count)
+        {
+            constexpr auto width = lanes<T>;
+            auto low = data[0];
+            auto high = data[0];
+            size_t i = 0;
+            if (count >= width)
+            {
+                T lows[width];
+                T highs[width];
+                for (size_t j = 0; j < width; ++j)
+                    lows[j] = highs[j] = data[j];
+                for (i = width; i + width <= count; i += width)
+                {
+                    for (size_t j = 0; j < width; ++j)
+                    {
+                        auto const value = data[i + j];
+                        lows[j] = value < lows[j] ? value : lows[j];
+                        highs[j] = highs[j] < value ? value : highs[j];
+                    }
+                }
+                for (size_t j = 0; j < width; ++j)
+                {
+                    low = lows[j] < low ? lows[j] : low;
+                    high = high < highs[j] ? highs[j] : high;
+                }
+            }
+            for (; i < count; ++i)
+            {
+                low = data[i] < low ? data[i] : low;
+                high = high < data[i] ? data[i] : high;
+            }
+            return { low, high };
+        }
+
+        /**
+         * @brief Return whether any of the `count` values at `data` is non-zero if `Truth`, or zero otherwise
+         * @details The values are checked in blocks without branches, and `stop` is checked between the blocks
+         */
+        template<bool Truth, typename T>
+        bool anyIs(T const* data, size_t count, std::atomic<bool> const& stop)
+        {
+            constexpr size_t block = 1024;
+            for (size_t i = 0; i < count; i += block)
+            {
+                auto const last = std::min(count, i + block);
+                unsigned char found = 0;
+                for (auto j = i; j < last; ++j)
+                    found |= static_cast<unsigned char>((data[j] != T{}) == Truth);
+                if (found)
+                    return true;
+                if (stop.load(std::memory_order_relaxed))
+                    return false;
+            }
+            return false;
+        }
+
+        /**
+         * @brief Return `func(first, last)` for consecutive chunks of [0, count), which run on `pool` if it is not null and `count` is large enough
+         */
+        template<typename Func>
+        auto forChunks(ThreadPool* pool, size_t count, Func&& func)
+        {
+            using Result = std::invoke_result_t<Func&, size_t, size_t>;
+            auto const chunkCount = pool ? std::min<size_t>(pool->size(), count / parallelGrain) : 0;
+            if (chunkCount < 2)
+                return std::vector<Result>{ func(size_t{ 0 }, count) };
+
+            auto runChunk = [&func](auto chunk) { return func(static_cast<size_t>(*chunk), static_cast<size_t>(chunk.end())); };
+            return Range_detail::parallelOn(*pool, Range(size_t{ 0 }, count), runChunk, static_cast<unsigned>(chunkCount));
+        }
+
+        template<typename R, typename Iterable>
+        R sum(ThreadPool* pool, Iterable& iterable, R start, Summation summation)
+        {
+            using Container = std::remove_cv_t<Iterable>;
+            /*only for integers, as a floating Range adds up its steps, which can give one more value than the closed form counts*/
+            if constexpr (is_numeric_range<Container>::value && std::is_integral_v<typename Container::value_type> && std::is_arithmetic_v<R>)
+            {
+                /*n * first + step * n * (n - 1) / 2*/
+                auto const n = Range_detail::count(iterable);
+                if (n == 0)
+                    return start;
+                auto const triangle = n % 2 == 0 ? n / 2 * (n - 1) : (n - 1) / 2 * n;
+                return start + static_cast<R>(n) * static_cast<R>(*iterable) + static_cast<R>(iterable.step) * static_cast<R>(triangle);
+            }
+            else if constexpr (contiguous_arithmetic<Container>::value && std::is_arithmetic_v<R>)
+            {
+                auto const data = std::data(iterable);
+                auto const partials = forChunks(pool, static_cast<size_t>(std::size(iterable)), [data, summation](size_t first, size_t last)
+                {
+                    return sumContiguous<R>(data + first, last - first, summation);
+                });
+                if constexpr (std::is_floating_point_v<R>)
+                {
+                    if (summation == Summation::Kahan)
+                    {
+                        R compensation{};
+                        for (auto partial : partials)
+                            addCompensated(start, compensation, partial);
+                        return start + compensation;
+                    }
+                }
+                for (auto partial : partials)
+                    start += partial;
+                return start;
+            }
+            else
+            {
+                for (auto&& element : iterable)
+                    start = std::move(start) + element;
+                return start;
+            }
+        }
+
+        /**
+         * @brief Return the smallest and the largest element of `iterable`, or nothing if it is empty
+         */
+        template<typename Iterable>
+        auto minmax(ThreadPool* pool, Iterable& iterable)
+        {
+            using Container = std::remove_cv_t<Iterable>;
+            using T = ElementType<Iterable>;
+            std::optional<std::pair<T, T>> result;
+            if constexpr (is_numeric_range<Container>::value && std::is_integral_v<typename Container::value_type>)
+            {
+                auto const n = Range_detail::count(iterable);
+                if (n != 0)
+                    result.emplace(*iterable, static_cast<T>(*iterable + (n - 1) * iterable.step));
+            }
+            else if constexpr (contiguous_arithmetic<Container>::value)
+            {
+                auto const data = std::data(iterable);
+                auto const count = static_cast<size_t>(std::size(iterable));
+                if (count == 0)
+                    return result;
+                auto const partials = forChunks(pool, count, [data](size_t first, size_t last) { return extremes(data + first, last - first); });
+                result = partials.front();
+                for (auto const& [low, high] : partials)
+                {
+                    result->first = low < result->first ? low : result->first;
+                    result->second = result->second < high ? high : result->second;
+                }
+            }
+            else
+            {
+                for (auto&& element : iterable)
+                {
+                    if (!result)
+                        result.emplace(element, element);
+                    else if (element < result->first)
+                        result->first = element;
+                    else if (result->second < element)
+                        result->second = element;
+                }
+            }
+            return result;
+        }
+
+        /**
+         * @brief Return whether any element of `iterable` converts to `Truth`
+         */
+        template<bool Truth, typename Iterable>
+        bool anyIs(ThreadPool* pool, Iterable& iterable)
+        {
+            if constexpr (contiguous_arithmetic<std::remove_cv_t<Iterable>>::value)
+            {
+                auto const data = std::data(iterable);
+                std::atomic<bool> found{ false };
+                forChunks(pool, static_cast<size_t>(std::size(iterable)), [data, &found](size_t first, size_t last)
+                {
+                    if (anyIs<Truth>(data + first, last - first, found))
+                        found.store(true, std::memory_order_relaxed);
+                    return true;
+                });
+                return found.load();
+            }
+            else
+            {
+                for (auto&& element : iterable)
+                {
+                    if (static_cast<bool>(element) == Truth)
+                        return true;
+                }
+                return false;
+            }
+        }
+
+        [[noreturn]] inline void throwEmpty(char const* function)
+        {
+            throw std::invalid_argument{ std::string{ function } + "() arg is an empty sequence" };
+        }
+    }
+
+    /**
+     * @brief Return the sum of the elements of `iterable`, like `sum()` in Python
+     * @param summation How floating point numbers are added, see @ref Summation
+     * @return The sum, of the type of adding two elements, so `int` for `char` elements. Use the overload taking `start` for a wider type
+     * @details Contiguous arithmetic elements are added by SIMD kernels, and an integer @ref Range is summed in O(1).
+     * Other iterables are summed with `operator+` in order.
+     */
+    template<typename Iterable, typename = std::enable_if_t<Traits_detail::iterable_lvalue<Iterable>::value>>
+    auto sum(Iterable&& iterable, Summation summation = Summation::Fast)
+    {
+        using R = Reduce_detail::SumType<Reduce_detail::ElementType<Iterable>>;
+        return Reduce_detail::sum(nullptr, iterable, R{}, summation);
+    }
+
+    /**
+     * @brief Return `start` plus the sum of the elements of `iterable`, like `sum(iterable, start)` in Python
+     * @return The sum, of the type of adding an element to `start`, so `sum(v, 0ll)` does not overflow for an `int` container
+     * and `sum(v, 0)` does not truncate for a `double` container
+     */
+    template<typename Iterable, typename Start, typename = std::enable_if_t<Traits_detail::iterable_lvalue<Iterable>::value && !std::is_same_v<Start, Summation>>>
+    auto sum(Iterable&& iterable, Start start, Summation summation = Summation::Fast)
+    {
+        using R = std::decay_t<decltype(std::declval<Start>() + std::declval<Reduce_detail::ElementType<Iterable>>())>;
+        return Reduce_detail::sum(nullptr, iterable, static_cast<R>(std::move(start)), summation);
+    }
+
+    /**
+     * @brief Return the sum of the elements of `iterable`, in parallel on the pool of `policy` if they are contiguous arithmetic values
+     * @note A floating point sum may differ in the last bits from the sequential one, as the values are added in another order
+     */
+    template<typename Iterable>
+    auto sum(ParallelPolicy policy, Iterable&& iterable, Summation summation = Summation::Fast)
+    {
+        using R = Reduce_detail::SumType<Reduce_detail::ElementType<Iterable>>;
+        return Reduce_detail::sum(&policy.getPool(), iterable, R{}, summation);
+    }
+
+    /**
+     * @brief Return `start` plus the sum of the elements of `iterable`, in parallel on the pool of `policy` if they are contiguous arithmetic values
+     */
+    template<typename Iterable, typename Start, typename = std::enable_if_t<!std::is_same_v<Start, Summation>>>
+    auto sum(ParallelPolicy policy, Iterable&& iterable, Start start, Summation summation = Summation::Fast)
+    {
+        using R = std::decay_t<decltype(std::declval<Start>() + std::declval<Reduce_detail::ElementType<Iterable>>())>;
+        return Reduce_detail::sum(&policy.getPool(), iterable, static_cast<R>(std::move(start)), summation);
+    }
+
+    /**
+     * @brief Return the smallest element of `iterable`, like `min()` in Python
+     * @throw std::invalid_argument if `iterable` is empty
+     */
+    template<typename Iterable, typename = std::enable_if_t<Traits_detail::iterable_lvalue<Iterable>::value>>
+    auto min(Iterable&& iterable)
+    {
+        auto result = Reduce_detail::minmax(nullptr, iterable);
+        if (!result)
+            Reduce_detail::throwEmpty("min");
+        return result->first;
+    }
+
+    /**
+     * @brief Return the smallest element of `iterable`, or `defaultValue` if it is empty, like `min(iterable, default=...)` in Python
+     */
+    template<typename Iterable, typename Default, typename = std::enable_if_t<Traits_detail::iterable_lvalue<Iterable>::value>>
+    auto min(Iterable&& iterable, Default&& defaultValue)
+    {
+        auto result = Reduce_detail::minmax(nullptr, iterable);
+        return result ? result->first : Reduce_detail::ElementType<Iterable>(std::forward<Default>(defaultValue));
+    }
+
+    /**
+     * @brief Return the smallest element of `iterable`, in parallel on the pool of `policy` if they are contiguous arithmetic values
+     * @throw std::invalid_argument if `iterable` is empty
+     */
+    template<typename Iterable>
+    auto min(ParallelPolicy policy, Iterable&& iterable)
+    {
+        auto result = Reduce_detail::minmax(&policy.getPool(), iterable);
+        if (!result)
+            Reduce_detail::throwEmpty("min");
+        return result->first;
+    }
+
+    /**
+     * @brief Return the largest element of `iterable`, like `max()` in Python
+     * @throw std::invalid_argument if `iterable` is empty
+     */
+    template<typename Iterable, typename = std::enable_if_t<Traits_detail::iterable_lvalue<Iterable>::value>>
+    auto max(Iterable&& iterable)
+    {
+        auto result = Reduce_detail::minmax(nullptr, iterable);
+        if (!result)
+            Reduce_detail::throwEmpty("max");
+        return result->second;
+    }
+
+    /**
+     * @brief Return the largest element of `iterable`, or `defaultValue` if it is empty, like `max(iterable, default=...)` in Python
+     */
+    template<typename Iterable, typename Default, typename = std::enable_if_t<Traits_detail::iterable_lvalue<Iterable>::value>>
+    auto max(Iterable&& iterable, Default&& defaultValue)
+    {
+        auto result = Reduce_detail::minmax(nullptr, iterable);
+        return result ? result->second : Reduce_detail::ElementType<Iterable>(std::forward<Default>(defaultValue));
+    }
+
+    /**
+     * @brief Return the largest element of `iterable`, in parallel on the pool of `policy` if they are contiguous arithmetic values
+     * @throw std::invalid_argument if `iterable` is empty
+     */
+    template<typename Iterable>
+    auto max(ParallelPolicy policy, Iterable&& iterable)
+    {
+        auto result = Reduce_detail::minmax(&policy.getPool(), iterable);
+        if (!result)
+            Reduce_detail::throwEmpty("max");
+        return result->second;
+    }
+
+    /**
+     * @brief Return a `std::pair` of the smallest and the largest element of `iterable`, in a single pass
+     * @throw std::invalid_argument if `iterable` is empty
+     */
+    template<typename Iterable, typename = std::enable_if_t<Traits_detail::iterable_lvalue<Iterable>::value>>
+    auto minmax(Iterable&& iterable)
+    {
+        auto result = Reduce_detail::minmax(nullptr, iterable);
+        if (!result)
+            Reduce_detail::throwEmpty("minmax");
+        return *result;
+    }
+
+    /**
+     * @brief Return a `std::pair` of the smallest and the largest element of `iterable`, in parallel on the pool of `policy` if they are contiguous arithmetic values
+     * @throw std::invalid_argument if `iterable` is empty
+     */
+    template<typename Iterable>
+    auto minmax(ParallelPolicy policy, Iterable&& iterable)
+    {
+        auto result = Reduce_detail::minmax(&policy.getPool(), iterable);
+        if (!result)
+            Reduce_detail::throwEmpty("minmax");
+        return *result;
+    }
+
+    /**
+     * @brief Return whether any element of `iterable` is true when converted to `bool`, like `any()` in Python
+     */
+    template<typename Iterable, typename = std::enable_if_t<Traits_detail::iterable_lvalue<Iterable>::value>>
+    bool any(Iterable&& iterable)
+    {
+        return Reduce_detail::anyIs<true>(nullptr, iterable);
+    }
+
+    /**
+     * @brief Return whether `predicate` returns true for any element of `iterable`, like `any { }` in Kotlin
+     */
+    template<typename Iterable, typename Predicate, typename = std::enable_if_t<Traits_detail::iterable_lvalue<Iterable>::value>>
+    bool any(Iterable&& iterable, Predicate&& predicate)
+    {
+        for (auto&& element : iterable)
+        {
+            if (predicate(element))
+                return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Return whether any element of `iterable` is true, in parallel on the pool of `policy` if they are contiguous arithmetic values
+     * @details The chunks stop early once an element is found
+     */
+    template<typename Iterable>
+    bool any(ParallelPolicy policy, Iterable&& iterable)
+    {
+        return Reduce_detail::anyIs<true>(&policy.getPool(), iterable);
+    }
+
+    /**
+     * @brief Return whether every element of `iterable` is true when converted to `bool`, like `all()` in Python, which is true if it is empty
+     */
+    template<typename Iterable, typename = std::enable_if_t<Traits_detail::iterable_lvalue<Iterable>::value>>
+    bool all(Iterable&& iterable)
+    {
+        return !Reduce_detail::anyIs<false>(nullptr, iterable);
+    }
+
+    /**
+     * @brief Return whether `predicate` returns true for every element of `iterable`, like `all { }` in Kotlin
+     */
+    template<typename Iterable, typename Predicate, typename = std::enable_if_t<Traits_detail::iterable_lvalue<Iterable>::value>>
+    bool all(Iterable&& iterable, Predicate&& predicate)
+    {
+        for (auto&& element : iterable)
+        {
+            if (!predicate(element))
+                return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Return whether every element of `iterable` is true, in parallel on the pool of `policy` if they are contiguous arithmetic values
+     * @details The chunks stop early once a false element is found
+     */
+    template<typename Iterable>
+    bool all(ParallelPolicy policy, Iterable&& iterable)
+    {
+        return !Reduce_detail::anyIs<false>(&policy.getPool(), iterable);
+    }
+
+#ifdef SugarPPNamespace
+}
+#endif
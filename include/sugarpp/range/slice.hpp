@@ -0,0 +1,272 @@
+/*****************************************************************//**
+ * \file   slice.hpp
+ * \brief  Python-style slicing of containers and strings into views, without copying
+ *
+ * \author Peter
+ * \date   October 2026
+ * \note The views refer to the elements of the container, so it must outlive them, and not be resized while they are used
+ *********************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#if __has_include(<version>)
+#include <version>
+#endif
+
+#ifdef __cpp_lib_span
+#include <span>
+#endif
+
+#ifdef SugarPPNamespace
+namespace SugarPP
+{
+#endif
+
+    /**
+     * @brief A view of `size()` contiguous elements, like `std::span` in C++20
+     * @details Being contiguous, the reductions and the sort of SugarPP use the same SIMD kernels on it as on a `std::vector`.
+     */
+    template<typename T>
+    class Span
+    {
+        T* first = nullptr;
+        size_t count = 0;
+    public:
+        using element_type = T;
+        using value_type = std::remove_cv_t<T>;
+        using size_type = size_t;
+        using difference_type = std::ptrdiff_t;
+        using reference = T&;
+        using iterator = T*;
+
+        constexpr Span() = default;
+        constexpr Span(T* data, size_t size) :first(data), count(size) {}
+
+        [[nodiscard]] constexpr T* data() const { return first; }
+        [[nodiscard]] constexpr size_t size() const { return count; }
+        [[nodiscard]] constexpr bool empty() const { return count == 0; }
+        constexpr T* begin() const { return first; }
+        constexpr T* end() const { return first + count; }
+        constexpr T& operator[](size_t index) const { return first[index]; }
+        constexpr T& front() const { return first[0]; }
+        constexpr T& back() const { return first[count - 1]; }
+
+#ifdef __cpp_lib_span
+        constexpr operator std::span<T>() const { return { first, count }; }
+#endif
+    };
+
+    /**
+     * @brief A view of every `step`-th element of a random access container, where `step` can be negative
+     */
+    template<typename Iterator>
+    class StridedView
+    {
+        Iterator origin;            //the first element of the container, as offsets are relative to it
+        std::ptrdiff_t start = 0;
+        std::ptrdiff_t step = 1;
+        size_t count = 0;
+    public:
+        /**
+         * @brief The random access iterator of a @ref StridedView
+         * @details It stores an offset from the first element of the container instead of an iterator to the element, so that
+         * the end iterator, which may be before the beginning or past the end of the container, is never formed.
+         */
+        class iterator
+        {
+            Iterator origin;
+            std::ptrdiff_t offset = 0;
+            std::ptrdiff_t step = 1;
+        public:
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = typename std::iterator_traits<Iterator>::value_type;
+            using difference_type = std::ptrdiff_t;
+            using pointer = typename std::iterator_traits<Iterator>::pointer;
+            using reference = typename std::iterator_traits<Iterator>::reference;
+
+            iterator() = default;
+            iterator(Iterator origin, std::ptrdiff_t offset, std::ptrdiff_t step) :origin(origin), offset(offset), step(step) {}
+
+            reference operator*() const { return origin[offset]; }
+            pointer operator->() const { return std::addressof(origin[offset]); }
+            reference operator[](difference_type n) const { return origin[offset + n * step]; }
+
+            iterator& operator++() { offset += step; return *this; }
+            iterator operator++(int) { auto copy = *this; offset += step; return copy; }
+            iterator& operator--() { offset -= step; return *this; }
+            iterator operator--(int) { auto copy = *this; offset -= step; return copy; }
+            iterator& operator+=(difference_type n) { offset += n * step; return *this; }
+            iterator& operator-=(difference_type n) { offset -= n * step; return *this; }
+            friend iterator operator+(iterator iter, difference_type n) { return iter += n; }
+            friend iterator operator+(difference_type n, iterator iter) { return iter += n; }
+            friend iterator operator-(iterator iter, difference_type n) { return iter -= n; }
+            friend difference_type operator-(iterator const& lhs, iterator const& rhs) { return (lhs.offset - rhs.offset) / lhs.step; }
+
+            bool operator==(iterator const& rhs) const { return offset == rhs.offset; }
+            bool operator!=(iterator const& rhs) const { return offset != rhs.offset; }
+            bool operator<(iterator const& rhs) const { return rhs - *this > 0; }
+            bool operator>(iterator const& rhs) const { return rhs < *this; }
+            bool operator<=(iterator const& rhs) const { return !(rhs < *this); }
+            bool operator>=(iterator const& rhs) const { return !(*this < rhs); }
+        };
+
+        using value_type = typename iterator::value_type;
+        using reference = typename iterator::reference;
+        using size_type = size_t;
+        using difference_type = std::ptrdiff_t;
+
+        StridedView() = default;
+        StridedView(Iterator origin, std::ptrdiff_t start, std::ptrdiff_t step, size_t count) :origin(origin), start(start), step(step), count(count) {}
+
+        [[nodiscard]] size_t size() const { return count; }
+        [[nodiscard]] bool empty() const { return count == 0; }
+        iterator begin() const { return { origin, start, step }; }
+        iterator end() const { return { origin, start + static_cast<std::ptrdiff_t>(count) * step, step }; }
+        reference operator[](size_t index) const { return origin[start + static_cast<std::ptrdiff_t>(index) * step]; }
+        reference front() const { return origin[start]; }
+        reference back() const { return (*this)[count - 1]; }
+    };
+
+    namespace Slice_detail
+    {
+        /**
+         * @brief The first index, the step and the number of elements of a slice, computed like `slice.indices()` in Python
+         */
+        struct Bounds
+        {
+            std::ptrdiff_t start;
+            std::ptrdiff_t step;
+            size_t count;
+        };
+
+        inline Bounds resolve(std::ptrdiff_t length, std::optional<std::ptrdiff_t> start, std::optional<std::ptrdiff_t> stop, std::ptrdiff_t step)
+        {
+            if (step == 0)
+                throw std::invalid_argument{ "slice step cannot be zero" };
+
+            /*a negative step can start from the last element and stop before the first one*/
+            auto const lower = step > 0 ? std::ptrdiff_t{ 0 } : std::ptrdiff_t{ -1 };
+            auto const upper = step > 0 ? length : length - 1;
+            auto const clamp = [&](std::optional<std::ptrdiff_t> index, std::ptrdiff_t otherwise)
+            {
+                if (!index)
+                    return otherwise;
+                auto value = *index < 0 ? *index + length : *index;
+                return value < lower ? lower : (value > upper ? upper : value);
+            };
+            auto const first = clamp(start, step > 0 ? lower : upper);
+            auto const last = clamp(stop, step > 0 ? upper : lower);
+
+            size_t count = 0;
+            if (step > 0 && first < last)
+                count = static_cast<size_t>((last - first - 1) / step + 1);
+            else if (step < 0 && last < first)
+                count = static_cast<size_t>((first - last - 1) / -step + 1);
+            return { first, step, count };
+        }
+
+        template<typename T>
+        struct is_string : std::false_type {};
+
+        template<typename Char, typename Traits, typename Allocator>
+        struct is_string<std::basic_string<Char, Traits, Allocator>> : std::true_type {};
+
+        template<typename Char, typename Traits>
+        struct is_string<std::basic_string_view<Char, Traits>> : std::true_type {};
+
+        /**
+         * @brief The views which can be sliced as rvalues, as they do not own their elements
+         */
+        template<typename T>
+        struct is_view : std::false_type {};
+
+        template<typename T>
+        struct is_view<Span<T>> : std::true_type {};
+
+        template<typename Iterator>
+        struct is_view<StridedView<Iterator>> : std::true_type {};
+
+        template<typename Char, typename Traits>
+        struct is_view<std::basic_string_view<Char, Traits>> : std::true_type {};
+
+        template<typename Container, typename = void>
+        struct contiguous : std::false_type {};
+
+        template<typename Container>
+        struct contiguous<Container, std::void_t<decltype(std::data(std::declval<Container&>()))>> : std::true_type {};
+
+        template<typename Container>
+        constexpr void checkSliceable()
+        {
+            using Plain = std::remove_cv_t<std::remove_reference_t<Container>>;
+            static_assert(std::is_lvalue_reference_v<Container> || is_view<Plain>::value,
+                "slice() of a temporary container would dangle, store the container first");
+            static_assert(std::is_base_of_v<std::random_access_iterator_tag,
+                typename std::iterator_traits<decltype(std::begin(std::declval<Container&>()))>::iterator_category>,
+                "slice() needs a random access container");
+        }
+
+        template<typename Container>
+        auto stridedView(Container& container, Bounds bounds)
+        {
+            return StridedView<decltype(std::begin(container))>{ std::begin(container), bounds.start, bounds.step, bounds.count };
+        }
+    }
+
+    /**
+     * @brief Return the elements from `start` to `stop`, with Python semantics, like `container[start:stop]`
+     * @details
+     * Negative indices count from the end, and out of range indices are clamped. `std::nullopt` means from the beginning or
+     * to the end. Nothing is copied:
+     * - a string or a string view gives a `std::basic_string_view`
+     * - any other contiguous container, like `std::vector`, `std::array` or a C array, gives a @ref Span
+     * - other random access containers, like `std::deque`, give a @ref StridedView
+     * ~~~~{.cpp}
+     *     slice(v, 1, -1);             //v[1:-1]
+     *     slice(v, -3, std::nullopt);  //v[-3:]
+     * ~~~~
+     */
+    template<typename Container>
+    [[nodiscard]] auto slice(Container&& container, std::optional<std::ptrdiff_t> start, std::optional<std::ptrdiff_t> stop)
+    {
+        Slice_detail::checkSliceable<Container&&>();
+        using Plain = std::remove_cv_t<std::remove_reference_t<Container>>;
+        auto const bounds = Slice_detail::resolve(static_cast<std::ptrdiff_t>(std::size(container)), start, stop, 1);
+        if constexpr (Slice_detail::is_string<Plain>::value)
+            return std::basic_string_view<typename Plain::value_type, typename Plain::traits_type>{ container.data() + bounds.start, bounds.count };
+        else if constexpr (Slice_detail::contiguous<Container>::value)
+            return Span<std::remove_pointer_t<decltype(std::data(container))>>{ std::data(container) + bounds.start, bounds.count };
+        else
+            return Slice_detail::stridedView(container, bounds);
+    }
+
+    /**
+     * @brief Return every `step`-th element from `start` to `stop`, with Python semantics, like `container[start:stop:step]`
+     * @details A negative `step` goes backward, from the end when `start` is `std::nullopt`. The result is always a @ref StridedView,
+     * use the overload without `step` to get a contiguous view.
+     * ~~~~{.cpp}
+     *     slice(v, std::nullopt, std::nullopt, -1);    //v[::-1]
+     *     slice(v, 1, std::nullopt, 2);                //v[1::2]
+     * ~~~~
+     * @throw std::invalid_argument if `step` is 0
+     */
+    template<typename Container>
+    [[nodiscard]] auto slice(Container&& container, std::optional<std::ptrdiff_t> start, std::optional<std::ptrdiff_t> stop, std::ptrdiff_t step)
+    {
+        Slice_detail::checkSliceable<Container&&>();
+        return Slice_detail::stridedView(container, Slice_detail::resolve(static_cast<std::ptrdiff_t>(std::size(container)), start, stop, step));
+    }
+
+#ifdef SugarPPNamespace
+}
+#endif
@@ -0,0 +1,540 @@
+/*****************************************************************//**
+ * \file   sort.hpp
+ * \brief  Python-style sorted and an in-place sort, with radix sort for numeric keys and parallel merge sort for comparators
+ *
+ * \author Peter
+ * \date   October 2026
+ *********************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "range.hpp"
+#include "parallel.hpp"
+#include "../traits/traits.hpp"
+
+#ifdef SugarPPNamespace
+namespace SugarPP
+{
+#endif
+
+    /**
+     * @brief Whether @ref sort and @ref sorted keep the order of equal elements
+     * @details Radix sort, used for numeric keys, is always stable. Unstable only makes sorting with a comparator faster.
+     */
+    enum class Stability
+    {
+        Stable,     /**< Equal elements keep their order, like `sorted()` in Python */
+        Unstable    /**< Equal elements may be reordered, like `std::sort` */
+    };
+
+    namespace Sort_detail
+    {
+        using Traits_detail::Identity;
+
+        /**
+         * @brief Whether keys of type `K` can be radix sorted, which are integers and IEEE-754 `float` and `double`
+         */
+        template<typename K>
+        constexpr bool radixKey = std::is_integral_v<K>
+            || (std::is_floating_point_v<K> && std::numeric_limits<K>::is_iec559 && (sizeof(K) == 4 || sizeof(K) == 8));
+
+        /**
+         * @brief Map `key` to an unsigned integer of the same size, which compares the same way as `key`
+         * @details The sign bit of signed integers is flipped. Negative floating point numbers have all their bits flipped, the other ones only their sign bit,
+         * so -0.0 comes before 0.0 and NaN come before or after all the other numbers depending on their sign.
+         */
+        template<typename K>
+        auto toUnsigned(K key)
+        {
+            if constexpr (std::is_same_v<K, bool>)
+                return static_cast<unsigned char>(key);
+            else if constexpr (std::is_integral_v<K>)
+            {
+                using U = std::make_unsigned_t<K>;
+                if constexpr (std::is_signed_v<K>)
+                    return static_cast<U>(static_cast<U>(key) ^ static_cast<U>(U{ 1 } << (sizeof(U) * 8 - 1)));
+                else
+                    return static_cast<U>(key);
+            }
+            else
+            {
+                using U = std::conditional_t<sizeof(K) == 4, std::uint32_t, std::uint64_t>;
+                U bits;
+                std::memcpy(&bits, &key, sizeof(bits));
+                constexpr auto sign = U{ 1 } << (sizeof(U) * 8 - 1);
+                return (bits & sign) ? static_cast<U>(~bits) : static_cast<U>(bits | sign);
+            }
+        }
+
+        template<typename Container, typename = void>
+        struct contiguous : std::false_type {};
+
+        template<typename Container>
+        struct contiguous<Container, std::void_t<decltype(std::data(std::declval<Container&>()))>> : std::true_type {};
+
+        /**
+         * @brief Below this number of elements, `std::stable_sort` is faster than radix sort
+         */
+        constexpr size_t radixThreshold = 256;
+
+        /**
+         * @brief The minimum number of elements of a chunk when sorting in parallel
+         */
+        constexpr size_t parallelGrain = size_t{ 1 } << 14;
+
+        inline size_t chunksFor(ThreadPool* pool, size_t count)
+        {
+            return pool ? std::max<size_t>(1, std::min<size_t>(pool->size(), count / parallelGrain)) : 1;
+        }
+
+        /**
+         * @brief Call `func(chunk, first, last)` for `chunkCount` consecutive chunks of [0, count), on `pool` if it is not null
+         * @details The chunks are always the same for the same `chunkCount` and `count`, whether they run in parallel or not
+         */
+        template<typename Func>
+        void runChunks(ThreadPool* pool, size_t chunkCount, size_t count, Func&& func)
+        {
+            if (pool && chunkCount > 1)
+            {
+                Range_detail::forEachChunk(*pool, Range(size_t{ 0 }, count), chunkCount, [&func](size_t chunk, auto range)
+                {
+                    func(chunk, static_cast<size_t>(*range), static_cast<size_t>(range.end()));
+                });
+                return;
+            }
+            auto const perChunk = count / chunkCount;
+            auto const remainder = count % chunkCount;
+            for (size_t chunk = 0; chunk < chunkCount; ++chunk)
+            {
+                auto const first = chunk * perChunk + std::min(chunk, remainder);
+                func(chunk, first, first + perChunk + (chunk < remainder ? 1 : 0));
+            }
+        }
+
+        /**
+         * @brief Sort `count` items at `data` by the unsigned integer `keyOf(item)` with a stable LSD radix sort of 8-bit digits, using `buffer` of the same size
+         * @details Every chunk counts its digits, then moves its items to their positions, so a pass reads the items twice and writes them once.
+         * The passes where all the keys have the same digit are skipped, so small keys in wide types are cheap.
+         */
+        template<typename Item, typename KeyOf>
+        void radixSort(ThreadPool* pool, Item* data, Item* buffer, size_t count, KeyOf keyOf)
+        {
+            using U = decltype(keyOf(*data));
+            constexpr size_t passes = sizeof(U);
+            using Histogram = std::array<size_t, 256>;
+            auto const chunkCount = chunksFor(pool, count);
+
+            std::vector<std::array<Histogram, passes>> histograms(chunkCount);
+            runChunks(pool, chunkCount, count, [&](size_t chunk, size_t first, size_t last)
+            {
+                auto& histogram = histograms[chunk];
+                for (auto& digits : histogram)
+                    digits.fill(0);
+                for (auto i = first; i < last; ++i)
+                {
+                    auto const key = keyOf(data[i]);
+                    for (size_t pass = 0; pass < passes; ++pass)
+                        ++histogram[pass][(key >> (pass * 8)) & 0xFF];
+                }
+            });
+
+            auto source = data;
+            auto target = buffer;
+            auto moved = false;
+            std::vector<Histogram> offsets(chunkCount);
+            for (size_t pass = 0; pass < passes; ++pass)
+            {
+                auto const shift = pass * 8;
+                auto const sameDigit = [&]
+                {
+                    for (size_t digit = 0; digit < 256; ++digit)
+                    {
+                        size_t total = 0;
+                        for (auto const& histogram : histograms)
+                            total += histogram[pass][digit];
+                        if (total != 0)
+                            return total == count;
+                    }
+                    return true;
+                };
+                if (sameDigit())
+                    continue;
+
+                if (moved)
+                {
+                    /*the items moved between the chunks in the previous passes, so count again*/
+                    runChunks(pool, chunkCount, count, [&](size_t chunk, size_t first, size_t last)
+                    {
+                        auto& digits = histograms[chunk][pass];
+                        digits.fill(0);
+                        for (auto i = first; i < last; ++i)
+                            ++digits[(keyOf(source[i]) >> shift) & 0xFF];
+                    });
+                }
+
+                size_t position = 0;
+                for (size_t digit = 0; digit < 256; ++digit)
+                {
+                    for (size_t chunk = 0; chunk < chunkCount; ++chunk)
+                    {
+                        offsets[chunk][digit] = position;
+                        position += histograms[chunk][pass][digit];
+                    }
+                }
+
+                runChunks(pool, chunkCount, count, [&](size_t chunk, size_t first, size_t last)
+                {
+                    auto& offset = offsets[chunk];
+                    for (auto i = first; i < last; ++i)
+                        target[offset[(keyOf(source[i]) >> shift) & 0xFF]++] = std::move(source[i]);
+                });
+                std::swap(source, target);
+                moved = true;
+            }
+
+            if (source != data)
+            {
+                runChunks(pool, chunkCount, count, [source, data](size_t, size_t first, size_t last)
+                {
+                    std::move(source + first, source + last, data + first);
+                });
+            }
+        }
+
+        /**
+         * @brief Return how many of the first `diagonal` elements of the stable merge of `left` and `right` come from `left`
+         */
+        template<typename Iterator, typename Compare>
+        size_t coRank(Iterator left, size_t leftCount, Iterator right, size_t rightCount, size_t diagonal, Compare& compare)
+        {
+            auto low = diagonal > rightCount ? diagonal - rightCount : 0;
+            auto high = std::min(diagonal, leftCount);
+            while (low < high)
+            {
+                auto const i = low + (high - low) / 2;
+                auto const j = diagonal - i;
+                /*left[i] is taken before right[j - 1], so more elements come from left*/
+                if (j > 0 && !compare(right[j - 1], left[i]))
+                    low = i + 1;
+                else
+                    high = i;
+            }
+            return low;
+        }
+
+        /**
+         * @brief Sort `count` elements at `data` with `compare`, by sorting a chunk per worker and merging them in rounds
+         * @details Every merge of a round is split into pieces at the same positions of the output, found by binary search,
+         * so the last rounds, with less merges than workers, still run on every worker.
+         */
+        template<typename T, typename Compare>
+        void mergeSort(ThreadPool* pool, T* data, size_t count, Compare& compare, Stability stability)
+        {
+            auto const sortChunk = [&compare, stability](T* first, T* last)
+            {
+                if (stability == Stability::Stable)
+                    std::stable_sort(first, last, compare);
+                else
+                    std::sort(first, last, compare);
+            };
+
+            auto const chunkCount = chunksFor(pool, count);
+            if constexpr (std::is_default_constructible_v<T>)
+            {
+                if (chunkCount > 1)
+                {
+                    std::vector<size_t> bounds{ 0 };
+                    runChunks(nullptr, chunkCount, count, [&bounds](size_t, size_t, size_t last) { bounds.push_back(last); });
+                    runChunks(pool, chunkCount, count, [data, &sortChunk](size_t, size_t first, size_t last) { sortChunk(data + first, data + last); });
+
+                    struct Piece
+                    {
+                        size_t left, middle, right;     //the runs are [left, middle) and [middle, right)
+                        size_t first, last;             //the output of the piece is [first, last)
+                        size_t begin, end;              //of which [left + begin, left + end) comes from the left run
+                    };
+                    std::unique_ptr<T[]> buffer{ new T[count] };
+                    auto source = data;
+                    auto target = buffer.get();
+                    while (bounds.size() > 2)
+                    {
+                        auto const runCount = bounds.size() - 1;
+                        auto const pieceCount = std::max<size_t>(1, chunkCount / (runCount / 2));
+                        std::vector<Piece> pieces;
+                        std::vector<size_t> nextBounds{ 0 };
+                        for (size_t run = 0; run < runCount; run += 2)
+                        {
+                            auto const left = bounds[run];
+                            auto const middle = bounds[run + 1];
+                            auto const right = run + 2 < bounds.size() ? bounds[run + 2] : middle;
+                            for (size_t piece = 0; piece < pieceCount; ++piece)
+                                pieces.push_back({ left, middle, right, left + (right - left) * piece / pieceCount, left + (right - left) * (piece + 1) / pieceCount, 0, 0 });
+                            nextBounds.push_back(right);
+                        }
+
+                        /*all the splits are found before merging, as merging moves from the elements the binary searches compare*/
+                        runChunks(pool, pieces.size(), pieces.size(), [&](size_t index, size_t, size_t)
+                        {
+                            auto& piece = pieces[index];
+                            auto const leftCount = piece.middle - piece.left;
+                            auto const rightCount = piece.right - piece.middle;
+                            piece.begin = coRank(source + piece.left, leftCount, source + piece.middle, rightCount, piece.first - piece.left, compare);
+                            piece.end = coRank(source + piece.left, leftCount, source + piece.middle, rightCount, piece.last - piece.left, compare);
+                        });
+                        runChunks(pool, pieces.size(), pieces.size(), [&](size_t index, size_t, size_t)
+                        {
+                            auto const& piece = pieces[index];
+                            std::merge(
+                                std::make_move_iterator(source + piece.left + piece.begin), std::make_move_iterator(source + piece.left + piece.end),
+                                std::make_move_iterator(source + piece.middle + (piece.first - piece.left - piece.begin)), std::make_move_iterator(source + piece.middle + (piece.last - piece.left - piece.end)),
+                                target + piece.first,
+                                compare);
+                        });
+                        bounds = std::move(nextBounds);
+                        std::swap(source, target);
+                    }
+
+                    if (source != data)
+                    {
+                        runChunks(pool, chunkCount, count, [source, data](size_t, size_t first, size_t last)
+                        {
+                            std::move(source + first, source + last, data + first);
+                        });
+                    }
+                    return;
+                }
+            }
+            sortChunk(data, data + count);
+        }
+
+        /**
+         * @brief A key sorted by radix sort, with the index of its element
+         */
+        template<typename U>
+        struct KeyIndex
+        {
+            U key;
+            size_t index;
+        };
+
+        /**
+         * @brief Return the most bytes per element @ref sort allocates besides the elements, to sort `T` with `KeyOrCompare`
+         */
+        template<typename T, typename KeyOrCompare>
+        constexpr size_t scratchSize()
+        {
+            if constexpr (std::is_invocable_v<KeyOrCompare&, T const&>)
+            {
+                using K = std::decay_t<std::invoke_result_t<KeyOrCompare&, T const&>>;
+                if constexpr (radixKey<K> && !(std::is_same_v<KeyOrCompare, Identity> && std::is_arithmetic_v<T>))
+                    return 2 * sizeof(KeyIndex<decltype(toUnsigned(std::declval<K>()))>) + sizeof(T);
+            }
+            return sizeof(T);
+        }
+
+        /**
+         * @brief Sort `count` elements at `data` by the key or with the comparator `keyOrCompare`
+         */
+        template<typename T, typename KeyOrCompare>
+        void sort(ThreadPool* pool, T* data, size_t count, KeyOrCompare& keyOrCompare, Stability stability)
+        {
+            if (count < 2)
+                return;
+
+            if constexpr (std::is_invocable_v<KeyOrCompare&, T const&>)
+            {
+                using K = std::decay_t<std::invoke_result_t<KeyOrCompare&, T const&>>;
+                auto lessByKey = [&keyOrCompare](T const& lhs, T const& rhs) { return keyOrCompare(lhs) < keyOrCompare(rhs); };
+                if constexpr (radixKey<K>)
+                {
+                    if (count < radixThreshold)
+                    {
+                        std::stable_sort(data, data + count, lessByKey);
+                        return;
+                    }
+
+                    if constexpr (std::is_same_v<KeyOrCompare, Identity> && std::is_arithmetic_v<T>)
+                    {
+                        std::unique_ptr<T[]> buffer{ new T[count] };
+                        radixSort(pool, data, buffer.get(), count, [](T value) { return toUnsigned(value); });
+                    }
+                    else
+                    {
+                        /*sort the keys with the indexes of their elements, then move every element once*/
+                        using Item = KeyIndex<decltype(toUnsigned(std::declval<K>()))>;
+                        std::unique_ptr<Item[]> items{ new Item[count] };
+                        std::unique_ptr<Item[]> buffer{ new Item[count] };
+                        auto const chunkCount = chunksFor(pool, count);
+                        runChunks(pool, chunkCount, count, [&](size_t, size_t first, size_t last)
+                        {
+                            for (auto i = first; i < last; ++i)
+                                items[i] = { toUnsigned(static_cast<K>(keyOrCompare(static_cast<T const&>(data[i])))), i };
+                        });
+                        radixSort(pool, items.get(), buffer.get(), count, [](Item const& item) { return item.key; });
+
+                        if constexpr (std::is_default_constructible_v<T>)
+                        {
+                            std::unique_ptr<T[]> gathered{ new T[count] };
+                            runChunks(pool, chunkCount, count, [&](size_t, size_t first, size_t last)
+                            {
+                                for (auto i = first; i < last; ++i)
+                                    gathered[i] = std::move(data[items[i].index]);
+                            });
+                            runChunks(pool, chunkCount, count, [&](size_t, size_t first, size_t last)
+                            {
+                                std::move(gathered.get() + first, gathered.get() + last, data + first);
+                            });
+                        }
+                        else
+                        {
+                            std::vector<T> gathered;
+                            gathered.reserve(count);
+                            for (size_t i = 0; i < count; ++i)
+                                gathered.push_back(std::move(data[items[i].index]));
+                            std::move(gathered.begin(), gathered.end(), data);
+                        }
+                    }
+                }
+                else
+                    mergeSort(pool, data, count, lessByKey, stability);
+            }
+            else
+            {
+                static_assert(std::is_invocable_r_v<bool, KeyOrCompare&, T const&, T const&>,
+                    "sort() takes a key function of an element, or a comparator of two elements");
+                mergeSort(pool, data, count, keyOrCompare, stability);
+            }
+        }
+
+        /**
+         * @brief Sort the elements of the random access `container` in place
+         */
+        template<typename Container, typename KeyOrCompare>
+        void sortContainer(ThreadPool* pool, Container& container, KeyOrCompare& keyOrCompare, Stability stability)
+        {
+            using Iterator = decltype(std::begin(container));
+            static_assert(std::is_base_of_v<std::random_access_iterator_tag, typename std::iterator_traits<Iterator>::iterator_category>,
+                "sort() needs a random access container, use sorted() for the others");
+            using T = typename std::iterator_traits<Iterator>::value_type;
+            auto const first = std::begin(container);
+            auto const count = static_cast<size_t>(std::distance(first, std::end(container)));
+
+            if constexpr (contiguous<Container>::value)
+                Sort_detail::sort(pool, std::data(container), count, keyOrCompare, stability);
+            else
+            {
+                /*not contiguous, like std::deque*/
+                std::vector<T> elements(std::make_move_iterator(first), std::make_move_iterator(std::end(container)));
+                Sort_detail::sort(pool, elements.data(), count, keyOrCompare, stability);
+                std::move(elements.begin(), elements.end(), first);
+            }
+        }
+
+        template<typename Iterable, typename KeyOrCompare>
+        auto sorted(ThreadPool* pool, Iterable& iterable, KeyOrCompare& keyOrCompare, Stability stability)
+        {
+            std::vector<std::decay_t<decltype(*std::begin(iterable))>> elements;
+            for (auto&& element : iterable)
+                elements.push_back(element);
+            Sort_detail::sort(pool, elements.data(), elements.size(), keyOrCompare, stability);
+            return elements;
+        }
+    }
+
+    /**
+     * @brief Return a `std::vector` of the elements of `iterable` in ascending order, like `sorted()` in Python
+     * @details Integers, `float` and `double` are radix sorted, other elements are sorted with `operator<`
+     */
+    template<typename Iterable, typename = std::enable_if_t<Traits_detail::iterable_lvalue<Iterable>::value>>
+    auto sorted(Iterable&& iterable, Stability stability = Stability::Stable)
+    {
+        Traits_detail::Identity identity;
+        return Sort_detail::sorted(nullptr, iterable, identity, stability);
+    }
+
+    /**
+     * @brief Return a `std::vector` of the elements of `iterable` sorted by `keyOrCompare`
+     * @param keyOrCompare Either a key function taking an element, like `key` of `sorted()` in Python, or a comparator taking two elements, like `std::sort`.
+     * Keys which are integers, `float` or `double` are radix sorted.
+     */
+    template<typename Iterable, typename KeyOrCompare,
+        typename = std::enable_if_t<Traits_detail::iterable_lvalue<Iterable>::value && !std::is_same_v<std::decay_t<KeyOrCompare>, Stability>>>
+    auto sorted(Iterable&& iterable, KeyOrCompare&& keyOrCompare, Stability stability = Stability::Stable)
+    {
+        return Sort_detail::sorted(nullptr, iterable, keyOrCompare, stability);
+    }
+
+    /**
+     * @brief Return a `std::vector` of the elements of `iterable` in ascending order, sorted in parallel on the pool of `policy`
+     */
+    template<typename Iterable>
+    auto sorted(ParallelPolicy policy, Iterable&& iterable, Stability stability = Stability::Stable)
+    {
+        Traits_detail::Identity identity;
+        return Sort_detail::sorted(&policy.getPool(), iterable, identity, stability);
+    }
+
+    /**
+     * @brief Return a `std::vector` of the elements of `iterable` sorted by `keyOrCompare`, in parallel on the pool of `policy`
+     */
+    template<typename Iterable, typename KeyOrCompare, typename = std::enable_if_t<!std::is_same_v<std::decay_t<KeyOrCompare>, Stability>>>
+    auto sorted(ParallelPolicy policy, Iterable&& iterable, KeyOrCompare&& keyOrCompare, Stability stability = Stability::Stable)
+    {
+        return Sort_detail::sorted(&policy.getPool(), iterable, keyOrCompare, stability);
+    }
+
+    /**
+     * @brief Sort the random access `container` in ascending order, in place
+     * @details Integers, `float` and `double` are radix sorted, other elements are sorted with `operator<`
+     */
+    template<typename Container, typename = std::enable_if_t<Traits_detail::iterable_lvalue<Container>::value>>
+    void sort(Container&& container, Stability stability = Stability::Stable)
+    {
+        Traits_detail::Identity identity;
+        Sort_detail::sortContainer(nullptr, container, identity, stability);
+    }
+
+    /**
+     * @brief Sort the random access `container` by `keyOrCompare`, in place
+     * @param keyOrCompare Either a key function taking an element or a comparator taking two elements, see @ref sorted
+     */
+    template<typename Container, typename KeyOrCompare,
+        typename = std::enable_if_t<Traits_detail::iterable_lvalue<Container>::value && !std::is_same_v<std::decay_t<KeyOrCompare>, Stability>>>
+    void sort(Container&& container, KeyOrCompare&& keyOrCompare, Stability stability = Stability::Stable)
+    {
+        Sort_detail::sortContainer(nullptr, container, keyOrCompare, stability);
+    }
+
+    /**
+     * @brief Sort the random access `container` in ascending order, in place and in parallel on the pool of `policy`
+     */
+    template<typename Container>
+    void sort(ParallelPolicy policy, Container&& container, Stability stability = Stability::Stable)
+    {
+        Traits_detail::Identity identity;
+        Sort_detail::sortContainer(&policy.getPool(), container, identity, stability);
+    }
+
+    /**
+     * @brief Sort the random access `container` by `keyOrCompare`, in place and in parallel on the pool of `policy`
+     */
+    template<typename Container, typename KeyOrCompare, typename = std::enable_if_t<!std::is_same_v<std::decay_t<KeyOrCompare>, Stability>>>
+    void sort(ParallelPolicy policy, Container&& container, KeyOrCompare&& keyOrCompare, Stability stability = Stability::Stable)
+    {
+        Sort_detail::sortContainer(&policy.getPool(), container, keyOrCompare, stability);
+    }
+
+#ifdef SugarPPNamespace
+}
+#endif
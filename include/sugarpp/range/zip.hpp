@@ -0,0 +1,99 @@
+/*****************************************************************//**
+ * \file   zip.hpp
+ * \brief  Python's zip port
+ *
+ * \author Peter
+ * \date   October 2026
+ *********************************************************************/
+#pragma once
+
+#include <iterator>
+#include <tuple>
+#include <utility>
+
+#ifdef SugarPPNamespace
+namespace SugarPP
+{
+#endif
+
+    /**
+     * @brief The Zip iterator object which is used in range-based for loop with Zip class
+     * @see EnumerateIterator for why it is not nested inside Zip
+     */
+    template<typename... Iterators>
+    class ZipIterator
+    {
+        std::tuple<Iterators...> iters;
+
+        template<typename... Ends>
+        friend class ZipIterator;
+
+        template<typename... Ends, size_t... I>
+        bool allNotEqual(ZipIterator<Ends...> const& rhs, std::index_sequence<I...>) const
+        {
+            return ((std::get<I>(iters) != std::get<I>(rhs.iters)) && ...);
+        }
+    public:
+        ZipIterator(Iterators... iters) :iters(std::move(iters)...) {}
+        ZipIterator& operator++()
+        {
+            std::apply([](auto&... iters) { (++iters, ...); }, iters);
+            return *this;
+        }
+        /**
+         * @brief Elements dereferenced as lvalues are held by reference, those returned by value (eg. from a @ref Range) are held by value
+         */
+        auto operator*()
+        {
+            return std::apply([](auto&... iters) { return std::tuple<decltype(*iters)...>{ *iters... }; }, iters);
+        }
+        /**
+         * @brief Iteration stops as soon as the shortest iterable is exhausted, like Python's zip
+         * @details The end of an iterable may be of a different type than its begin, like @ref Range which ends with a value
+         */
+        template<typename... Ends>
+        bool operator!=(ZipIterator<Ends...> const& rhs) const
+        {
+            static_assert(sizeof...(Ends) == sizeof...(Iterators), "ZipIterator compared with a ZipIterator over a different number of iterables");
+            return allNotEqual(rhs, std::index_sequence_for<Iterators...>{});
+        }
+    };
+
+    /**
+     * @brief A Python-like Zip object, when dereference, returns a tuple of references to the contents of every iterable (or values, for iterables that produce values)
+     * @tparam Iterables The types of the iterables, which are lvalue references when constructed from lvalues
+     * @details
+     * ~~~~{.cpp}
+     *     std::vector names{ "cpp", "sugar" };
+     *     std::array scores{ 1, 2 };
+     *     for (auto [name, score] : Zip(names, scores))
+     *         print(name, score);
+     * ~~~~
+     */
+    template<typename... Iterables>
+    class Zip
+    {
+        std::tuple<Iterables...> iterables; //lvalue references or value types
+    public:
+        /**
+         * @brief Construct a Zip object by any number of iterables, rvalues (eg. a @ref Generator) are moved into the Zip object
+         */
+        Zip(Iterables&&... iterables) :iterables(std::forward<Iterables>(iterables)...) {}
+
+        /**
+         * @return Return a ZipIterator object, that points to the start of every iterable
+         */
+        auto begin() { return std::apply([](auto&... iterables) { return ZipIterator{ std::begin(iterables)... }; }, iterables); }
+
+        /**
+         * @return Return a ZipIterator object, that points to the end of every iterable, whose type may differ from `begin()`
+         */
+        auto end() { return std::apply([](auto&... iterables) { return ZipIterator{ std::end(iterables)... }; }, iterables); }
+    };
+
+    template<typename... Iterables>
+    Zip(Iterables&&...)->Zip<Iterables...>;
+
+#ifdef SugarPPNamespace
+}
+#endif
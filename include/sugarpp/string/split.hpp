@@ -0,0 +1,391 @@
+/*****************************************************************//**
+ * \file   split.hpp
+ * \brief  Python-style split into `std::string_view` and join, searching the delimiters with SIMD
+ *
+ * \author Peter
+ * \date   October 2026
+ * \note The parts returned by split point into the original string, so it must outlive them
+ *********************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include "../traits/traits.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SugarPPStringSSE2
+#include <emmintrin.h>
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+#ifdef SugarPPNamespace
+namespace SugarPP
+{
+#endif
+
+    namespace String_detail
+    {
+        inline bool isSpace(char c)
+        {
+            return c == ' ' || static_cast<unsigned char>(c - '\t') <= '\r' - '\t';
+        }
+
+#ifdef SugarPPStringSSE2
+        inline unsigned trailingZeros(std::uint32_t value)
+        {
+#ifdef _MSC_VER
+            unsigned long index;
+            _BitScanForward(&index, value);
+            return static_cast<unsigned>(index);
+#else
+            return static_cast<unsigned>(__builtin_ctz(value));
+#endif
+        }
+
+        inline __m128i load(char const* position)
+        {
+            return _mm_loadu_si128(reinterpret_cast<__m128i const*>(position));
+        }
+#endif
+
+        /**
+         * @brief Return the first `c` in [first, last), or `last`
+         * @details Comparing 16 characters at a time inline is faster than calling `memchr` for the short fields of a line
+         */
+        inline char const* findChar(char const* first, char const* last, char c)
+        {
+#ifdef SugarPPStringSSE2
+            auto const pattern = _mm_set1_epi8(c);
+            for (; last - first >= 16; first += 16)
+            {
+                if (auto const mask = static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(load(first), pattern))))
+                    return first + trailingZeros(mask);
+            }
+#endif
+            auto const found = first == last ? nullptr : static_cast<char const*>(std::memchr(first, c, static_cast<size_t>(last - first)));
+            return found ? found : last;
+        }
+
+        /**
+         * @brief Return the first occurrence of `needle`, which has at least 2 characters, in [first, last), or `last`
+         * @details
+         * The first and the last character of `needle` are compared with 16 positions at once, and the rest of it only
+         * where both match, so that a needle whose first character is common in the text is still fast.
+         */
+        inline char const* findString(char const* first, char const* last, std::string_view needle)
+        {
+            auto const size = static_cast<std::ptrdiff_t>(needle.size());
+#ifdef SugarPPStringSSE2
+            auto const front = _mm_set1_epi8(needle.front());
+            auto const back = _mm_set1_epi8(needle.back());
+            for (; last - first >= 16 + size - 1; first += 16)
+            {
+                auto mask = static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_and_si128(
+                    _mm_cmpeq_epi8(load(first), front),
+                    _mm_cmpeq_epi8(load(first + size - 1), back))));
+                for (; mask; mask &= mask - 1)
+                {
+                    auto const candidate = first + trailingZeros(mask);
+                    if (std::memcmp(candidate + 1, needle.data() + 1, static_cast<size_t>(size - 2)) == 0)
+                        return candidate;
+                }
+            }
+#endif
+            auto const position = std::string_view{ first, static_cast<size_t>(last - first) }.find(needle);
+            return position == std::string_view::npos ? last : first + position;
+        }
+
+        /**
+         * @brief Return the first whitespace character in [first, last), or `last`
+         */
+        inline char const* findSpace(char const* first, char const* last)
+        {
+#ifdef SugarPPStringSSE2
+            auto const space = _mm_set1_epi8(' ');
+            auto const tab = _mm_set1_epi8('\t');
+            auto const controls = _mm_set1_epi8('\r' - '\t');
+            for (; last - first >= 16; first += 16)
+            {
+                /*'\t' to '\r' are the characters whose distance to '\t' is at most 4, as an unsigned byte*/
+                auto const block = load(first);
+                auto const distance = _mm_sub_epi8(block, tab);
+                auto const isControl = _mm_cmpeq_epi8(_mm_min_epu8(distance, controls), distance);
+                if (auto const mask = static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_or_si128(isControl, _mm_cmpeq_epi8(block, space)))))
+                    return first + trailingZeros(mask);
+            }
+#endif
+            while (first != last && !isSpace(*first))
+                ++first;
+            return first;
+        }
+
+        /**
+         * @brief Return the number of `c` in [first, last)
+         * @details The matches of 16 positions at once are accumulated in bytes, which are summed every 255 blocks before they overflow.
+         */
+        inline size_t countChar(char const* first, char const* last, char c)
+        {
+            size_t count = 0;
+#ifdef SugarPPStringSSE2
+            auto const pattern = _mm_set1_epi8(c);
+            while (last - first >= 16)
+            {
+                auto const blocks = std::min<std::ptrdiff_t>((last - first) / 16, 255);
+                auto counts = _mm_setzero_si128();
+                for (std::ptrdiff_t i = 0; i < blocks; ++i, first += 16)
+                    counts = _mm_sub_epi8(counts, _mm_cmpeq_epi8(load(first), pattern));
+                auto const sums = _mm_sad_epu8(counts, _mm_setzero_si128());
+                count += static_cast<size_t>(_mm_cvtsi128_si32(sums)) + static_cast<size_t>(_mm_extract_epi16(sums, 4));
+            }
+#endif
+            for (; first != last; ++first)
+                count += *first == c;
+            return count;
+        }
+
+        template<typename T>
+        using is_string_like = std::is_convertible<T const&, std::string_view>;
+    }
+
+    /**
+     * @brief The lazy result of @ref split, a forward range of `std::string_view` pointing into the split string
+     * @details Nothing is allocated, unless it is converted to a `std::vector<std::string_view>`.
+     */
+    class SplitView
+    {
+        std::string_view text;
+        std::string_view delimiter;     //only used when it has several characters
+        char single = '\0';             //the delimiter when it is a single character
+        size_t delimiterSize = 0;       //0 to split on runs of whitespace
+
+        char const* findDelimiter(char const* first) const
+        {
+            auto const last = text.data() + text.size();
+            if (delimiterSize == 0)
+                return String_detail::findSpace(first, last);
+            if (delimiterSize == 1)
+                return String_detail::findChar(first, last, single);
+            return String_detail::findString(first, last, delimiter);
+        }
+
+        char const* skipSpaces(char const* first) const
+        {
+            auto const last = text.data() + text.size();
+            while (first != last && String_detail::isSpace(*first))
+                ++first;
+            return first;
+        }
+    public:
+        class iterator
+        {
+            friend class SplitView;
+            SplitView const* view = nullptr;
+            char const* partBegin = nullptr;
+            char const* partEnd = nullptr;
+            bool atEnd = true;
+
+            void find(char const* first)
+            {
+                auto const last = view->text.data() + view->text.size();
+                if (view->delimiterSize == 0)
+                {
+                    first = view->skipSpaces(first);
+                    if (first == last)
+                    {
+                        atEnd = true;
+                        return;
+                    }
+                }
+                partBegin = first;
+                partEnd = view->findDelimiter(first);
+                atEnd = false;
+            }
+
+            explicit iterator(SplitView const* view) :view(view) { find(view->text.data()); }
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = std::string_view;
+            using difference_type = std::ptrdiff_t;
+            using pointer = std::string_view const*;
+            using reference = std::string_view;
+
+            iterator() = default;
+
+            std::string_view operator*() const { return { partBegin, static_cast<size_t>(partEnd - partBegin) }; }
+
+            iterator& operator++()
+            {
+                auto const last = view->text.data() + view->text.size();
+                if (partEnd == last)
+                    atEnd = true;
+                else
+                    find(partEnd + (view->delimiterSize == 0 ? 1 : view->delimiterSize));
+                return *this;
+            }
+
+            iterator operator++(int)
+            {
+                auto copy = *this;
+                ++*this;
+                return copy;
+            }
+
+            bool operator==(iterator const& rhs) const { return atEnd == rhs.atEnd && (atEnd || partBegin == rhs.partBegin); }
+            bool operator!=(iterator const& rhs) const { return !(*this == rhs); }
+        };
+
+        /**
+         * @brief Split `text` on `delimiter`, or on runs of whitespace if it is empty
+         */
+        SplitView(std::string_view text, std::string_view delimiter)
+            :text(text), delimiter(delimiter), single(delimiter.empty() ? '\0' : delimiter.front()), delimiterSize(delimiter.size())
+        {
+        }
+
+        SplitView(std::string_view text, char delimiter) :text(text), single(delimiter), delimiterSize(1)
+        {
+        }
+
+        iterator begin() const { return iterator{ this }; }
+        iterator end() const { return {}; }
+
+        /**
+         * @brief Return the parts in a vector
+         */
+        [[nodiscard]] std::vector<std::string_view> toVector() const
+        {
+            std::vector<std::string_view> parts;
+            for (auto const part : *this)
+                parts.push_back(part);
+            return parts;
+        }
+
+        operator std::vector<std::string_view>() const { return toVector(); }
+
+        /**
+         * @brief Return the parts copied into strings
+         */
+        operator std::vector<std::string>() const
+        {
+            std::vector<std::string> parts;
+            for (auto const part : *this)
+                parts.emplace_back(part);
+            return parts;
+        }
+    };
+
+    /**
+     * @brief Split `text` on every `delimiter`, like `str.split(sep)` in Python
+     * @details
+     * Consecutive delimiters give empty parts, and an empty `text` gives one empty part. The result is lazy, so it can be
+     * iterated without allocating, or converted to a vector:
+     * ~~~~{.cpp}
+     *     for (auto field : split(line, ','))
+     *         ...
+     *     std::vector<std::string_view> fields = split(line, ", ");
+     * ~~~~
+     * @throw std::invalid_argument if `delimiter` is empty
+     */
+    [[nodiscard]] inline SplitView split(std::string_view text, std::string_view delimiter)
+    {
+        if (delimiter.empty())
+            throw std::invalid_argument{ "split() with an empty delimiter" };
+        return SplitView{ text, delimiter };
+    }
+
+    /**
+     * @brief Split `text` on every `delimiter` character
+     */
+    [[nodiscard]] inline SplitView split(std::string_view text, char delimiter)
+    {
+        return SplitView{ text, delimiter };
+    }
+
+    /**
+     * @brief Split `text` on runs of whitespace, ignoring the whitespace at both ends, like `str.split()` in Python
+     */
+    [[nodiscard]] inline SplitView split(std::string_view text)
+    {
+        return SplitView{ text, std::string_view{} };
+    }
+
+    /**
+     * @brief Concatenate the strings of `iterable` with `separator` between them, like `sep.join(iterable)` in Python
+     * @details
+     * The elements can be anything convertible to `std::string_view`. When `iterable` can be iterated twice, the size of the
+     * result is computed first, so it is allocated once.
+     */
+    template<typename Iterable, typename = std::enable_if_t<Traits_detail::iterable_lvalue<Iterable>::value>>
+    [[nodiscard]] std::string join(Iterable&& iterable, std::string_view separator = {})
+    {
+        using Iterator = decltype(std::begin(iterable));
+        using Element = decltype(*std::begin(iterable));
+        static_assert(String_detail::is_string_like<std::decay_t<Element>>::value, "join() needs elements convertible to std::string_view");
+
+        std::string result;
+        if constexpr (std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<Iterator>::iterator_category>)
+        {
+            size_t size = 0;
+            size_t count = 0;
+            for (auto&& element : iterable)
+            {
+                size += std::string_view{ element }.size();
+                ++count;
+            }
+            if (count == 0)
+                return result;
+            result.resize(size + separator.size() * (count - 1));
+
+            auto output = result.data();
+            auto first = true;
+            for (auto&& element : iterable)
+            {
+                if (!first)
+                {
+                    std::memcpy(output, separator.data(), separator.size());
+                    output += separator.size();
+                }
+                first = false;
+                std::string_view const part{ element };
+                std::memcpy(output, part.data(), part.size());
+                output += part.size();
+            }
+        }
+        else
+        {
+            auto first = true;
+            for (auto&& element : iterable)
+            {
+                if (!first)
+                    result.append(separator);
+                first = false;
+                result.append(std::string_view{ element });
+            }
+        }
+        return result;
+    }
+
+    /**
+     * @brief Concatenate the strings of `iterable` with the `separator` character between them
+     */
+    template<typename Iterable, typename = std::enable_if_t<Traits_detail::iterable_lvalue<Iterable>::value>>
+    [[nodiscard]] std::string join(Iterable&& iterable, char separator)
+    {
+        return join(iterable, std::string_view{ &separator, 1 });
+    }
+
+#ifdef SugarPPNamespace
+}
+#endif
@@ -0,0 +1,284 @@
+/*****************************************************************//**
+ * \file   pool.hpp
+ * \brief  A pool of reusable objects, with a cache per thread
+ *
+ * \author Peter
+ * \date   October 2026
+ *********************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#ifdef SugarPPNamespace
+namespace SugarPP
+{
+#endif
+
+    /**
+     * @brief A pool of objects which are expensive to create, like large buffers, parsers or random engines
+     * @details
+     * @ref acquire returns a @ref Handle to an object, which goes back to the pool when the handle is destroyed, instead of being deleted.
+     * Every thread caches up to `localCapacity` released objects for each pool, which it takes and gives back without any lock.
+     * When its cache is full, half of it moves to a list shared by the threads, which an empty cache refills from under a mutex.
+     * An object may be released on another thread than the one which acquired it, like in a coroutine resumed on another worker.
+     *
+     * The objects still cached when a thread exits go back to the shared list, and the pool deletes those cached by every thread when it is destroyed.
+     * The pool must outlive the handles.
+     * ~~~~{.cpp}
+     *     Pool<std::vector<char>> buffers{ [] { return std::vector<char>(1 << 20); } };
+     *     parallel(Range(0, 1000), [&](auto range)
+     *     {
+     *         for (auto i : range)
+     *         {
+     *             auto buffer = buffers.acquire();     //reused from the previous iterations of this thread
+     *             ...
+     *         }
+     *     });
+     * ~~~~
+     */
+    template<typename T>
+    class Pool
+    {
+        using Object = std::unique_ptr<T>;
+
+        /**
+         * @brief The state shared with the thread caches, which stays alive until every thread forgot the pool
+         */
+        struct Shared
+        {
+            std::function<T()> factory;
+            std::function<void(T&)> recycle;
+            size_t localCapacity;
+            std::atomic<bool> closed{ false };
+            std::mutex mutex;
+            std::vector<Object> overflow;
+            /*the cache of every thread which used the pool, only touched by its thread until the pool is closed under the mutex*/
+            std::list<std::vector<Object>> caches;
+
+            void giveBack(std::vector<Object>& objects, size_t count)
+            {
+                std::lock_guard lock{ mutex };
+                for (size_t i = 0; i < count; ++i)
+                {
+                    overflow.push_back(std::move(objects.back()));
+                    objects.pop_back();
+                }
+            }
+        };
+
+        struct LocalCache
+        {
+            std::shared_ptr<Shared> shared;
+            typename std::list<std::vector<Object>>::iterator objects;
+        };
+
+        /**
+         * @brief The caches of the calling thread for every pool of `T` it used, usually only one
+         */
+        struct ThreadCaches
+        {
+            std::vector<LocalCache> caches;
+
+            ~ThreadCaches()
+            {
+                destroyed() = true;
+                for (auto& cache : caches)
+                {
+                    std::lock_guard lock{ cache.shared->mutex };
+                    if (cache.shared->closed.load(std::memory_order_relaxed))
+                        continue;
+                    for (auto& object : *cache.objects)
+                        cache.shared->overflow.push_back(std::move(object));
+                    cache.shared->caches.erase(cache.objects);
+                }
+            }
+
+            LocalCache& find(std::shared_ptr<Shared> const& shared)
+            {
+                for (auto& cache : caches)
+                {
+                    if (cache.shared == shared)
+                        return cache;
+                }
+                /*forget the pools destroyed since, which already deleted the objects cached here*/
+                caches.erase(std::remove_if(caches.begin(), caches.end(), [](LocalCache const& cache)
+                {
+                    return cache.shared->closed.load(std::memory_order_acquire);
+                }), caches.end());
+                std::lock_guard lock{ shared->mutex };
+                auto objects = shared->caches.emplace(shared->caches.end());
+                objects->reserve(shared->localCapacity);
+                caches.push_back({ shared, objects });
+                return caches.back();
+            }
+        };
+
+        /**
+         * @brief Objects may still be released while the thread is exiting, after its caches are destroyed
+         */
+        static bool& destroyed()
+        {
+            static thread_local bool value = false;
+            return value;
+        }
+
+        static ThreadCaches& threadCaches()
+        {
+            static thread_local ThreadCaches value;
+            return value;
+        }
+
+        std::shared_ptr<Shared> shared;
+
+        void release(Object object)
+        {
+            if (shared->recycle)
+                shared->recycle(*object);
+            if (destroyed())
+            {
+                std::lock_guard lock{ shared->mutex };
+                shared->overflow.push_back(std::move(object));
+                return;
+            }
+            auto& local = *threadCaches().find(shared).objects;
+            if (local.size() == shared->localCapacity)
+                shared->giveBack(local, (local.size() + 1) / 2);
+            local.push_back(std::move(object));
+        }
+    public:
+        /**
+         * @brief An object of the pool, which goes back to it when the handle is destroyed or reset
+         */
+        class Handle
+        {
+            friend class Pool;
+            Pool* pool = nullptr;
+            Object object;
+
+            Handle(Pool* pool, Object object) :pool(pool), object(std::move(object)) {}
+        public:
+            Handle() = default;
+            Handle(Handle&&) noexcept = default;
+
+            Handle& operator=(Handle&& rhs) noexcept
+            {
+                if (this != &rhs)
+                {
+                    reset();
+                    pool = std::exchange(rhs.pool, nullptr);
+                    object = std::move(rhs.object);
+                }
+                return *this;
+            }
+
+            ~Handle() { reset(); }
+
+            /**
+             * @brief Give the object back to the pool now
+             */
+            void reset()
+            {
+                if (object)
+                    std::exchange(pool, nullptr)->release(std::move(object));
+            }
+
+            T& operator*() const { return *object; }
+            T* operator->() const { return object.get(); }
+            T* get() const { return object.get(); }
+            explicit operator bool() const { return static_cast<bool>(object); }
+        };
+
+        /**
+         * @brief Create a pool whose new objects are returned by `factory`
+         * @param recycle Called with every released object before it is cached, like to clear a buffer without freeing its memory
+         * @param localCapacity The maximum number of objects cached by each thread
+         */
+        explicit Pool(std::function<T()> factory, std::function<void(T&)> recycle = {}, size_t localCapacity = 16)
+            :shared(std::make_shared<Shared>())
+        {
+            shared->factory = std::move(factory);
+            shared->recycle = std::move(recycle);
+            shared->localCapacity = std::max<size_t>(localCapacity, 1);
+        }
+
+        /**
+         * @brief Create a pool of default constructed objects
+         */
+        Pool() :Pool([] { return T{}; })
+        {
+            static_assert(std::is_default_constructible_v<T>, "Pool<T> needs a factory when T is not default constructible");
+        }
+
+        Pool(Pool const&) = delete;
+        Pool& operator=(Pool const&) = delete;
+
+        /**
+         * @brief Delete the objects in the shared list and in the caches of every thread
+         * @details The other threads only forget the pool when they exit or use another pool of `T`, which keeps alive its small shared state but none of the objects.
+         */
+        ~Pool()
+        {
+            if (!destroyed())
+            {
+                auto& caches = threadCaches().caches;
+                caches.erase(std::remove_if(caches.begin(), caches.end(), [this](LocalCache const& cache) { return cache.shared == shared; }), caches.end());
+            }
+            std::lock_guard lock{ shared->mutex };
+            shared->closed.store(true, std::memory_order_release);
+            shared->overflow.clear();
+            shared->caches.clear();
+        }
+
+        /**
+         * @brief Return an object from the cache of this thread, else from the shared list, else a new one from the factory
+         */
+        [[nodiscard]] Handle acquire()
+        {
+            if (!destroyed())
+            {
+                auto& local = *threadCaches().find(shared).objects;
+                if (local.empty())
+                {
+                    /*refill half of the cache at once, so the next acquires do not take the lock*/
+                    std::lock_guard lock{ shared->mutex };
+                    auto const count = std::min(shared->overflow.size(), (shared->localCapacity + 1) / 2);
+                    for (size_t i = 0; i < count; ++i)
+                    {
+                        local.push_back(std::move(shared->overflow.back()));
+                        shared->overflow.pop_back();
+                    }
+                }
+                if (!local.empty())
+                {
+                    Handle handle{ this, std::move(local.back()) };
+                    local.pop_back();
+                    return handle;
+                }
+            }
+            else
+            {
+                std::lock_guard lock{ shared->mutex };
+                if (!shared->overflow.empty())
+                {
+                    Handle handle{ this, std::move(shared->overflow.back()) };
+                    shared->overflow.pop_back();
+                    return handle;
+                }
+            }
+            return Handle{ this, Object{ new T(shared->factory()) } };
+        }
+    };
+
+#ifdef SugarPPNamespace
+}
+#endif
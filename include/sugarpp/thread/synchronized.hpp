@@ -0,0 +1,318 @@
+/*****************************************************************//**
+ * \file   synchronized.hpp
+ * \brief  A value only accessed while holding its lock, which is a mutex, a reader-writer lock or a seqlock
+ *
+ * \author Peter
+ * \date   October 2026
+ *********************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <shared_mutex>
+#include <type_traits>
+#include <utility>
+
+#ifdef SugarPPNamespace
+namespace SugarPP
+{
+#endif
+
+    /**
+     * @brief Use as the `Lock` of a @ref Synchronized to protect it with a sequence lock
+     * @details Readers never block and never write to shared memory, which suits small values read much more often than written.
+     * A reader copies the value and checks that no writer ran meanwhile, retrying if one did. Writers are serialized with a mutex.
+     */
+    struct SeqLock {};
+
+    /**
+     * @brief The contention counters of a @ref Synchronized created with `CollectStats`
+     */
+    struct SynchronizedStats
+    {
+        std::uint64_t locks = 0;        /**< How many times the lock was taken, for reading or for writing */
+        std::uint64_t contended = 0;    /**< How many of them had to wait, because another thread held the lock */
+        std::uint64_t readRetries = 0;  /**< How many times a @ref SeqLock reader copied the value again, because a writer ran meanwhile */
+    };
+
+    namespace Synchronized_detail
+    {
+        /**
+         * @brief The counters of @ref SynchronizedStats, which are empty and free unless they are enabled
+         */
+        template<bool Enabled>
+        struct Counters
+        {
+            void locked(bool) const {}
+            void retried() const {}
+        };
+
+        template<>
+        struct Counters<true>
+        {
+            mutable std::atomic<std::uint64_t> locks{ 0 };
+            mutable std::atomic<std::uint64_t> contended{ 0 };
+            mutable std::atomic<std::uint64_t> readRetries{ 0 };
+
+            void locked(bool wasContended) const
+            {
+                locks.fetch_add(1, std::memory_order_relaxed);
+                if (wasContended)
+                    contended.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            void retried() const { readRetries.fetch_add(1, std::memory_order_relaxed); }
+
+            SynchronizedStats get() const
+            {
+                return { locks.load(std::memory_order_relaxed), contended.load(std::memory_order_relaxed), readRetries.load(std::memory_order_relaxed) };
+            }
+        };
+
+        template<typename Lock, typename = void>
+        struct is_shared_lockable : std::false_type {};
+
+        template<typename Lock>
+        struct is_shared_lockable<Lock, std::void_t<decltype(std::declval<Lock&>().lock_shared())>> : std::true_type {};
+
+        /**
+         * @brief Take `guard`, which was constructed with `std::try_to_lock`, counting whether it had to wait
+         */
+        template<bool CollectStats, typename Guard>
+        void take(Guard& guard, Counters<CollectStats> const& counters)
+        {
+            auto const wasContended = !guard.owns_lock();
+            if (wasContended)
+                guard.lock();
+            counters.locked(wasContended);
+        }
+    }
+
+    /**
+     * @brief A `T` which can only be accessed through callbacks holding its lock, like `folly::Synchronized`
+     * @details
+     * `Lock` chooses how it is protected:
+     * - `std::mutex`, the default, for values which are written about as often as they are read
+     * - `std::shared_mutex`, so that @ref withReadLock callbacks run at the same time, for read-mostly values which are expensive to copy
+     * - @ref SeqLock, for small trivially copyable values read very often, like configurations or statistics
+     *
+     * With `CollectStats`, @ref stats counts the acquisitions and how many of them waited, at the cost of an atomic increment each.
+     * ~~~~{.cpp}
+     *     Synchronized<std::vector<int>> values;
+     *     values.withLock([](auto& v) { v.push_back(1); });
+     *     auto const size = values.withReadLock([](auto const& v) { return v.size(); });
+     * ~~~~
+     */
+    template<typename T, typename Lock = std::mutex, bool CollectStats = false>
+    class Synchronized
+    {
+        mutable Lock mutex;
+        T value;
+        Synchronized_detail::Counters<CollectStats> counters;
+    public:
+        Synchronized() = default;
+        explicit Synchronized(T value) :value(std::move(value)) {}
+        Synchronized(Synchronized const&) = delete;
+        Synchronized& operator=(Synchronized const&) = delete;
+
+        /**
+         * @brief Call `func(T&)` holding the lock exclusively, and return its result
+         */
+        template<typename Func>
+        decltype(auto) withLock(Func&& func)
+        {
+            std::unique_lock guard{ mutex, std::try_to_lock };
+            Synchronized_detail::take(guard, counters);
+            return std::forward<Func>(func)(value);
+        }
+
+        /**
+         * @brief The same as @ref withLock
+         */
+        template<typename Func>
+        decltype(auto) withWriteLock(Func&& func)
+        {
+            return withLock(std::forward<Func>(func));
+        }
+
+        /**
+         * @brief Call `func(T const&)` holding the lock for reading, which is shared with other readers if `Lock` supports it, and return its result
+         */
+        template<typename Func>
+        decltype(auto) withReadLock(Func&& func) const
+        {
+            if constexpr (Synchronized_detail::is_shared_lockable<Lock>::value)
+            {
+                std::shared_lock guard{ mutex, std::try_to_lock };
+                Synchronized_detail::take(guard, counters);
+                return std::forward<Func>(func)(static_cast<T const&>(value));
+            }
+            else
+            {
+                std::unique_lock guard{ mutex, std::try_to_lock };
+                Synchronized_detail::take(guard, counters);
+                return std::forward<Func>(func)(static_cast<T const&>(value));
+            }
+        }
+
+        /**
+         * @brief Return a copy of the value
+         */
+        [[nodiscard]] T copy() const
+        {
+            return withReadLock([](T const& current) { return current; });
+        }
+
+        /**
+         * @brief Replace the value
+         */
+        void store(T newValue)
+        {
+            withLock([&newValue](T& current) { current = std::move(newValue); });
+        }
+
+        [[nodiscard]] SynchronizedStats stats() const
+        {
+            static_assert(CollectStats, "stats() needs a Synchronized created with CollectStats = true");
+            return counters.get();
+        }
+    };
+
+    /**
+     * @brief A `T` protected with a sequence lock, see @ref SeqLock
+     * @details
+     * The value is stored as an array of atomic words, which readers load with relaxed atomics, so that a reader overlapping a
+     * writer is not a data race, only a torn copy which the sequence number detects. @ref withReadLock callbacks get that copy,
+     * and @ref withLock callbacks modify a copy which is written back before the lock is released.
+     */
+    template<typename T, bool CollectStats>
+    class Synchronized<T, SeqLock, CollectStats>
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "A Synchronized with a SeqLock needs a trivially copyable T");
+        static constexpr size_t wordCount = (sizeof(T) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+
+        std::atomic<std::uint64_t> sequence{ 0 };   //odd while a writer is writing
+        std::mutex writer;
+        std::atomic<std::uint64_t> words[wordCount];
+        Synchronized_detail::Counters<CollectStats> counters;
+
+        void write(T const& newValue)
+        {
+            std::uint64_t buffer[wordCount]{};
+            std::memcpy(buffer, &newValue, sizeof(T));
+            auto const current = sequence.load(std::memory_order_relaxed);
+            sequence.store(current + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            for (size_t i = 0; i < wordCount; ++i)
+                words[i].store(buffer[i], std::memory_order_relaxed);
+            sequence.store(current + 2, std::memory_order_release);
+        }
+    public:
+        Synchronized() :Synchronized(T{}) {}
+
+        explicit Synchronized(T const& value)
+        {
+            for (auto& word : words)
+                word.store(0, std::memory_order_relaxed);
+            write(value);
+        }
+
+        Synchronized(Synchronized const&) = delete;
+        Synchronized& operator=(Synchronized const&) = delete;
+
+        /**
+         * @brief Return a consistent copy of the value, without blocking
+         */
+        [[nodiscard]] T copy() const
+        {
+            std::uint64_t buffer[wordCount];
+            while (true)
+            {
+                auto const before = sequence.load(std::memory_order_acquire);
+                if (before % 2 == 0)
+                {
+                    for (size_t i = 0; i < wordCount; ++i)
+                        buffer[i] = words[i].load(std::memory_order_relaxed);
+                    std::atomic_thread_fence(std::memory_order_acquire);
+                    if (sequence.load(std::memory_order_relaxed) == before)
+                        break;
+                }
+                counters.retried();
+            }
+            counters.locked(false);
+
+            T result;
+            std::memcpy(&result, buffer, sizeof(T));
+            return result;
+        }
+
+        /**
+         * @brief Call `func(T const&)` with a consistent copy of the value, and return its result
+         */
+        template<typename Func>
+        decltype(auto) withReadLock(Func&& func) const
+        {
+            T const current = copy();
+            return std::forward<Func>(func)(current);
+        }
+
+        /**
+         * @brief Call `func(T&)` with a copy of the value holding the writer lock, then publish the modified copy
+         */
+        template<typename Func>
+        decltype(auto) withLock(Func&& func)
+        {
+            std::unique_lock guard{ writer, std::try_to_lock };
+            Synchronized_detail::take(guard, counters);
+            T current;
+            std::uint64_t buffer[wordCount];
+            for (size_t i = 0; i < wordCount; ++i)
+                buffer[i] = words[i].load(std::memory_order_relaxed);
+            std::memcpy(&current, buffer, sizeof(T));
+
+            if constexpr (std::is_void_v<decltype(std::forward<Func>(func)(current))>)
+            {
+                std::forward<Func>(func)(current);
+                write(current);
+            }
+            else
+            {
+                auto result = std::forward<Func>(func)(current);
+                write(current);
+                return result;
+            }
+        }
+
+        /**
+         * @brief The same as @ref withLock
+         */
+        template<typename Func>
+        decltype(auto) withWriteLock(Func&& func)
+        {
+            return withLock(std::forward<Func>(func));
+        }
+
+        /**
+         * @brief Replace the value
+         */
+        void store(T const& newValue)
+        {
+            std::unique_lock guard{ writer, std::try_to_lock };
+            Synchronized_detail::take(guard, counters);
+            write(newValue);
+        }
+
+        [[nodiscard]] SynchronizedStats stats() const
+        {
+            static_assert(CollectStats, "stats() needs a Synchronized created with CollectStats = true");
+            return counters.get();
+        }
+    };
+
+#ifdef SugarPPNamespace
+}
+#endif
@@ -0,0 +1,384 @@
+/*****************************************************************//**
+ * \file   threadPool.hpp
+ * \brief  A work-stealing thread pool shared by the parallel algorithms
+ *
+ * \author Peter
+ * \date   October 2026
+ *********************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "topology.hpp"
+
+#ifdef SugarPPNamespace
+namespace SugarPP
+{
+#endif
+
+    namespace ThreadPool_detail
+    {
+        /**
+         * @brief A move-only type-erased `void()` callable, because `std::function` requires the callable to be copyable
+         * @details It can also hold a plain function pointer with a context pointer, which does not allocate.
+         */
+        class Task
+        {
+            struct Concept
+            {
+                virtual ~Concept() = default;
+                virtual void run() = 0;
+            };
+
+            template<typename Func>
+            struct Model : Concept
+            {
+                Func func;
+                explicit Model(Func&& func) :func(std::move(func)) {}
+                void run() override { func(); }
+            };
+
+            std::unique_ptr<Concept> impl;
+            void (*function)(void*) = nullptr;
+            void* context = nullptr;
+        public:
+            Task() = default;
+
+            template<typename Func, typename = std::enable_if_t<!std::is_same_v<std::decay_t<Func>, Task>>>
+            Task(Func&& func) :impl(std::make_unique<Model<std::decay_t<Func>>>(std::decay_t<Func>(std::forward<Func>(func)))) {}
+
+            Task(void (*function)(void*), void* context) :function(function), context(context) {}
+
+            void operator()() { function ? function(context) : impl->run(); }
+
+            explicit operator bool() const { return function || impl; }
+        };
+    }
+
+    /**
+     * @brief A work-stealing thread pool
+     * @details
+     * Every worker owns a task queue. Tasks posted from a worker go to the back of its own queue and are taken from the back (LIFO),
+     * tasks posted from other threads go to a shared queue. An idle worker first takes from its own queue, then from the shared queue,
+     * then steals from the front of other workers' queues.
+     *
+     * A thread that has to wait for some tasks to finish can call @ref helpUntil to run pending tasks instead of blocking,
+     * so nested parallelism on the same pool never deadlocks.
+     *
+     * @ref shared() returns the pool used by @ref parallel and the other parallel algorithms of SugarPP.
+     *
+     * A pool can pin its workers to CPUs with a @ref ThreadAffinity, then @ref nodeOf tells which NUMA node a worker runs on,
+     * and @ref postTo runs a task preferably on a given worker, so that it works on memory local to that node.
+     */
+    class ThreadPool
+    {
+        using Task = ThreadPool_detail::Task;
+
+        struct Worker
+        {
+            std::mutex m;
+            std::deque<Task> tasks;
+        };
+
+        std::vector<std::unique_ptr<Worker>> workers;
+        std::mutex globalMutex;
+        std::deque<Task> globalTasks;
+
+        std::mutex sleepMutex;
+        std::condition_variable wake;
+        std::atomic<size_t> pending{ 0 };
+        std::atomic<unsigned> sleepers{ 0 };
+        std::atomic<bool> stopping{ false };
+        std::vector<std::thread> threads;
+        ThreadAffinity affinityPolicy;
+        std::vector<CpuTopology::Cpu> placement;
+
+        struct CurrentWorker
+        {
+            ThreadPool* pool = nullptr;
+            size_t index = 0;
+        };
+
+        static CurrentWorker& currentWorker()
+        {
+            static thread_local CurrentWorker current;
+            return current;
+        }
+
+        void push(Task task)
+        {
+            auto const& current = currentWorker();
+            if (current.pool == this)
+            {
+                auto& worker = *workers[current.index];
+                std::lock_guard lock{ worker.m };
+                worker.tasks.push_back(std::move(task));
+            }
+            else
+            {
+                std::lock_guard lock{ globalMutex };
+                globalTasks.push_back(std::move(task));
+            }
+            pending.fetch_add(1);
+            if (sleepers.load() != 0)
+            {
+                std::lock_guard lock{ sleepMutex };
+                wake.notify_one();
+            }
+        }
+
+        void pushTo(size_t index, Task task)
+        {
+            {
+                auto& worker = *workers[index % workers.size()];
+                std::lock_guard lock{ worker.m };
+                worker.tasks.push_back(std::move(task));
+            }
+            pending.fetch_add(1);
+            if (sleepers.load() != 0)
+            {
+                /*waking up only one worker may not wake up the one owning the task*/
+                std::lock_guard lock{ sleepMutex };
+                wake.notify_all();
+            }
+        }
+
+        static bool popFront(std::mutex& m, std::deque<Task>& tasks, Task& task)
+        {
+            std::lock_guard lock{ m };
+            if (tasks.empty())
+                return false;
+            task = std::move(tasks.front());
+            tasks.pop_front();
+            return true;
+        }
+
+        bool pop(Task& task)
+        {
+            if (pending.load(std::memory_order_relaxed) == 0)
+                return false;
+
+            auto const& current = currentWorker();
+            auto const self = current.pool == this ? current.index : workers.size();
+            if (self != workers.size())
+            {
+                auto& worker = *workers[self];
+                std::lock_guard lock{ worker.m };
+                if (!worker.tasks.empty())
+                {
+                    task = std::move(worker.tasks.back());
+                    worker.tasks.pop_back();
+                    pending.fetch_sub(1);
+                    return true;
+                }
+            }
+            if (popFront(globalMutex, globalTasks, task))
+            {
+                pending.fetch_sub(1);
+                return true;
+            }
+            for (size_t i = 1; i <= workers.size(); ++i)
+            {
+                auto const victim = (self + i) % workers.size();
+                if (victim != self && popFront(workers[victim]->m, workers[victim]->tasks, task))
+                {
+                    pending.fetch_sub(1);
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void work(size_t index)
+        {
+            if (!placement.empty())
+                Topology_detail::pinCurrentThread(placement[index].id);
+            currentWorker() = { this, index };
+            Task task;
+            while (true)
+            {
+                if (pop(task))
+                {
+                    task();
+                    task = {};
+                    continue;
+                }
+                std::unique_lock lock{ sleepMutex };
+                sleepers.fetch_add(1);
+                wake.wait(lock, [this] { return stopping.load() || pending.load() != 0; });
+                sleepers.fetch_sub(1);
+                if (stopping.load() && pending.load() == 0)
+                    return;
+            }
+        }
+
+    public:
+        /**
+         * @brief Start a pool of `threadCount` workers, pinned to CPUs according to `affinity`
+         * @details With @ref ThreadAffinity::Compact, the workers with consecutive indexes are on the same NUMA node.
+         * On a single-node machine, or where threads can not be pinned, the pool works as if they were not pinned.
+         */
+        explicit ThreadPool(unsigned threadCount = std::thread::hardware_concurrency(), ThreadAffinity affinity = ThreadAffinity::None)
+            :affinityPolicy(affinity)
+        {
+            if (threadCount == 0)
+                threadCount = 1;
+            placement = CpuTopology::system().placement(affinity, threadCount);
+            workers.reserve(threadCount);
+            for (unsigned i = 0; i < threadCount; ++i)
+                workers.push_back(std::make_unique<Worker>());
+            threads.reserve(threadCount);
+            for (unsigned i = 0; i < threadCount; ++i)
+                threads.emplace_back([this, i] { work(i); });
+        }
+
+        ThreadPool(ThreadPool const&) = delete;
+        ThreadPool& operator=(ThreadPool const&) = delete;
+
+        /**
+         * @brief Finish every pending task, then join all the workers
+         */
+        ~ThreadPool()
+        {
+            {
+                std::lock_guard lock{ sleepMutex };
+                stopping.store(true);
+            }
+            wake.notify_all();
+            for (auto& thread : threads)
+                thread.join();
+        }
+
+        /**
+         * @brief Return the pool shared by @ref parallel and the other parallel algorithms, with one worker per hardware thread
+         */
+        static ThreadPool& shared()
+        {
+            static ThreadPool pool;
+            return pool;
+        }
+
+        /**
+         * @brief Return the pool the calling thread is a worker of, or nullptr if it is not a worker thread
+         */
+        static ThreadPool* current()
+        {
+            return currentWorker().pool;
+        }
+
+        /**
+         * @brief Return the number of workers
+         */
+        [[nodiscard]] unsigned size() const
+        {
+            return static_cast<unsigned>(threads.size());
+        }
+
+        /**
+         * @brief Return how the workers are pinned to CPUs
+         */
+        [[nodiscard]] ThreadAffinity affinity() const
+        {
+            return affinityPolicy;
+        }
+
+        /**
+         * @brief Return the NUMA node the worker at `index` is pinned to, which is 0 if the workers are not pinned
+         */
+        [[nodiscard]] unsigned nodeOf(unsigned index) const
+        {
+            return placement.empty() ? 0 : placement[index % placement.size()].node;
+        }
+
+        /**
+         * @brief Run `func` on the pool, without a way to get the result
+         * @note Like `std::thread`, an exception escaping from `func` calls `std::terminate`
+         */
+        template<typename Func>
+        void post(Func&& func)
+        {
+            push(Task{ std::forward<Func>(func) });
+        }
+
+        /**
+         * @brief Run `function(context)` on the pool, which unlike posting a callable object never allocates
+         */
+        void post(void (*function)(void*), void* context)
+        {
+            push(Task{ function, context });
+        }
+
+        /**
+         * @brief Run `func` on the worker at `index`, unless another worker becomes idle first and steals it
+         * @note Like `std::thread`, an exception escaping from `func` calls `std::terminate`
+         */
+        template<typename Func>
+        void postTo(unsigned index, Func&& func)
+        {
+            pushTo(index, Task{ std::forward<Func>(func) });
+        }
+
+        /**
+         * @brief Run `func` on the pool
+         * @return A `std::future` holding the result or the exception of `func`
+         */
+        template<typename Func>
+        [[nodiscard]] auto submit(Func&& func)
+        {
+            std::packaged_task<std::invoke_result_t<std::decay_t<Func>>()> task{ std::forward<Func>(func) };
+            auto result = task.get_future();
+            push(Task{ std::move(task) });
+            return result;
+        }
+
+        /**
+         * @brief Run one pending task on the calling thread
+         * @return false if there was no pending task
+         */
+        bool runPending()
+        {
+            Task task;
+            if (!pop(task))
+                return false;
+            task();
+            return true;
+        }
+
+        /**
+         * @brief Run pending tasks on the calling thread until `done()` returns true
+         * @details When there is nothing to run, the thread backs off by yielding and then by sleeping for short periods,
+         * so `done()` is polled rather than waited on. Use it to wait for tasks which were posted to this pool.
+         * The thread does not wait on the workers' wake up signal, so it never takes a wake up away from a sleeping worker.
+         */
+        template<typename Predicate>
+        void helpUntil(Predicate&& done)
+        {
+            unsigned idle = 0;
+            while (!done())
+            {
+                if (runPending())
+                {
+                    idle = 0;
+                    continue;
+                }
+                if (++idle < 64)
+                    std::this_thread::yield();
+                else
+                    std::this_thread::sleep_for(std::chrono::microseconds{ 50 });
+            }
+        }
+    };
+
+#ifdef SugarPPNamespace
+}
+#endif
@@ -0,0 +1,257 @@
+/*****************************************************************//**
+ * \file   topology.hpp
+ * \brief  NUMA nodes and cores of the machine, and pinning threads to them
+ *
+ * \author Peter
+ * \date   October 2026
+ * \note The topology is read from /sys on Linux. Elsewhere every CPU is reported on a single node, and threads are not pinned.
+ *********************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#ifdef SugarPPNamespace
+namespace SugarPP
+{
+#endif
+
+    /**
+     * @brief How the workers of a @ref ThreadPool are pinned to CPUs
+     */
+    enum class ThreadAffinity
+    {
+        None,       /**< Not pinned, the OS places the workers */
+        Compact,    /**< Fill the CPUs of a NUMA node, including the hyper-threads of a core, before going to the next node */
+        Scatter     /**< Spread over NUMA nodes in turn, and over physical cores before their hyper-threads */
+    };
+
+    namespace Topology_detail
+    {
+        /**
+         * @brief Parse a list of CPUs or nodes in the format of /sys, like "0-3,8-11"
+         */
+        inline std::vector<unsigned> parseList(std::string const& list)
+        {
+            std::vector<unsigned> values;
+            size_t position = 0;
+            while (position < list.size())
+            {
+                auto const next = std::min(list.find(',', position), list.size());
+                auto const item = list.substr(position, next - position);
+                position = next + 1;
+                unsigned first = 0, last = 0;
+                auto const parsed = std::sscanf(item.c_str(), "%u-%u", &first, &last);
+                if (parsed == 1)
+                    last = first;
+                else if (parsed != 2)
+                    continue;
+                for (auto value = first; value <= last; ++value)
+                    values.push_back(value);
+            }
+            return values;
+        }
+
+        /**
+         * @brief Return the first line of the file at `path`, or an empty string if it can not be read
+         */
+        inline std::string readLine(std::string const& path)
+        {
+            std::string line;
+            if (auto file = std::fopen(path.c_str(), "r"))
+            {
+                char buffer[4096];
+                if (std::fgets(buffer, sizeof(buffer), file))
+                    line = buffer;
+                std::fclose(file);
+            }
+            while (!line.empty() && (line.back() == '\n' || line.back() == '\r'))
+                line.pop_back();
+            return line;
+        }
+
+        /**
+         * @brief Pin the calling thread to `cpu`, ignoring failures
+         */
+        inline void pinCurrentThread([[maybe_unused]] unsigned cpu)
+        {
+#ifdef __linux__
+            if (cpu >= CPU_SETSIZE)
+                return;
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(cpu, &set);
+            pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#endif
+        }
+    }
+
+    /**
+     * @brief The CPUs the process may run on, grouped by NUMA node
+     * @details
+     * On Linux the nodes are read from /sys/devices/system/node and the cores from /sys/devices/system/cpu, restricted to the CPUs
+     * in the affinity mask of the process. When they are not available, like on other systems or in some containers, all the
+     * hardware threads are reported as separate cores of a single node, so code using it works the same on single-node machines.
+     */
+    class CpuTopology
+    {
+    public:
+        struct Cpu
+        {
+            unsigned id;    /**< The index of the CPU for the OS */
+            unsigned node;  /**< The index of the NUMA node in @ref nodeCount, not the id of the node for the OS */
+            unsigned core;  /**< CPUs with the same core are hyper-threads of one physical core */
+        };
+
+        /**
+         * @brief The CPUs sorted by node, then by core
+         */
+        std::vector<Cpu> cpus;
+
+        /**
+         * @brief The number of NUMA nodes having at least one CPU
+         */
+        unsigned nodeCount = 1;
+
+        /**
+         * @brief Return the topology of this machine, which is read once
+         */
+        static CpuTopology const& system()
+        {
+            static CpuTopology const topology = read();
+            return topology;
+        }
+
+        /**
+         * @brief Return the CPU each of `threadCount` threads should be pinned to with `affinity`
+         * @details The CPUs are reused in the same order when there are more threads than CPUs.
+         * The result is empty for @ref ThreadAffinity::None.
+         */
+        [[nodiscard]] std::vector<Cpu> placement(ThreadAffinity affinity, unsigned threadCount) const
+        {
+            if (affinity == ThreadAffinity::None || cpus.empty())
+                return {};
+
+            std::vector<Cpu> order;
+            if (affinity == ThreadAffinity::Compact)
+                order = cpus;
+            else
+            {
+                /*on each node, the first hyper-thread of every core comes before the second ones*/
+                std::vector<std::vector<std::pair<unsigned, Cpu>>> nodes(nodeCount);
+                for (size_t i = 0; i < cpus.size(); ++i)
+                {
+                    unsigned rank = 0;
+                    for (size_t j = 0; j < i; ++j)
+                        rank += cpus[j].core == cpus[i].core;
+                    nodes[cpus[i].node].emplace_back(rank, cpus[i]);
+                }
+                for (auto& node : nodes)
+                    std::stable_sort(node.begin(), node.end(), [](auto const& lhs, auto const& rhs) { return lhs.first < rhs.first; });
+                for (size_t i = 0; order.size() < cpus.size(); ++i)
+                {
+                    for (auto const& node : nodes)
+                    {
+                        if (i < node.size())
+                            order.push_back(node[i].second);
+                    }
+                }
+            }
+
+            std::vector<Cpu> result;
+            result.reserve(threadCount);
+            for (unsigned i = 0; i < threadCount; ++i)
+                result.push_back(order[i % order.size()]);
+            return result;
+        }
+
+    private:
+        static CpuTopology singleNode()
+        {
+            CpuTopology topology;
+            auto const count = std::max(std::thread::hardware_concurrency(), 1u);
+            for (unsigned i = 0; i < count; ++i)
+                topology.cpus.push_back({ i, 0, i });
+            return topology;
+        }
+
+        static CpuTopology read()
+        {
+#ifdef __linux__
+            cpu_set_t allowed;
+            CPU_ZERO(&allowed);
+            auto const hasMask = sched_getaffinity(0, sizeof(allowed), &allowed) == 0;
+            auto const isAllowed = [&](unsigned cpu) { return !hasMask || (cpu < CPU_SETSIZE && CPU_ISSET(cpu, &allowed)); };
+
+            std::string const nodeRoot = "/sys/devices/system/node/";
+            std::string const cpuRoot = "/sys/devices/system/cpu/";
+            auto nodeIds = Topology_detail::parseList(Topology_detail::readLine(nodeRoot + "online"));
+            if (nodeIds.empty())
+            {
+                /*kernels without NUMA support have no node directory, the CPUs are still described*/
+                nodeIds.push_back(0);
+            }
+
+            CpuTopology topology;
+            topology.nodeCount = 0;
+            std::vector<std::tuple<unsigned, unsigned, unsigned>> cores;   //package, core id, index
+            for (auto const nodeId : nodeIds)
+            {
+                auto nodeCpus = Topology_detail::parseList(Topology_detail::readLine(nodeRoot + "node" + std::to_string(nodeId) + "/cpulist"));
+                if (nodeIds.size() == 1 && nodeCpus.empty())
+                    nodeCpus = Topology_detail::parseList(Topology_detail::readLine(cpuRoot + "online"));
+
+                auto found = false;
+                for (auto const cpu : nodeCpus)
+                {
+                    if (!isAllowed(cpu))
+                        continue;
+                    auto const path = cpuRoot + "cpu" + std::to_string(cpu) + "/topology/";
+                    auto const package = Topology_detail::readLine(path + "physical_package_id");
+                    auto const coreId = Topology_detail::readLine(path + "core_id");
+                    std::tuple<unsigned, unsigned, unsigned> key{ 0, cpu, 0 };
+                    if (!package.empty() && !coreId.empty())
+                        key = { static_cast<unsigned>(std::stoul(package)), static_cast<unsigned>(std::stoul(coreId)), 0 };
+
+                    auto core = std::find_if(cores.begin(), cores.end(), [&key](auto const& known)
+                    {
+                        return std::get<0>(known) == std::get<0>(key) && std::get<1>(known) == std::get<1>(key);
+                    });
+                    if (core == cores.end())
+                    {
+                        std::get<2>(key) = static_cast<unsigned>(cores.size());
+                        core = cores.insert(cores.end(), key);
+                    }
+                    topology.cpus.push_back({ cpu, topology.nodeCount, std::get<2>(*core) });
+                    found = true;
+                }
+                if (found)
+                    ++topology.nodeCount;
+            }
+            if (topology.cpus.empty())
+                return singleNode();
+
+            std::stable_sort(topology.cpus.begin(), topology.cpus.end(), [](Cpu const& lhs, Cpu const& rhs)
+            {
+                return std::tie(lhs.node, lhs.core) < std::tie(rhs.node, rhs.core);
+            });
+            return topology;
+#else
+            return singleNode();
+#endif
+        }
+    };
+
+#ifdef SugarPPNamespace
+}
+#endif
@@ -0,0 +1,78 @@
+/*****************************************************************//**
+ * \file   traits.hpp
+ * \brief  Type traits and small helpers shared by the other headers
+ *
+ * \author Peter
+ * \date   October 2026
+ *********************************************************************/
+
+#pragma once
+
+#include <iosfwd>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#ifdef SugarPPNamespace
+namespace SugarPP
+{
+#endif
+
+    namespace Traits_detail
+    {
+        template<typename T>
+        struct is_tuple_impl : std::false_type {};
+
+        template<typename... Ts>
+        struct is_tuple_impl<std::tuple<Ts...>> : std::true_type {};
+
+        template<typename T>
+        struct is_tuple : is_tuple_impl<std::decay_t<T>> {};
+
+        template<typename T, typename = void>
+        struct iterable_impl :std::false_type {};
+
+        template<typename T>
+        struct iterable_impl<T, decltype(std::begin(std::declval<T>()), void())> :std::true_type {};  //still works even when T is const
+
+        template<typename T>
+        struct iterable :iterable_impl
+        <
+            std::conditional_t
+            <
+                std::is_array_v<std::remove_reference_t<T>>,
+                T,
+                std::decay_t<T>
+            >
+        > {};
+
+        /**
+         * @brief Whether an lvalue of `T` can be iterated, which unlike @ref iterable also accepts types with a non-const `begin()`, like @ref Range
+         */
+        template<typename T>
+        struct iterable_lvalue :iterable_impl<std::remove_reference_t<T>&> {};
+
+        /**
+         * @brief Whether `T` can be written to a `Stream` with `operator<<`
+         * @note Only the `operator<<` overloads declared where the trait is used are found, so include `<ostream>` before using it
+         */
+        template<typename T, typename Stream = std::ostream, typename = void>
+        struct printable :std::false_type {};
+
+        template<typename T, typename Stream>
+        struct printable<T, Stream, decltype(std::declval<Stream&>() << std::declval<T>(), void())> :std::true_type {};
+
+        /**
+         * @brief A function returning its argument, the default key or transform of the algorithms taking one
+         */
+        struct Identity
+        {
+            template<typename T>
+            T&& operator()(T&& value) const { return std::forward<T>(value); }
+        };
+    }
+
+#ifdef SugarPPNamespace
+}
+#endif
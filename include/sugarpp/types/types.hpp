@@ -8,11 +8,11 @@
 #pragma once
 
 #include <string>
-#include <iostream>
 #include <tuple>
 #include <type_traits>
 #include <sstream>
 #include <cstdlib> //for atoi, atol, atoll
+#include "../traits/traits.hpp"
 
 #ifdef SugarPPNamespace
 namespace SugarPP
@@ -26,37 +26,9 @@ namespace SugarPP
         template<typename T>
         struct has_to_string<T, decltype(std::to_string(std::declval<T>()), void())>:std::true_type{};
 
-        template<typename T>
-        struct is_tuple_impl : std::false_type {};
-
-        template<typename... Ts>
-        struct is_tuple_impl<std::tuple<Ts...>> : std::true_type {};
-
-        template<typename T>
-        struct is_tuple : is_tuple_impl<std::decay_t<T>> {};
-
-        template<typename T, typename = void>
-        struct iterable_impl :std::false_type {};
-
-        template<typename T>
-        struct iterable_impl<T, decltype(std::begin(std::declval<T>()), void())> :std::true_type {};  //still works even when T is const
-
-        template<typename T>
-        struct iterable :iterable_impl
-        <
-            std::conditional_t
-            <
-                std::is_array_v<std::remove_reference_t<T>>,
-                T,
-                std::decay_t<T>
-            >
-        > {};
-
-        template<typename T, std::ostream& os = std::cout, typename = void>
-        struct printable :std::false_type {};
-
-        template<typename T, std::ostream& os>
-        struct printable<T, os, decltype(os << std::declval<T>(), void())> :std::true_type {};
+        using Traits_detail::is_tuple;
+        using Traits_detail::iterable;
+        using Traits_detail::printable;
 
         template<typename Char = char, typename T>
         auto getString(T&& arg)
@@ -92,7 +64,7 @@ namespace SugarPP
             {
                 os << '[';
                 for (auto& element : arg)
-                    os << print_impl(element);
+                    os << getString<Char>(element);
                 os << ']';
                 return os.str();
             }
@@ -0,0 +1,42 @@
+/*****************************************************************//**
+ * \file   check.cpp
+ * \brief  Imports the sugarpp module and uses some of its exports, built as SugarPP_module_check with SugarPPBuildModule
+ *
+ * \author Peter
+ * \date   October 2026
+ * \note Keep it using whatever a new export in sugarpp.cppm adds, so that the module is compiled and imported in CI
+ *********************************************************************/
+
+#include <string>
+#include <vector>
+
+import sugarpp;
+
+using namespace SugarPP;
+
+int main()
+{
+    std::vector<int> const numbers{ 3, 1, 2 };
+    print(sum(numbers), min(numbers), max(numbers), any(numbers, [](int n) { return n > 2; }));  //6 1 3 True
+    print(sorted(numbers).front(), parallel_any_of(Range(0, 1000), [](int n) { return n == 999; }));   //1 True
+    print(join(split("a,b,c", ','), "+"));          //a+b+c
+
+    Counter<std::string> counter{ std::vector<std::string>{ "x", "y", "x" } };
+    print(counter["x"]);                            //2
+    HashMap<int, int> map;
+    map[1] = 2;
+    print(map[1]);                                  //2
+
+    {
+        MappedWriter writer{ "module_check.txt", 16 };
+        for (auto i : Range(0, 3))
+            writer.print(2 - i, "line");
+    }
+    external_sort("module_check.txt", "module_check_sorted.txt", 1 << 20);
+    print(count_lines("module_check_sorted.txt"), file_to_string("module_check_sorted.txt").substr(0, 6)); //3 0 line
+
+    Synchronized<int> value{ 1 };
+    value.withLock([](int& v) { ++v; });
+    print(value.copy());                            //2
+    print(CpuTopology::system().cpus.empty());       //False
+}
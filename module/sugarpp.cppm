@@ -0,0 +1,189 @@
+/*****************************************************************//**
+ * \file   sugarpp.cppm
+ * \brief  C++20 named module exporting every C++17 header of SugarPP
+ *
+ * \author Peter
+ * \date   October 2026
+ * \note Experimental, see the SugarPPBuildModule option in CMakeLists.txt. The module job of CI builds it and imports it in
+ *       check.cpp, which should use what a new export adds
+ * ~~~~{.cpp}
+ *     import sugarpp;
+ *     using namespace SugarPP;
+ * ~~~~
+ *********************************************************************/
+
+module;
+
+#ifndef SugarPPNamespace
+#define SugarPPNamespace
+#endif
+
+#include "sugarpp/all.hpp"
+#include "sugarpp/lazy/lazy.hpp"
+
+export module sugarpp;
+
+export namespace SugarPP
+{
+    /*io/io.hpp*/
+    using SugarPP::restore;
+    using SugarPP::input;
+    using SugarPP::print;
+    using SugarPP::printLn;
+    using SugarPP::ThreadSafe;
+
+    /*io/log.hpp*/
+    using SugarPP::Level;
+    using SugarPP::setLogLevel;
+    using SugarPP::logLevel;
+    using SugarPP::logEnabled;
+    using SugarPP::LogEvery;
+    using SugarPP::LogRate;
+    using SugarPP::log;
+
+    /*io/scan.hpp*/
+    using SugarPP::ScanFormat;
+    using SugarPP::scan;
+    using SugarPP::input_line;
+
+    /*io/binaryLog.hpp*/
+    using SugarPP::LogSite;
+    using SugarPP::binaryLog;
+    using SugarPP::BinaryLog;
+    using SugarPP::decodeBinaryLog;
+
+    /*io/file.hpp*/
+    using SugarPP::FileIOError;
+    using SugarPP::FileIterator;
+    using SugarPP::ReadAhead;
+    using SugarPP::DirectReader;
+    using SugarPP::file_to_string;
+    using SugarPP::file_to_vec;
+
+    /*io/mappedWriter.hpp*/
+    using SugarPP::MappedWriter;
+
+    /*io/fileCache.hpp*/
+    using SugarPP::FileCacheStats;
+    using SugarPP::FileCache;
+
+    /*io/walk.hpp*/
+    using SugarPP::EntryType;
+    using SugarPP::WalkEntry;
+    using SugarPP::walk;
+
+    /*io/search.hpp*/
+    using SugarPP::FileMatch;
+    using SugarPP::count_lines;
+    using SugarPP::find_all;
+
+    /*io/externalSort.hpp*/
+    using SugarPP::external_sort;
+
+    /*memory/allocator.hpp*/
+    using SugarPP::AlignedAllocator;
+    using SugarPP::HugePages;
+    using SugarPP::HugePageAllocator;
+
+    /*range*/
+    using SugarPP::RangeType;
+    using SugarPP::Range;
+    using SugarPP::MultiRange;
+    using SugarPP::LetterRange;
+    using SugarPP::operator==;
+    using SugarPP::operator!=;
+    using SugarPP::Enumerate;
+    using SugarPP::EnumerateIterator;
+    using SugarPP::Zip;
+    using SugarPP::ZipIterator;
+    using SugarPP::parallel;
+    using SugarPP::parallel_find_if;
+    using SugarPP::parallel_any_of;
+    using SugarPP::firstTouch;
+    using SugarPP::makeFirstTouched;
+    using SugarPP::ParallelPolicy;
+    using SugarPP::par;
+
+    /*range/reduce.hpp*/
+    using SugarPP::Summation;
+    using SugarPP::sum;
+    using SugarPP::min;
+    using SugarPP::max;
+    using SugarPP::minmax;
+    using SugarPP::any;
+    using SugarPP::all;
+
+    /*range/sort.hpp*/
+    using SugarPP::Stability;
+    using SugarPP::sorted;
+    using SugarPP::sort;
+    namespace CommonRanges = SugarPP::CommonRanges;
+
+    /*range/slice.hpp*/
+    using SugarPP::Span;
+    using SugarPP::StridedView;
+    using SugarPP::slice;
+
+    /*collection*/
+    using SugarPP::HashMap;
+    using SugarPP::Counter;
+    using SugarPP::groupBy;
+    using SugarPP::associateBy;
+    using SugarPP::associate;
+
+    /*string/split.hpp*/
+    using SugarPP::SplitView;
+    using SugarPP::split;
+    using SugarPP::join;
+
+    /*thread/threadPool.hpp*/
+    using SugarPP::ThreadPool;
+
+    /*thread/pool.hpp*/
+    using SugarPP::Pool;
+
+    /*thread/synchronized.hpp*/
+    using SugarPP::SeqLock;
+    using SugarPP::SynchronizedStats;
+    using SugarPP::Synchronized;
+
+    /*thread/topology.hpp*/
+    using SugarPP::ThreadAffinity;
+    using SugarPP::CpuTopology;
+
+    /*channel/channel.hpp*/
+    using SugarPP::ChannelClosedError;
+    using SugarPP::ChannelType;
+    using SugarPP::Channel;
+    using SugarPP::ChannelWaiter;
+
+    /*pipeline/pipeline.hpp*/
+    using SugarPP::PipelineOrder;
+    using SugarPP::Stage;
+    using SugarPP::Sink;
+    using SugarPP::Pipeline;
+    using SugarPP::stage;
+    using SugarPP::sink;
+    using SugarPP::printSink;
+    using SugarPP::fileSink;
+    using SugarPP::pipeline;
+
+    /*types/types.hpp*/
+    using SugarPP::to_string;
+    using SugarPP::to_num;
+
+    /*when/when.hpp*/
+    using SugarPP::when;
+    using SugarPP::Else;
+    using SugarPP::is;
+    using SugarPP::is_not;
+    using SugarPP::is_actually;
+    using SugarPP::_;
+    using SugarPP::NOT;
+    using SugarPP::AND;
+    using SugarPP::OR;
+
+    /*lazy/lazy.hpp*/
+    using SugarPP::ThreadSafetyMode;
+    using SugarPP::Lazy;
+}
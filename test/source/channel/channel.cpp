@@ -0,0 +1,173 @@
+#include "sugarpp/channel/channel.hpp"
+#include "sugarpp/thread/threadPool.hpp"
+#include "sugarpp/io/io.hpp"
+#include "sugarpp/range/range.hpp"
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace SugarPP;
+using namespace std::chrono_literals;
+
+int main()
+{
+    {
+        /*a single producer and a single consumer, consumed with range-based for loop*/
+        Channel<int, ChannelType::SPSC> channel{ 16 };
+        std::thread producer{ [&channel]
+        {
+            for (auto i : Range(0, 1000))
+                channel.send(i);
+            channel.close();
+        } };
+        long long sum = 0;
+        for (auto i : channel)
+            sum += i;
+        producer.join();
+        print("SPSC sum:", sum);
+    }
+    {
+        /*multiple producers and multiple consumers*/
+        Channel<std::string> channel{ 64 };
+        std::vector<std::thread> producers;
+        for (auto id : Range(0, 4))
+        {
+            producers.emplace_back([&channel, id]
+            {
+                for (auto i : Range(0, 250))
+                    channel.send(std::to_string(id * 1000 + i));
+            });
+        }
+        std::atomic<int> received{ 0 };
+        std::vector<std::thread> consumers;
+        for ([[maybe_unused]] auto id : Range(0, 3))
+        {
+            consumers.emplace_back([&channel, &received]
+            {
+                while (auto value = channel.receive())
+                    ++received;
+            });
+        }
+        for (auto& producer : producers)
+            producer.join();
+        channel.close();
+        for (auto& consumer : consumers)
+            consumer.join();
+        print("MPMC received:", received.load());
+    }
+    {
+        /*try and timed operations*/
+        Channel<int> channel{ 2 };
+        auto const sent1 = channel.trySend(1);
+        auto const sent2 = channel.trySend(2);
+        auto const sent3 = channel.trySend(3);
+        print(sent1, sent2, sent3);                         //True True False
+        print(channel.sendFor(3, 10ms));                    //False, timed out
+        auto const first = channel.tryReceive();
+        auto const second = channel.receiveFor(10ms);
+        print(*first, *second);                             //1 2
+        print(channel.tryReceive().has_value());            //False
+        print(channel.receiveFor(10ms).has_value());        //False, timed out
+
+        /*closed channel*/
+        channel.send(4);
+        channel.close();
+        print(channel.trySend(5));                          //False
+        print(channel.isClosedForSend(), channel.isClosedForReceive()); //True False
+        print(*channel.receive());                          //4
+        print(channel.receive().has_value(), channel.isClosedForReceive()); //False True
+        try
+        {
+            channel.send(6);
+        }
+        catch (ChannelClosedError const& e)
+        {
+            print(e.what());
+        }
+    }
+    {
+        /*batch send & receive*/
+        Channel<int, ChannelType::SPSC> channel{ 8 };
+        std::thread producer{ [&channel]
+        {
+            std::vector<int> values(100);
+            Range(0, 100).fillRand(values);
+            channel.sendBatch(values.begin(), values.end());
+            channel.close();
+        } };
+        std::vector<int> received;
+        while (channel.receiveBatch(std::back_inserter(received), 32) != 0)
+            ;
+        producer.join();
+        print("Batch received:", received.size());
+    }
+    {
+        /*consume on a thread pool: drain tasks only run while there is something to receive*/
+        ThreadPool pool{ 2 };
+        Channel<int> channel{ 4 };
+        std::atomic<int> sum{ 0 };
+        auto done = channel.forEach([&sum](int value) { sum += value; }, 2, pool);
+        for (auto i : Range(0, 100))
+            channel.send(i);
+        channel.close();
+        done.get();
+        print("Pool sum:", sum.load());
+    }
+    {
+        /*an SPSC channel has one receiver, so its drain tasks never run at once, whatever the concurrency*/
+        ThreadPool pool{ 4 };
+        Channel<int, ChannelType::SPSC> channel{ 4 };
+        long long sum = 0;
+        std::atomic<int> running{ 0 };
+        std::atomic<int> mostRunning{ 0 };
+        auto done = channel.forEach([&](int value)
+        {
+            auto const now = running.fetch_add(1) + 1;
+            if (now > mostRunning.load())
+                mostRunning.store(now);
+            sum += value;
+            running.fetch_sub(1);
+        }, 4, pool);
+        for (auto i : Range(0, 10000))
+            channel.send(i);
+        channel.close();
+        done.get();
+        print("SPSC pool sum:", sum, "at once:", mostRunning.load());     //SPSC pool sum: 49995000 at once: 1
+    }
+    {
+        /*close and destroy the channel while senders are racing, no drain task may run after the future is ready*/
+        ThreadPool pool{ 4 };
+        long long consumed = 0;
+        for ([[maybe_unused]] auto round : Range(0, 200))
+        {
+            auto channel = std::make_unique<Channel<int>>(4);
+            std::atomic<long long> sum{ 0 };
+            auto done = channel->forEach([&sum](int value) { sum += value; }, 2, pool);
+            std::vector<std::thread> senders;
+            for ([[maybe_unused]] auto id : Range(0, 4))
+            {
+                senders.emplace_back([&channel]
+                {
+                    try
+                    {
+                        while (true)
+                            channel->send(1);
+                    }
+                    catch (ChannelClosedError const&)
+                    {
+                    }
+                });
+            }
+            std::this_thread::sleep_for(100us);
+            channel->close();
+            for (auto& sender : senders)
+                sender.join();
+            done.get();
+            channel.reset();
+            consumed += sum.load() != 0;
+        }
+        print("Rounds with values consumed:", consumed);
+    }
+}
@@ -0,0 +1,75 @@
+#include "sugarpp/collection/collection.hpp"
+#include "sugarpp/range/range.hpp"
+#include "sugarpp/io/io.hpp"
+#include <list>
+#include <string>
+#include <vector>
+
+using namespace SugarPP;
+
+int main()
+{
+    {
+        /*HashMap*/
+        HashMap<std::string, int> ages{ { "Alice", 30 }, { "Bob", 25 } };
+        ages["Carol"] = 41;
+        ++ages["Bob"];
+        print(ages.size(), ages.at("Bob"), ages.contains("Dave"));    //3 26 False
+        ages.erase("Alice");
+        print(ages.size(), ages.count("Alice"));                    //2 0
+    }
+    {
+        /*Counter*/
+        std::vector<std::string> words{ "the", "cat", "and", "the", "hat", "the", "cat" };
+        Counter counter{ words };
+        print(counter.count("the"), counter.count("dog"), counter.size(), counter.total()); //3 0 4 7
+        auto const common = counter.mostCommon(2);
+        print(common[0].first, common[0].second, common[1].first, common[1].second);    //the 3 cat 2
+        counter.update(std::list<std::string>{ "dog", "dog" });
+        print(counter.count("dog"), counter.total());              //2 9
+
+        /*copy a Counter, and add the counts of another one*/
+        Counter<std::string> copy(counter);
+        copy.update(counter);
+        print(copy.count("the"), copy.count("dog"), copy.total());  //6 4 18
+    }
+    {
+        /*groupBy keeps the order of the elements inside a group*/
+        std::vector<std::string> words{ "one", "two", "three", "four", "five", "six" };
+        auto const byLength = groupBy(words, [](std::string const& word) { return word.size(); });
+        for (auto const& word : byLength.at(3))
+            print(word);                                            //one two six
+        auto const initials = groupBy(words, [](std::string const& word) { return word.size(); }, [](std::string const& word) { return word.front(); });
+        print(initials.at(4).size(), initials.at(4)[0], initials.at(4)[1]);  //2 f f
+    }
+    {
+        /*associateBy and associate keep the last element of a key*/
+        std::vector<std::pair<int, std::string>> users{ { 1, "ann" }, { 2, "bo" }, { 1, "cy" } };
+        auto const byId = associateBy(users, [](auto const& user) { return user.first; });
+        print(byId.size(), byId.at(1).second);                      //2 cy
+        auto const names = associate(users, [](auto const& user) { return std::pair{ user.second, user.first }; });
+        print(names.at("bo"), names.at("cy"));                      //2 1
+    }
+    {
+        /*in parallel, with the same results as sequentially*/
+        std::vector<int> v(2000000);
+        Range(0, 1000).fillRand(v);
+        Counter sequential{ v };
+        Counter parallel{ par, v };
+        auto same = sequential.size() == parallel.size();
+        for (auto const& [value, count] : sequential)
+            same = same && parallel.count(value) == count;
+        print("Counter matches:", same);                            //True
+
+        auto const mod = [](int i) { return i % 7; };
+        auto const groups = groupBy(v, mod);
+        auto const parallelGroups = groupBy(par, v, mod);
+        same = groups.size() == parallelGroups.size();
+        for (auto const& [key, group] : groups)
+            same = same && parallelGroups.at(key) == group;
+        print("groupBy matches:", same);                            //True
+
+        auto const last = associateBy(par, Range(0, 1000000), mod);
+        print(last.at(0), last.at(6));                              //999999 999998
+    }
+}
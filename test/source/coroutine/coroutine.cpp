@@ -0,0 +1,185 @@
+#include "sugarpp/coroutine/coroutine.hpp"
+#include "sugarpp/io/io.hpp"
+#include "sugarpp/range/range.hpp"
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <vector>
+
+using namespace SugarPP;
+using namespace std::chrono_literals;
+
+/*A suspending function*/
+Task<int> fetch(int id)
+{
+    co_await delay(1ms);
+    co_return id * 2;
+}
+
+int main()
+{
+    {
+        /*async & await*/
+        auto const result = runBlocking([]() -> Task<int>
+        {
+            auto first = async([] { return fetch(1); });
+            auto second = async([] { return fetch(2); });
+            co_return co_await first + co_await second;
+        });
+        print("Sum:", result);                                      //6
+    }
+    {
+        /*lots of lightweight coroutines, all of them sleeping at the same time*/
+        std::atomic<int> finished{ 0 };
+        runBlocking([&finished]() -> Task<>
+        {
+            for ([[maybe_unused]] auto i : Range(0, 10000))
+            {
+                launch([&finished]() -> Task<>
+                {
+                    co_await delay(10ms);
+                    ++finished;
+                });
+            }
+            co_return;  //runBlocking waits for all the children
+        });
+        print("Finished:", finished.load());                       //10000
+    }
+    {
+        /*cancellation*/
+        runBlocking([]() -> Task<>
+        {
+            auto job = launch([]() -> Task<>
+            {
+                try
+                {
+                    while (true)
+                        co_await delay(1ms);
+                }
+                catch (CancellationError const& e)
+                {
+                    print("Child:", e.what());
+                    throw;
+                }
+            });
+            co_await delay(5ms);
+            job.cancel();
+            co_await job.join();
+            print(job.isCancelled(), job.isCompleted());           //True True
+        });
+    }
+    {
+        /*timeout*/
+        runBlocking([]() -> Task<>
+        {
+            auto const fast = co_await withTimeout(1s, [] { return fetch(21); });
+            print("Fast:", fast);                                   //42
+            try
+            {
+                co_await withTimeout(10ms, []() -> Task<>
+                {
+                    co_await delay(10s);
+                });
+            }
+            catch (TimeoutCancellationError const& e)
+            {
+                print("Slow:", e.what());
+            }
+        });
+    }
+    {
+        /*a failed child cancels its siblings and its parent*/
+        try
+        {
+            runBlocking([]() -> Task<>
+            {
+                launch([]() -> Task<>
+                {
+                    co_await delay(10s);
+                });
+                launch([]() -> Task<>
+                {
+                    co_await delay(1ms);
+                    throw std::runtime_error{ "child error" };
+                });
+                co_return;
+            });
+        }
+        catch (std::runtime_error const& e)
+        {
+            print("Caught:", e.what());
+        }
+    }
+    {
+        /*suspend on a channel instead of blocking a thread*/
+        Channel<int> channel{ 4 };
+        auto const sum = runBlocking([&channel]() -> Task<int>
+        {
+            launch([&channel]() -> Task<>
+            {
+                for (auto i : Range(0, 100))
+                    co_await send(channel, i);
+                channel.close();
+            });
+            int sum = 0;
+            while (auto value = co_await receive(channel))
+                sum += *value;
+            co_return sum;
+        });
+        print("Channel sum:", sum);                                 //4950
+    }
+    {
+        /*many senders and receivers suspended on a small channel, woken up by each other*/
+        Channel<int> channel{ 2 };
+        std::atomic<int> sum{ 0 };
+        runBlocking([&channel, &sum]() -> Task<>
+        {
+            auto senders = launch([&channel]() -> Task<>
+            {
+                for (auto id : Range(0, 8))
+                {
+                    launch([&channel, id]() -> Task<>
+                    {
+                        for (auto i : Range(0, 100))
+                            co_await send(channel, id * 100 + i);
+                    });
+                }
+                co_return;
+            });
+            for ([[maybe_unused]] auto id : Range(0, 4))
+            {
+                launch([&channel, &sum]() -> Task<>
+                {
+                    while (auto value = co_await receive(channel))
+                        sum += *value;
+                });
+            }
+            co_await senders.join();
+            channel.close();
+        });
+        print("Channel sum:", sum.load());                          //319600
+    }
+    {
+        /*a receiver suspended on an empty channel can be cancelled*/
+        Channel<int> channel{ 4 };
+        runBlocking([&channel]() -> Task<>
+        {
+            auto job = launch([&channel]() -> Task<>
+            {
+                try
+                {
+                    co_await receive(channel);
+                }
+                catch (CancellationError const& e)
+                {
+                    print("Receiver:", e.what());
+                    throw;
+                }
+            });
+            co_await delay(5ms);
+            job.cancel();
+            co_await job.join();
+            print(job.isCancelled(), job.isCompleted());           //True True
+        });
+    }
+}
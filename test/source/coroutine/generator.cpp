@@ -0,0 +1,122 @@
+#include "sugarpp/coroutine/generator.hpp"
+#include "sugarpp/range/range.hpp"
+#include "sugarpp/range/enumerate.hpp"
+#include "sugarpp/range/zip.hpp"
+#include "sugarpp/io/io.hpp"
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace SugarPP;
+
+/*A generator yields by reference, so nothing is copied*/
+Generator<int> fibonacci(int count)
+{
+    int a = 0, b = 1;
+    for ([[maybe_unused]] auto i : Range(0, count))
+    {
+        co_yield a;
+        a = std::exchange(b, a + b);
+    }
+}
+
+/*Yielding a temporary is fine, it lives until the generator is resumed*/
+Generator<std::string const&> words()
+{
+    co_yield "cpp";
+    co_yield "sugar";
+    co_yield "sweet";
+}
+
+/*An iterable whose iterator returns a new std::string by value on every dereference*/
+struct Names
+{
+    struct iterator
+    {
+        int i;
+        std::string operator*() const { return "name number " + std::to_string(i); }
+        iterator& operator++() { ++i; return *this; }
+        bool operator!=(iterator const& rhs) const { return i != rhs.i; }
+    };
+    iterator begin() const { return { 0 }; }
+    iterator end() const { return { 3 }; }
+};
+
+Generator<int> throwing()
+{
+    co_yield 1;
+    throw std::runtime_error{ "generator error" };
+}
+
+int main()
+{
+    {
+        /*use a generator in range-based for loop*/
+        for (auto i : fibonacci(10))
+            print(i);
+    }
+    {
+        /*generator works with Enumerate*/
+        for (auto [index, word] : Enumerate(words()))
+            print(index, '\t', word);
+    }
+    {
+        /*generator works with Zip*/
+        std::vector<double> weights{ 0.5, 1.5, 2.5, 3.5 };
+        for (auto [fib, word, weight] : Zip(fibonacci(100), words(), weights))
+            print(fib, word, weight);
+    }
+    {
+        /*Zip works with a Range, whose end is a value instead of a Range*/
+        std::vector<std::string> names{ "cpp", "sugar", "sweet", "extra" };
+        for (auto [i, name] : Zip(Range(0, 3), names))
+            print(i, name);
+    }
+    {
+        /*elements returned by value are held by value, so they are still alive in the loop body*/
+        std::vector<int> numbers{ 1, 2, 3 };
+        for (auto [name, number, letter] : Zip(Names{}, numbers, Range('a', 'z')))
+            print(name, number, letter);
+        for (auto [index, name] : Enumerate(Names{}))
+            print(index, name);
+    }
+    {
+        /*yielded references can be modified*/
+        auto gen = fibonacci(5);
+        for (auto& i : gen)
+            i *= 10;
+    }
+    {
+        /*expose a MultiRange as a generator*/
+        for (auto [i, j] : asGenerator(Range(0, 2) | Range(0, 3)))
+            print(i, '\t', j);
+    }
+    {
+        /*expose a FileIterator as a generator, every line is yielded by reference to the same buffer*/
+        std::ofstream{ "generator.txt" } << "first line\nsecond line\n\nlast line";
+        for (auto [index, line] : Enumerate(asGenerator(FileIterator{ "generator.txt" }), 1))
+            print(index, line);
+    }
+    {
+        /*exceptions inside the generator are rethrown to the caller*/
+        try
+        {
+            for (auto i : throwing())
+                print(i);
+        }
+        catch (std::runtime_error const& e)
+        {
+            print("Caught:", e.what());
+        }
+    }
+    {
+        /*frames are recycled, so generating many small generators does not hit the heap every time*/
+        long long total = 0;
+        for ([[maybe_unused]] auto i : Range(0, 100000))
+        {
+            for (auto value : fibonacci(3))
+                total += value;
+        }
+        print("Total:", total);
+    }
+}
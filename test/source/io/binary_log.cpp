@@ -0,0 +1,91 @@
+#include "sugarpp/io/binaryLog.hpp"
+#include "sugarpp/range/parallel.hpp"
+#include "sugarpp/range/range.hpp"
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace SugarPP;
+
+int main()
+{
+    auto const path = (std::filesystem::temp_directory_path() / "sugarpp_binary_log.sppl").string();
+    {
+        BinaryLog binary{ path };
+
+        static LogSite<Level::Info> const read{ "read {} bytes from {}" };
+        static LogSite<Level::Warning> const values{ "values:" };
+        static LogSite<Level::Debug> const hidden{ "not logged at the default level" };
+        std::string const file{ "data.bin" };
+        binaryLog(read, 4096, file);
+        binaryLog(values, -1, 2.5, true, 'x', "text");
+        binaryLog(hidden);
+
+        static LogSite<Level::Info> const worker{ "item {}" };
+        parallel(Range(0, 10000), [](auto range)
+        {
+            for (auto i : range)
+                binaryLog(worker, i);
+        });
+
+        /*threads logging at the same time*/
+        std::vector<std::thread> threads;
+        for ([[maybe_unused]] auto t : Range(0, 4))
+        {
+            threads.emplace_back([]
+            {
+                for (auto i : Range(0, 5000))
+                    binaryLog(worker, i);
+            });
+        }
+        for (auto& thread : threads)
+            thread.join();
+    }
+
+    std::ifstream in{ path, std::ios::binary };
+    std::ostringstream text;
+    auto const count = decodeBinaryLog(in, text);
+    print(count);                                                      //30002
+
+    /*every line starts with the seconds since the log was opened*/
+    std::istringstream lines{ text.str() };
+    std::string line;
+    for (int i = 0; i < 2 && std::getline(lines, line); ++i)
+        std::cout << line.substr(line.find(' ') + 1) << '\n';           //[Info] read 4096 bytes from data.bin
+                                                                        //[Warning] values: -1 2.5 True x text
+
+    /*the records of all the threads are merged by their time*/
+    double previous = 0;
+    auto inOrder = true;
+    for (std::istringstream all{ text.str() }; std::getline(all, line);)
+    {
+        auto const time = std::stod(line.substr(0, line.find(' ')));
+        inOrder = inOrder && time >= previous;
+        previous = time;
+    }
+    print("In time order:", inOrder);                                  //True
+    in.close();
+
+    /*a corrupted file is reported instead of being decoded*/
+    {
+        std::ofstream corrupted{ path, std::ios::binary };
+        std::uint64_t const times[2]{};
+        std::uint8_t const site[]{ 1, 0, 0, 0, 0, 200 };            //site 0 with level 200
+        corrupted.write("SPPLOG1\n", 8).write(reinterpret_cast<char const*>(times), sizeof(times)).write(reinterpret_cast<char const*>(site), sizeof(site));
+    }
+    try
+    {
+        std::ifstream corrupted{ path, std::ios::binary };
+        decodeBinaryLog(corrupted, text);
+    }
+    catch (std::runtime_error const& e)
+    {
+        print(e.what());                                               //corrupted binary log: invalid level 200
+    }
+    std::filesystem::remove(path);
+}
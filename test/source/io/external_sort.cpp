@@ -0,0 +1,72 @@
+#include "sugarpp/io/externalSort.hpp"
+#include "sugarpp/io/file.hpp"
+#include "sugarpp/io/io.hpp"
+#include "sugarpp/io/search.hpp"
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace SugarPP;
+
+struct Trade
+{
+    std::uint32_t id;
+    float price;
+};
+
+int main()
+{
+    {
+        std::ofstream fs{ "external_sort.txt", std::ios::binary };
+        for (int i = 0; i < 200000; ++i)
+            fs << (i * 7919) % 200000 << " id" << i << '\n';
+        fs << "zz no new line";
+    }
+
+    /*a budget of 1 MB makes several runs to merge*/
+    external_sort("external_sort.txt", "external_sort_lines.txt", 1 << 20);
+    auto const sortedLines = file_to_string("external_sort_lines.txt");
+    print(sortedLines.substr(0, 15));                               //0 id0
+                                                                    //1 id17679
+    print(count_lines("external_sort_lines.txt"));               //200001
+
+    /*by a numeric key*/
+    external_sort("external_sort.txt", "external_sort_keys.txt", 1 << 20,
+        [](std::string_view line) { return line[0] == 'z' ? -1 : std::stoi(std::string{ line.substr(0, line.find(' ')) }); });
+    print(file_to_string("external_sort_keys.txt").substr(0, 30));   //zz no new line
+                                                                    //0 id0
+                                                                    //1 id17679
+
+    /*with short lines, the index of the lines and the scratch of sorting them cut the runs before their text does*/
+    {
+        std::ofstream fs{ "external_sort_short.txt", std::ios::binary };
+        for (int i = 0; i < 200000; ++i)
+            fs << static_cast<char>('z' - i % 26) << '\n';
+    }
+    {
+        ExternalSort_detail::TempFiles temps{ "external_sort_short_sorted.txt" };
+        Traits_detail::Identity identity;
+        auto const runs = ExternalSort_detail::makeRuns<std::string_view>("external_sort_short.txt", "external_sort_short_sorted.txt", 1 << 20, identity, ThreadPool::shared(), temps);
+        print(runs.size());                                         //7
+    }
+    external_sort("external_sort_short.txt", "external_sort_short_sorted.txt", 2 << 20);
+    auto const sortedShort = file_to_string("external_sort_short_sorted.txt");
+    print(sortedShort.size(), sortedShort.front(), sortedShort[sortedShort.size() - 2]);   //400000 a z
+
+    /*fixed-size records, with a comparator*/
+    {
+        std::ofstream fs{ "external_sort.bin", std::ios::binary };
+        for (std::uint32_t i = 0; i < 300000; ++i)
+        {
+            Trade const trade{ i, static_cast<float>((i * 7919) % 1000) / 10 };
+            fs.write(reinterpret_cast<char const*>(&trade), sizeof(trade));
+        }
+    }
+    external_sort<Trade>("external_sort.bin", "external_sort_trades.bin", 1 << 20,
+        [](Trade const& lhs, Trade const& rhs) { return lhs.price > rhs.price; });
+    std::vector<Trade> trades(300000);
+    std::ifstream{ "external_sort_trades.bin", std::ios::binary }.read(reinterpret_cast<char*>(trades.data()), trades.size() * sizeof(Trade));
+    print(trades.size(), trades.front().price, trades.back().price);   //300000 99.9 0
+}
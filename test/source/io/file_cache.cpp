@@ -0,0 +1,40 @@
+#include "sugarpp/io/fileCache.hpp"
+#include "sugarpp/io/io.hpp"
+#include <fstream>
+#include <string>
+
+using namespace SugarPP;
+
+int main()
+{
+    {
+        std::ofstream{ "file_cache_a.txt" } << "template A";
+        std::ofstream{ "file_cache_b.txt" } << std::string(600, 'b');
+    }
+
+    FileCache cache{ 1000 };
+    auto const first = cache.get("file_cache_a.txt");
+    auto const second = cache.get("file_cache_a.txt");
+    print(*first, first == second);                         //template A True
+
+    /*a modified file is read again, and the old content stays valid*/
+    std::ofstream{ "file_cache_a.txt" } << "template A, edited";
+    auto const edited = cache.get("file_cache_a.txt");
+    print(*edited, *first);                                 //template A, edited template A
+
+    /*over the budget, the least recently used file is evicted*/
+    std::ofstream{ "file_cache_c.txt" } << std::string(500, 'c');
+    (void)cache.get("file_cache_b.txt");
+    (void)cache.get("file_cache_c.txt");
+    auto const stats = cache.stats();
+    print(stats.hits, stats.misses, stats.entries, stats.bytes);    //1 4 1 500
+
+    try
+    {
+        (void)cache.get("does/not/exist.txt");
+    }
+    catch (FileIOError const& e)
+    {
+        print(e.what());
+    }
+}
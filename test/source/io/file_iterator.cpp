@@ -0,0 +1,75 @@
+#include "sugarpp/io/io.hpp"
+#include "sugarpp/range/enumerate.hpp"
+#include <fstream>
+#include <string>
+
+using namespace SugarPP;
+
+int main()
+{
+    {
+        std::ofstream fs{ "file_iterator.txt" };
+        fs << "SugarPP\nsyntactic sugar\n\nfor C++";
+    }
+
+    /*read a file line by line*/
+    for (auto const& line : FileIterator{ "file_iterator.txt" })
+        print(line);
+
+    /*works with Enumerate*/
+    for (auto [index, line] : Enumerate(FileIterator{ std::string{ "file_iterator.txt" } }))
+        print(index, line);
+
+    /*lines longer than a block are joined correctly*/
+    {
+        std::ofstream fs{ "file_iterator_long.txt" };
+        fs << std::string(FileIterator<>::BlockSize * 2 + 10, 'x') << '\n' << "short";
+    }
+    for (auto const& line : FileIterator{ "file_iterator_long.txt" })
+        print(line.size());
+
+    /*read ahead on a background thread*/
+    {
+        std::ofstream fs{ "file_iterator_many.txt" };
+        for (int i = 0; i < 100000; ++i)
+            fs << i << '\n';
+    }
+    long long sum = 0;
+    for (auto const& line : FileIterator{ "file_iterator_many.txt", ReadAhead{ 3 } })
+        sum += std::stoll(line);
+    print(sum);                                         //4999950000
+    for (auto const& line : FileIterator{ "file_iterator_long.txt", ReadAhead{ 1 } })
+        print(line.size());                             //131082    5
+
+    /*read around the page cache, or with buffered reads dropped from it where O_DIRECT is not supported*/
+    sum = 0;
+    for (auto const& line : DirectReader{ "file_iterator_many.txt", 4096 })
+        sum += std::stoll(line);
+    print(sum);                                         //4999950000
+    {
+        DirectReader reader{ "file_iterator_long.txt" };
+        size_t size = 0;
+        for (auto chunk = reader.nextChunk(); !chunk.empty(); chunk = reader.nextChunk())
+            size += chunk.size();
+        print(size);                                    //131088
+    }
+    {
+        /*the reads complete out of order, but the chunks come in order, and the short read at the end is not an O_DIRECT failure*/
+        DirectReader reader{ "file_iterator_many.txt", 4096, 8 };
+        std::string content;
+        for (auto chunk = reader.nextChunk(); !chunk.empty(); chunk = reader.nextChunk())
+            content += chunk;
+        auto const direct = reader.direct();
+        print(content == file_to_string("file_iterator_many.txt"), reader.nextChunk().empty(), reader.direct() == direct);    //True True True
+    }
+
+    /*throws FileIOError when the file can't be opened*/
+    try
+    {
+        FileIterator file{ "does/not/exist.txt" };
+    }
+    catch (FileIOError const& e)
+    {
+        print(e.what());
+    }
+}
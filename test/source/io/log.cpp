@@ -0,0 +1,39 @@
+#include "sugarpp/io/log.hpp"
+#include "sugarpp/range/parallel.hpp"
+#include "sugarpp/range/range.hpp"
+#include <iostream>
+#include <string>
+
+using namespace SugarPP;
+
+int main()
+{
+    {
+        /*the level is checked before anything is formatted*/
+        int formatted = 0;
+        auto const expensive = [&formatted] { ++formatted; return std::string{ "expensive" }; };
+        log<Level::Info, std::cout>("info is logged by default", 42);      //[Info] info is logged by default 42
+        log<Level::Debug, std::cout>("debug is not", expensive);
+        print(formatted);                                                   //0
+
+        setLogLevel(Level::Debug);
+        log<Level::Debug, std::cout>("now it is", expensive);              //[Debug] now it is expensive
+        print(formatted, logEnabled<Level::Trace>());                      //1 False
+        setLogLevel(Level::Warning);
+        log<Level::Error, std::cout>("errors are always logged");          //[Error] errors are always logged
+    }
+    {
+        /*sampling and rate limiting*/
+        setLogLevel(Level::Info);
+        static LogEvery every{ 400 };
+        parallel(Range(0, 1000), [](auto range)
+        {
+            for ([[maybe_unused]] auto i : range)
+                log<Level::Info, std::cout>(every, "sampled");             //3 times
+        });
+
+        static LogRate rate{ 1.0, 2 };
+        for (int i = 0; i < 100; ++i)
+            log<Level::Info, std::cout>(rate, "limited", i);               //[Info] limited 0   [Info] limited 1
+    }
+}
@@ -0,0 +1,42 @@
+#include "sugarpp/io/file.hpp"
+#include "sugarpp/io/io.hpp"
+#include "sugarpp/io/mappedWriter.hpp"
+#include <cstdint>
+#include <limits>
+#include <string>
+
+using namespace SugarPP;
+
+int main()
+{
+    {
+        /*starts with 16 bytes, and grows while writing*/
+        MappedWriter report{ "mapped_writer.txt", 16 };
+        report.print("total", 42, 2.5, true, 'x');
+        report.print<','>(1, -2, 1e20, std::string{ "csv" });
+        for (int i = 0; i < 10000; ++i)
+            report.print(i);
+        report.write("end");
+        print(report.size());                                   //48928
+    }
+
+    /*the file is truncated to what was written*/
+    auto const text = file_to_string("mapped_writer.txt");
+    print(text.size(), text.substr(0, text.find("0\n")));       //48928 total 42 2.5 True x
+                                                                //1,-2,1e+20,csv
+    print(text.substr(text.size() - 8));                        //9999
+                                                                //end
+
+    /*small character types are written as characters, like print, and the widest integers fit*/
+    {
+        MappedWriter report{ "mapped_writer.txt", 16 };
+        report.print(std::int8_t{ 'a' }, static_cast<unsigned char>('b'), static_cast<signed char>('c'));
+        report.print((std::numeric_limits<long long>::min)(), (std::numeric_limits<unsigned long long>::max)());
+        auto const expected = std::string{ "a b c\n" }.size()
+            + std::to_string((std::numeric_limits<long long>::min)()).size() + 1
+            + std::to_string((std::numeric_limits<unsigned long long>::max)()).size() + 1;
+        print(report.size() == expected);                       //True
+    }
+    print(file_to_string("mapped_writer.txt"));                 //a b c
+                                                                //-9223372036854775808 18446744073709551615
+}
@@ -0,0 +1,47 @@
+#include "sugarpp/io/io.hpp"
+#include "sugarpp/io/scan.hpp"
+#include <sstream>
+#include <string>
+#include <string_view>
+
+using namespace SugarPP;
+
+int main()
+{
+    /*a record in one pass*/
+    if (auto const fields = scan<int, double, std::string_view>("42 3.5 apple", "{} {} {}"))
+    {
+        auto const [id, price, name] = *fields;
+        print(id, price, name);                                     //42 3.5 apple
+    }
+
+    /*text fields end at the next literal of the pattern, or at the end of the line*/
+    auto const [key, value] = *scan<std::string, std::string_view>("path = /tmp/my file  ", "{} = {}");
+    print(key + '|' + std::string{ value } + '|');                  //path|/tmp/my file|
+    auto const [x, y, flag, grade] = *scan<int, unsigned, bool, char>("(-3,  7) true B", "({}, {}) {} {}");
+    print(x, y, flag, grade);                                       //-3 7 True B
+    auto const [user, count] = *scan<std::string_view, long long>("{alice}:12", "{{{}}}:{}");
+    print(user, count);                                             //alice 12
+
+    /*a line which does not match gives nullopt*/
+    print(scan<int, int>("1,x", "{},{}").has_value(), scan<int>("12 extra", "{}").has_value());     //False False
+
+    /*a pattern without one {} per type throws in C++17, and does not compile in C++20*/
+#ifndef __cpp_consteval
+    try
+    {
+        (void)scan<int, int>("1 2", "{}");
+    }
+    catch (std::invalid_argument const&)
+    {
+        print("invalid pattern");                                   //invalid pattern
+    }
+#endif
+
+    /*read lines until one does not match*/
+    std::istringstream input{ "1,2\n3,4\nend\n" };
+    int sum = 0;
+    while (auto const point = input_line<int, int>("{},{}", input))
+        sum += std::get<0>(*point) * std::get<1>(*point);
+    print(sum);                                                     //14
+}
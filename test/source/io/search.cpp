@@ -0,0 +1,43 @@
+#include "sugarpp/io/io.hpp"
+#include "sugarpp/io/search.hpp"
+#include "sugarpp/thread/threadPool.hpp"
+#include <fstream>
+
+using namespace SugarPP;
+
+int main()
+{
+    {
+        std::ofstream fs{ "search.txt", std::ios::binary };
+        fs << "error: disk full\nok\nerror: errorerror\n";
+        /*large enough to be searched in several parts*/
+        for (int i = 0; i < 300000; ++i)
+            fs << "line " << i << " of the log\n";
+        fs << "last error";
+    }
+
+    print(count_lines("search.txt"));                           //300004
+
+    auto const errors = find_all("search.txt", "error");
+    print(errors.size());                                       //5
+    for (auto const [offset, line] : errors)
+        print(offset, line);                                    //0 1
+                                                                //20 3
+                                                                //27 3
+                                                                //32 3
+                                                                //6788933 300004
+
+    /*overlapping matches, and a single character*/
+    ThreadPool pool{ 3 };
+    print(find_all("search.txt", "rr", pool).size(), find_all("search.txt", ":").size());   //5 2
+    print(find_all("search.txt", "line 299999 ").front().line); //300003
+
+    try
+    {
+        (void)find_all("search.txt", "");
+    }
+    catch (std::invalid_argument const&)
+    {
+        print("empty needle");                                  //empty needle
+    }
+}
@@ -0,0 +1,77 @@
+#include "sugarpp/io/io.hpp"
+#include "sugarpp/io/walk.hpp"
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace SugarPP;
+
+int main()
+{
+    /*a tree of 10 directories with 3 subdirectories, each with 5 files*/
+    auto const root = std::filesystem::temp_directory_path() / "sugarpp_walk";
+    std::filesystem::remove_all(root);
+    for (int i = 0; i < 10; ++i)
+    {
+        for (int j = 0; j < 3; ++j)
+        {
+            auto const directory = root / ("dir" + std::to_string(i)) / ("sub" + std::to_string(j));
+            std::filesystem::create_directories(directory);
+            for (int k = 0; k < 5; ++k)
+                std::ofstream{ directory / ("file" + std::to_string(k) + (k == 0 ? ".cpp" : ".txt")) } << k;
+        }
+    }
+
+    /*every entry*/
+    std::atomic<int> files{ 0 }, directories{ 0 };
+    walk(root, [&](WalkEntry const& entry)
+    {
+        if (entry.isFile())
+            ++files;
+        else if (entry.isDirectory())
+            ++directories;
+    });
+    print(files.load(), directories.load());                //150 40
+
+    /*a filter selecting files, which prunes dir0*/
+    std::mutex mutex;
+    std::vector<std::string> sources;
+    walk(root, [&](WalkEntry const& entry)
+    {
+        if (entry.isFile())
+        {
+            std::lock_guard lock{ mutex };
+            sources.push_back(entry.path.filename().string());
+        }
+    }, [](WalkEntry const& entry)
+    {
+        return entry.isDirectory() ? entry.path.filename() != "dir0" : entry.path.extension() == ".cpp";
+    });
+    print(sources.size(), sources.front());                 //27 file0.cpp
+
+    /*stream the entries through a channel*/
+    Channel<WalkEntry> entries{ 16 };
+    std::thread walker{ [&] { walk(root, entries); } };
+    int received = 0;
+    while (auto entry = entries.receive())
+        ++received;
+    walker.join();
+    print(received);                                        //190
+
+    /*exceptions of the callback are rethrown*/
+    try
+    {
+        walk(root, [](WalkEntry const&) { throw std::runtime_error{ "stop" }; });
+    }
+    catch (std::runtime_error const& e)
+    {
+        print(e.what());                                    //stop
+    }
+
+    std::filesystem::remove_all(root);
+}
@@ -0,0 +1,50 @@
+#include "sugarpp/io/file.hpp"
+#include "sugarpp/io/io.hpp"
+#include "sugarpp/memory/allocator.hpp"
+#include "sugarpp/range/range.hpp"
+#include <cstdint>
+#include <fstream>
+#include <list>
+#include <numeric>
+#include <vector>
+
+using namespace SugarPP;
+
+template<typename T>
+bool alignedTo(T const* pointer, std::uintptr_t alignment)
+{
+    return reinterpret_cast<std::uintptr_t>(pointer) % alignment == 0;
+}
+
+int main()
+{
+    /*aligned to 64 bytes by default*/
+    std::vector<float, AlignedAllocator<float>> samples(1000, 1.5f);
+    std::vector<char, AlignedAllocator<char, 4096>> page(10);
+    print(alignedTo(samples.data(), 64), alignedTo(page.data(), 4096), std::accumulate(samples.begin(), samples.end(), 0.0f)); //True True 1500
+
+    /*rebound by node based containers*/
+    std::list<int, AlignedAllocator<int, 128>> list{ 1, 2, 3 };
+    print(list.size(), list.back());                                //3 3
+
+    /*a large vector is mapped in huge pages, and the small ones come from the heap*/
+    std::vector<std::uint64_t, HugePageAllocator<std::uint64_t>> table(1 << 20);
+    std::iota(table.begin(), table.end(), 0);
+    print(alignedTo(table.data(), 2 << 20), table.back());          //True 1048575
+    table.resize(3 << 20);
+    print(table[1 << 20], table[5]);                                //0 5
+    std::vector<int, HugePageAllocator<int, HugePages::Reserved>> small{ 1, 2, 3 }, large(1 << 20, 7);
+    print(small.back(), large.back());                              //3 7
+
+    /*allocator overloads*/
+    {
+        std::ofstream fs{ "allocator.bin", std::ios::binary };
+        fs << std::string(3 << 20, 'x') << "end";
+    }
+    auto const content = file_to_vec("allocator.bin", HugePageAllocator<char>{});
+    print(content.size(), alignedTo(content.data(), 2 << 20), std::string(content.end() - 3, content.end()));   //3145731 True end
+    print(file_to_vec("missing.bin", AlignedAllocator<char>{}).size());                                         //0
+
+    auto const numbers = Range(0, 10).rand(1 << 20, HugePageAllocator<int>{});
+    print(numbers.size(), alignedTo(numbers.data(), 2 << 20), *std::max_element(numbers.begin(), numbers.end()) < 10); //1048576 True True
+}
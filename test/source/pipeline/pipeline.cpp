@@ -0,0 +1,90 @@
+#include "sugarpp/pipeline/pipeline.hpp"
+#include "sugarpp/io/io.hpp"
+#include "sugarpp/range/range.hpp"
+#include <fstream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace SugarPP;
+
+int main()
+{
+    {
+        std::ofstream file{ "pipeline.txt" };
+        for (auto i : Range(0, 10000))
+            file << i << '\n';
+    }
+    {
+        /*parse in parallel, filter, and collect in the original order*/
+        std::vector<int> collected;
+        pipeline(FileIterator{ "pipeline.txt" }, 64)
+            | stage([](std::string line) { return std::stoi(line); }, 4)
+            | stage([](int value) { return value % 3 == 0 ? std::optional{ value * 2 } : std::nullopt; }, 2)
+            | sink([&collected](int value) { collected.push_back(value); });
+        auto ordered = true;
+        for (std::size_t i = 0; i < collected.size(); ++i)
+            ordered = ordered && collected[i] == static_cast<int>(i) * 6;
+        print("Collected:", collected.size(), "ordered:", ordered);         //Collected: 3334 ordered: True
+    }
+    {
+        /*unordered, with a parallel sink*/
+        std::atomic<long long> sum{ 0 };
+        std::vector<int> numbers(100000);
+        Range(0, 100).fillRand(numbers);
+        long long expected = 0;
+        for (auto i : numbers)
+            expected += i;
+        pipeline(numbers, 1000, PipelineOrder::Any)
+            | sink([&sum](int value) { sum += value; }, 4);
+        print("Sum matches:", sum.load() == expected);                       //True
+    }
+    {
+        /*read from a channel and write to a file*/
+        Channel<int> channel{ 16 };
+        std::thread producer{ [&channel]
+        {
+            for (auto i : Range(0, 100))
+                channel.send(i);
+            channel.close();
+        } };
+        pipeline(channel, 8)
+            | stage([](int value) { return "line " + std::to_string(value); }, 2)
+            | fileSink("pipeline_out.txt");
+        producer.join();
+        auto lines = 0;
+        std::string last;
+        for (auto const& line : FileIterator{ "pipeline_out.txt" })
+        {
+            ++lines;
+            last = line;
+        }
+        print(lines, last);                                                  //100 line 99
+    }
+    {
+        /*the first exception stops the pipeline*/
+        try
+        {
+            pipeline(Range(0, 1000), 10)
+                | stage([](int value)
+                {
+                    if (value == 500)
+                        throw std::runtime_error{ "bad value" };
+                    return value;
+                }, 3)
+                | sink([](int) {});
+        }
+        catch (std::runtime_error const& e)
+        {
+            print("Caught:", e.what());
+        }
+    }
+    {
+        /*print the items*/
+        pipeline(std::vector<std::string>{ "sugar", "for", "c++" })
+            | stage([](std::string word) { return word + "!"; })
+            | printSink();
+    }
+}
@@ -62,6 +62,13 @@ int main()
             }
         );
     }
+    {
+        /*parallel search stops early, and still finds the first match*/
+        auto const first = parallel_find_if(Range(0ll, 1ll << 40), [](long long i) { return i % 1000003 == 999999 && i > 5000000; });
+        print(first.value());                                   //5000011
+        print(parallel_find_if(Range(0, 1000), [](int i) { return i > 1000; }).has_value());   //False
+        print(parallel_any_of(Range(0.0, 1.0, 0.001), [](double x) { return x > 0.5; }));     //True
+    }
     {
         /*in<Container> still works*/
         std::array arr{ 1,2,3,4, 5,6 };
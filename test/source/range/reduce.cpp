@@ -0,0 +1,78 @@
+#include "sugarpp/range/reduce.hpp"
+#include "sugarpp/range/range.hpp"
+#include "sugarpp/io/io.hpp"
+#include <array>
+#include <list>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace SugarPP;
+
+int main()
+{
+    {
+        /*sum, min, max of a container*/
+        std::vector v{ 3, 1, 4, 1, 5, 9, 2, 6 };
+        print(sum(v), min(v), max(v));                         //31 1 9
+        auto [low, high] = minmax(v);
+        print(low, high);                                       //1 9
+        print(any(v), all(v), all(std::array{ 1, 0, 2 }));      //True True False
+        print(any(v, [](int i) { return i > 8; }));             //True
+    }
+    {
+        /*an integer Range is summed in O(1)*/
+        print(sum(Range(0, 100)));                              //4950
+        print(sum(Range(0ll, 1000000000ll)));                   //499999999500000000
+        print(sum(Range(1, 10, 3)), min(Range(1, 10, 3)), max(Range(1, 10, 3)));  //12 1 7
+
+        /*a floating Range gives the values of a loop over it, whose steps add up with rounding errors*/
+        double loopSum = 0, loopMax = 0;
+        int loopCount = 0;
+        for (auto value : Range(0.0, 1.0, 0.1))
+        {
+            loopSum += value;
+            loopMax = value;
+            ++loopCount;
+        }
+        print(loopCount, sum(Range(0.0, 1.0, 0.1)) == loopSum, max(Range(0.0, 1.0, 0.1)) == loopMax, min(Range(0.0, 1.0, 0.1)));   //11 True True 0
+    }
+    {
+        /*start sets the type of the result*/
+        std::vector<char> letters(1000, 'z');
+        print(sum(letters));                                    //122000
+        std::vector v{ 0.5, 0.25 };
+        print(sum(v, 1));                                       //1.75
+        print(sum(std::list<std::string>{ "sugar", "p", "p" }, std::string{}));  //sugarpp
+    }
+    {
+        /*floating point summation*/
+        std::vector<float> v(10000000, 0.1f);
+        print("Fast:", sum(v, 0.0f), "Pairwise:", sum(v, Summation::Pairwise), "Kahan:", sum(v, Summation::Kahan));
+    }
+    {
+        /*in parallel*/
+        std::vector<long long> v(5000000);
+        Range(-1000000, 1000000).fillRand(v);
+        v[1234567] = 5000000;
+        print("sum matches:", sum(par, v) == sum(v));            //True
+        print(max(par, v), min(par, v) == min(v));              //5000000 True
+        std::vector<double> zeros(5000000);
+        print(any(par, zeros), all(par, zeros));                //False False
+        zeros.back() = 1;
+        print(any(par, zeros));                                 //True
+    }
+    {
+        /*empty sequences*/
+        std::vector<int> empty;
+        print(sum(empty), all(empty), any(empty), max(empty, -1));   //0 True False -1
+        try
+        {
+            min(empty);
+        }
+        catch (std::invalid_argument const& e)
+        {
+            print(e.what());                                    //min() arg is an empty sequence
+        }
+    }
+}
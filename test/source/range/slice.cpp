@@ -0,0 +1,71 @@
+#include "sugarpp/range/slice.hpp"
+#include "sugarpp/range/enumerate.hpp"
+#include "sugarpp/range/parallel.hpp"
+#include "sugarpp/range/range.hpp"
+#include "sugarpp/range/reduce.hpp"
+#include "sugarpp/range/sort.hpp"
+#include "sugarpp/io/io.hpp"
+#include <deque>
+#include <string>
+#include <vector>
+
+using namespace SugarPP;
+
+int main()
+{
+    {
+        /*Python semantics*/
+        std::vector v{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+        for (auto i : slice(v, 2, 5))
+            print(i);                                               //2 3 4
+        for (auto i : slice(v, -3, std::nullopt))
+            print(i);                                               //7 8 9
+        for (auto i : slice(v, std::nullopt, std::nullopt, -3))
+            print(i);                                               //9 6 3 0
+        for (auto i : slice(v, 8, 1, -2))
+            print(i);                                               //8 6 4 2
+        print(slice(v, 5, 100).size(), slice(v, 7, 2).size());      //5 0
+    }
+    {
+        /*strings give string views*/
+        std::string const s{ "Hello, SugarPP" };
+        std::string_view hello = slice(s, 0, 5);
+        print(hello, slice(s, -7, std::nullopt));                   //Hello SugarPP
+        auto reversed = slice(s, std::nullopt, std::nullopt, -1);
+        print(std::string(reversed.begin(), reversed.end()));       //PPraguS ,olleH
+    }
+    {
+        /*views write through to the container*/
+        std::vector v{ 5, 4, 3, 2, 1, 0 };
+        auto evens = slice(v, std::nullopt, std::nullopt, 2);
+        for (auto& i : evens)
+            i *= 10;
+        sort(slice(v, 1, std::nullopt));
+        for (auto i : v)
+            print(i);                                               //50 0 2 4 10 30
+        std::deque<int> d{ 1, 2, 3, 4 };
+        slice(d, 1, 3)[0] = 20;
+        print(d[1]);                                                //20
+    }
+    {
+        /*with the rest of SugarPP*/
+        std::vector<long long> v(1000000);
+        Range(0, 1000).fillRand(v);
+        auto middle = slice(v, 1000, -1000);                        //a Span, summed by the SIMD kernel
+        print(sum(middle) == sum(par, middle), max(middle) < 1000); //True True
+        print(sum(slice(v, std::nullopt, std::nullopt, 2)) + sum(slice(v, 1, std::nullopt, 2)) == sum(v));   //True
+
+        std::vector<int> ints(100, 1);
+        auto odd = slice(ints, 1, std::nullopt, 2);
+        Range(0, 10).fillRand(odd);
+        parallel(Range(size_t{ 0 }, odd.size()), [&odd](auto range)
+        {
+            for (auto i : range)
+                odd[i] = -1;
+        });
+        print(sum(ints));                                           //0
+
+        for (auto [i, value] : Enumerate(slice(ints, -2, std::nullopt)))
+            print(i, value);                                        //0 1   1 -1
+    }
+}
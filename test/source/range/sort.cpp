@@ -0,0 +1,53 @@
+#include "sugarpp/range/sort.hpp"
+#include "sugarpp/range/range.hpp"
+#include "sugarpp/io/io.hpp"
+#include <algorithm>
+#include <deque>
+#include <string>
+#include <vector>
+
+using namespace SugarPP;
+
+int main()
+{
+    {
+        /*sorted returns a sorted std::vector of any iterable*/
+        print(sorted(std::vector{ 3, -1, 4, -1, 5, -9, 2, 6 }));               //[-9 -1 -1 2 3 4 5 6]
+        print(sorted(std::deque{ 2.5, -0.5, 1.0 }));                            //[-0.5 1 2.5]
+        print(sorted(std::vector<std::string>{ "sugar", "for", "c++" }));      //[c++ for sugar]
+    }
+    {
+        /*key functions like Python, comparators like C++*/
+        std::vector<std::string> words{ "banana", "fig", "apple", "kiwi" };
+        print(sorted(words, [](std::string const& word) { return word.size(); }));                    //[fig kiwi apple banana]
+        print(sorted(words, [](std::string const& lhs, std::string const& rhs) { return lhs > rhs; })); //[kiwi fig banana apple]
+    }
+    {
+        /*sort in place, in parallel*/
+        std::vector<long long> v(3000000);
+        Range(-1000000000ll, 1000000000ll).fillRand(v);
+        auto expected = v;
+        std::sort(expected.begin(), expected.end());
+        sort(par, v);
+        print("Radix sorted:", v == expected);                                 //True
+
+        std::vector<std::string> names(200000);
+        for (auto& name : names)
+            name = std::to_string(Range(0, 1000000).rand());
+        auto expectedNames = names;
+        std::stable_sort(expectedNames.begin(), expectedNames.end());
+        sort(par, names, [](std::string const& lhs, std::string const& rhs) { return lhs < rhs; }, Stability::Unstable);
+        print("Merge sorted:", names == expectedNames);                       //True
+    }
+    {
+        /*sorting by a key is stable*/
+        struct Student
+        {
+            std::string name;
+            int grade;
+        };
+        std::vector<Student> students{ { "Ann", 90 }, { "Bob", 85 }, { "Cid", 90 }, { "Dan", 85 } };
+        for (auto const& [name, grade] : sorted(students, [](Student const& student) { return -student.grade; }))
+            print(name, grade);                                                 //Ann 90, Cid 90, Bob 85, Dan 85
+    }
+}
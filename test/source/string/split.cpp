@@ -0,0 +1,45 @@
+#include "sugarpp/string/split.hpp"
+#include "sugarpp/io/io.hpp"
+#include <list>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace SugarPP;
+
+int main()
+{
+    {
+        /*split on a character, lazily*/
+        std::string const line{ "id,name,,score" };
+        for (auto field : split(line, ','))
+            print("[", field, "]");                             //[ id ] [ name ] [ ] [ score ]
+        std::vector<std::string_view> fields = split(line, ',');
+        print(fields.size(), fields[3]);                        //4 score
+    }
+    {
+        /*split on a string, or on runs of whitespace*/
+        std::vector<std::string_view> items = split("apple, banana, cherry", ", ");
+        print(items.size(), items[1]);                          //3 banana
+        std::vector<std::string> words = split("  sugar \t pp\n");
+        print(words.size(), words[0], words[1]);                //2 sugar pp
+        print(split("").toVector().size(), split("", ',').toVector().size());  //0 1
+    }
+    {
+        /*a long line goes through the SIMD path*/
+        std::string line;
+        for (int i = 0; i < 100; ++i)
+            line += std::to_string(i) + "::";
+        std::vector<std::string_view> numbers = split(line, "::");
+        print(numbers.size(), numbers[42], numbers.back().empty()); //101 42 True
+        print(join(numbers, "::") == line);                     //True
+    }
+    {
+        /*join*/
+        std::vector<std::string> v{ "a", "b", "c" };
+        print(join(v, ", "));                                   //a, b, c
+        print(join(std::list<char const*>{ "x", "y" }, '-'));  //x-y
+        print(join(split("1 2 3"), "+"));                       //1+2+3
+        print(join(std::vector<std::string>{}, ",").empty());  //True
+    }
+}
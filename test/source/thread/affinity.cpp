@@ -0,0 +1,48 @@
+#include "sugarpp/range/parallel.hpp"
+#include "sugarpp/thread/threadPool.hpp"
+#include "sugarpp/thread/topology.hpp"
+#include "sugarpp/io/io.hpp"
+#include <numeric>
+
+using namespace SugarPP;
+
+int main()
+{
+    {
+        /*the CPUs this process may run on*/
+        auto const& topology = CpuTopology::system();
+        print("NUMA nodes:", topology.nodeCount, "CPUs:", topology.cpus.size());
+        for (auto const& cpu : topology.cpus)
+            print("cpu", cpu.id, "node", cpu.node, "core", cpu.core);
+    }
+    for (auto affinity : { ThreadAffinity::Compact, ThreadAffinity::Scatter })
+    {
+        /*pin the workers, then initialize and process the memory with the same partitioning*/
+        ThreadPool pool{ 4, affinity };
+        for (auto worker : Range(0u, pool.size()))
+            print("worker", worker, "is on node", pool.nodeOf(worker));
+
+        constexpr size_t count = 1 << 22;
+        auto data = makeFirstTouched(pool, count, 1ll);
+        auto const sums = parallel(Range(size_t{ 0 }, count), [&data](auto range)
+        {
+            long long sum = 0;
+            for (auto i : range)
+                sum += data[i];
+            return sum;
+        }, pool);
+        print("Sum:", std::accumulate(sums.begin(), sums.end(), 0ll));    //4194304
+    }
+    {
+        /*an unpinned pool works the same*/
+        ThreadPool pool{ 3 };
+        auto data = makeFirstTouched(pool, 10, 2);
+        parallel(Range(0, 10), [&data](auto range)
+        {
+            for (auto i : range)
+                data[i] *= i;
+        }, pool);
+        for (auto i : Range(0, 10))
+            print(data[i]);
+    }
+}
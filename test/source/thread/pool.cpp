@@ -0,0 +1,92 @@
+#include "sugarpp/thread/pool.hpp"
+#include "sugarpp/range/parallel.hpp"
+#include "sugarpp/range/range.hpp"
+#include "sugarpp/io/io.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace SugarPP;
+
+struct Counted
+{
+    static inline std::atomic<int> alive{ 0 };
+    Counted() { ++alive; }
+    Counted(Counted const&) { ++alive; }
+    ~Counted() { --alive; }
+};
+
+int main()
+{
+    {
+        /*objects are reused instead of created again*/
+        int created = 0;
+        Pool<std::string> strings{ [&created] { ++created; return std::string(100, 'x'); }, [](std::string& s) { s.clear(); } };
+        for (int i = 0; i < 10; ++i)
+        {
+            auto s = strings.acquire();
+            *s += "SugarPP";
+        }
+        auto const first = strings.acquire();
+        auto const second = strings.acquire();
+        print(created, first->empty(), second->size());             //2 True 100, the first one was cleared when released
+    }
+    {
+        /*from the workers of parallel, each reusing its own objects*/
+        std::atomic<int> created{ 0 };
+        Pool<std::mt19937> engines{ [&created] { ++created; return std::mt19937{ std::random_device{}() }; } };
+        parallel(Range(0, 100000), [&engines](auto range)
+        {
+            for (auto i : range)
+            {
+                auto engine = engines.acquire();
+                (void)(*engine)();
+                (void)i;
+            }
+        });
+        print(created <= static_cast<int>(std::thread::hardware_concurrency()) + 1);  //True
+    }
+    {
+        /*released on another thread than the one which acquired it*/
+        Pool<std::vector<int>> vectors;
+        auto handle = vectors.acquire();
+        handle->push_back(42);
+        std::thread{ [handle = std::move(handle)]() mutable { handle.reset(); } }.join();
+        print(static_cast<bool>(vectors.acquire()));                //True
+    }
+    {
+        /*the objects cached by a thread still running are deleted with the pool*/
+        std::mutex mutex;
+        std::condition_variable cv;
+        bool used = false, destroyed = false;
+        auto counted = std::make_unique<Pool<Counted>>();
+        std::thread worker{ [&]
+        {
+            {
+                auto first = counted->acquire();
+                auto second = counted->acquire();
+            }
+            std::unique_lock lock{ mutex };
+            used = true;
+            cv.notify_one();
+            cv.wait(lock, [&] { return destroyed; });
+        } };
+        {
+            std::unique_lock lock{ mutex };
+            cv.wait(lock, [&] { return used; });
+        }
+        auto const cached = Counted::alive.load();
+        counted.reset();
+        print(cached, Counted::alive.load());                       //2 0
+        {
+            std::lock_guard lock{ mutex };
+            destroyed = true;
+        }
+        cv.notify_one();
+        worker.join();
+    }
+}
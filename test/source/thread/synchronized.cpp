@@ -0,0 +1,64 @@
+#include "sugarpp/thread/synchronized.hpp"
+#include "sugarpp/range/parallel.hpp"
+#include "sugarpp/range/range.hpp"
+#include "sugarpp/io/io.hpp"
+#include <map>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+using namespace SugarPP;
+
+struct Config
+{
+    int width;
+    int height;
+    double scale;
+};
+
+int main()
+{
+    {
+        /*a mutex*/
+        Synchronized<std::vector<int>> values;
+        parallel(Range(0, 1000), [&values](auto range)
+        {
+            for (auto i : range)
+                values.withLock([i](auto& v) { v.push_back(i); });
+        });
+        print(values.withReadLock([](auto const& v) { return v.size(); }));   //1000
+    }
+    {
+        /*a reader-writer lock, with the contention counters*/
+        Synchronized<std::map<std::string, int>, std::shared_mutex, true> scores{ { { "sugar", 1 } } };
+        scores.withWriteLock([](auto& map) { map["pp"] = 2; });
+        parallel(Range(0, 100), [&scores](auto range)
+        {
+            for (auto i : range)
+                (void)scores.withReadLock([i](auto const& map) { return map.at("pp") + i; });
+        });
+        auto const size = scores.copy().size();
+        print(size, scores.stats().locks);                                  //2 102
+    }
+    {
+        /*a seqlock, where readers never block*/
+        Synchronized<Config, SeqLock> config{ Config{ 1920, 1080, 1.0 } };
+        config.withLock([](Config& c) { c.scale = 1.5; });
+        parallel(Range(0, 10000), [&config](auto range)
+        {
+            for (auto i : range)
+            {
+                if (i % 100 == 0)
+                    config.withLock([](Config& c) { c.width = -c.width; c.height = -c.height; });
+                else
+                {
+                    auto const c = config.copy();
+                    if ((c.width > 0) != (c.height > 0))
+                        print("torn read");
+                }
+            }
+        });
+        auto const c = config.copy();
+        print(c.width, c.height, c.scale);                                  //1920 1080 1.5
+    }
+}
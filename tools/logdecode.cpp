@@ -0,0 +1,58 @@
+/*****************************************************************//**
+ * \file   logdecode.cpp
+ * \brief  sugarpp-logdecode, which writes the messages of binary logs as text
+ *
+ * \author Peter
+ * \date   October 2026
+ * \note Usage: sugarpp-logdecode <log file>... , or without files to read a log from the standard input
+ *********************************************************************/
+
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include "sugarpp/io/binaryLog.hpp"
+
+#ifdef SugarPPNamespace
+using namespace SugarPP;
+#endif
+
+int main(int argc, char** argv)
+{
+    if (argc > 1 && (std::strcmp(argv[1], "-h") == 0 || std::strcmp(argv[1], "--help") == 0))
+    {
+        std::cout << "Usage: " << argv[0] << " [log file]...\nWrite the messages of SugarPP binary logs as text, or of the standard input without files\n";
+        return 0;
+    }
+
+    std::ios::sync_with_stdio(false);
+    int status = 0;
+    auto const decode = [&status](std::istream& in, char const* name)
+    {
+        try
+        {
+            decodeBinaryLog(in, std::cout);
+        }
+        catch (std::exception const& e)
+        {
+            std::cout.flush();
+            std::cerr << name << ": " << e.what() << '\n';
+            status = 1;
+        }
+    };
+
+    if (argc == 1)
+        decode(std::cin, "<stdin>");
+    for (int i = 1; i < argc; ++i)
+    {
+        std::ifstream file{ argv[i], std::ios::binary };
+        if (!file)
+        {
+            std::cerr << argv[i] << ": cannot open\n";
+            status = 1;
+            continue;
+        }
+        decode(file, argv[i]);
+    }
+    return status;
+}